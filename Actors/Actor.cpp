@@ -1,6 +1,6 @@
 #include "Actor.h"
 
-Actor::Actor(std::function<void(void)> &&p_fEventLoopOperations)
+Actor::Actor(Task &&p_fEventLoopOperations)
     : m_fEventLoopOperations(std::move(p_fEventLoopOperations))
 {
 }
@@ -13,7 +13,13 @@ bool Actor::Start()
         return false;
     }
     m_bIsStarted = true;
-    m_oActorThread.StartTask(std::bind(&Actor::EventLoop, this));
+    //! Paused then restarted before the event loop noticed , it just keeps going
+    //! queuing a second loop behind it would block here (holding the lock) for as long as the first one runs
+    if (!m_bIsEventLoopRunning)
+    {
+        m_bIsEventLoopRunning = true;
+        m_oActorThread.StartTask(std::bind(&Actor::EventLoop, this));
+    }
     return true;
 }
 
@@ -37,15 +43,27 @@ bool Actor::Pause()
     {
         return false;
     }
-    m_bIsStarted = true;
+    m_bIsStarted = false;
     return true;
 }
 
 void Actor::EventLoop()
 {
-    while (m_bIsStarted)
+    while (true)
     {
+        //! Only decide to exit under the lock , so Start either sees the loop still running or starts a new one
+        if (!m_bIsStarted)
+        {
+            std::lock_guard<std::mutex> oLock{m_oStatesMutex};
+            if (!m_bIsStarted)
+            {
+                m_bIsEventLoopRunning = false;
+                return;
+            }
+        }
+        CONCURRENCY_LIB_TRACE("Actor::Activation", TracePhase::Begin, reinterpret_cast<unsigned long long>(this));
         m_fEventLoopOperations();
+        CONCURRENCY_LIB_TRACE("Actor::Activation", TracePhase::End, reinterpret_cast<unsigned long long>(this));
     }
 }
 
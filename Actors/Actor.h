@@ -1,15 +1,19 @@
 #pragma once
 
 //! System includes
+#include <atomic>
 #include <mutex>
-#include <functional>
 
 #include "Thread.h"
+#include "InplaceTask.h"
+
+//! Instrumentation
+#include "Tracing.h"
 
 class Actor
 {
 public:
-    Actor(std::function<void(void)> &&p_fEventLoopOperations);
+    Actor(Task &&p_fEventLoopOperations);
     bool Start();
     bool Stop();
     bool Pause();
@@ -17,10 +21,13 @@ public:
 
 private:
     void EventLoop();
-    std::function<void(void)> m_fEventLoopOperations;
+    Task m_fEventLoopOperations;
 
     Thread m_oActorThread;
     std::mutex m_oStatesMutex;
-    bool m_bIsStarted{false};
+    //! Read by the event loop without holding the states lock
+    std::atomic<bool> m_bIsStarted{false};
     bool m_bIsTerminated{false};
+    //! Guarded by m_oStatesMutex
+    bool m_bIsEventLoopRunning{false};
 };
\ No newline at end of file
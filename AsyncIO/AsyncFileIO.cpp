@@ -0,0 +1,297 @@
+#include "AsyncFileIO.h"
+
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <thread>
+#include <poll.h>
+#include <unistd.h>
+
+//! user_data of the wakeup poll , requests use their address
+static constexpr unsigned long long WAKEUP_USER_DATA = 0;
+
+AsyncFileIO::AsyncFileIO(BasicThreadPool &p_oFallbackPool, unsigned int p_uiQueueDepth, AsyncIOBackend p_ePreferredBackend)
+    : m_oFallbackPool(p_oFallbackPool)
+{
+    if (p_ePreferredBackend == AsyncIOBackend::IoUring)
+    {
+        try
+        {
+            m_pRing = std::make_unique<IoUring>(p_uiQueueDepth);
+            m_eBackend = AsyncIOBackend::IoUring;
+        }
+        catch (const std::system_error &)
+        {
+            //! ENOSYS / EPERM ... , stay on the thread pool
+        }
+    }
+    if (m_eBackend == AsyncIOBackend::IoUring)
+    {
+        m_oIOThread.StartTask(std::bind(&AsyncFileIO::EventLoop, this));
+    }
+}
+
+AsyncFileIO::~AsyncFileIO()
+{
+    Stop();
+}
+
+AsyncFileIO::ResultChannel AsyncFileIO::MakeResultChannel(CompletionHandler *p_fOutOnComplete)
+{
+    auto pResultChannel = std::make_shared<OneShotChannel<IOResult>>();
+    //! One value per channel , the send never blocks the I/O thread
+    *p_fOutOnComplete = [pResultChannel](long long p_llResult)
+    { pResultChannel->SendValue(IOResult{p_llResult}); };
+    return pResultChannel;
+}
+
+AsyncFileIO::ResultChannel AsyncFileIO::Read(int p_iFd, void *p_pBuffer, std::size_t p_sBytes, off_t p_lOffset)
+{
+    CompletionHandler fOnComplete;
+    ResultChannel pResultChannel = MakeResultChannel(&fOnComplete);
+    Read(p_iFd, p_pBuffer, p_sBytes, p_lOffset, std::move(fOnComplete));
+    return pResultChannel;
+}
+
+AsyncFileIO::ResultChannel AsyncFileIO::Write(int p_iFd, const void *p_pBuffer, std::size_t p_sBytes, off_t p_lOffset)
+{
+    CompletionHandler fOnComplete;
+    ResultChannel pResultChannel = MakeResultChannel(&fOnComplete);
+    Write(p_iFd, p_pBuffer, p_sBytes, p_lOffset, std::move(fOnComplete));
+    return pResultChannel;
+}
+
+void AsyncFileIO::Read(int p_iFd, void *p_pBuffer, std::size_t p_sBytes, off_t p_lOffset, CompletionHandler &&p_fOnComplete)
+{
+    //! Ring lengths are 32 bits, a bigger request is a short read like pread would do
+    unsigned int uiBytes = p_sBytes > UINT_MAX ? UINT_MAX : static_cast<unsigned int>(p_sBytes);
+    Enqueue(std::unique_ptr<IORequest>(new IORequest{IORING_OP_READ, p_iFd, p_pBuffer, uiBytes, p_lOffset, std::move(p_fOnComplete)}));
+}
+
+void AsyncFileIO::Write(int p_iFd, const void *p_pBuffer, std::size_t p_sBytes, off_t p_lOffset, CompletionHandler &&p_fOnComplete)
+{
+    unsigned int uiBytes = p_sBytes > UINT_MAX ? UINT_MAX : static_cast<unsigned int>(p_sBytes);
+    Enqueue(std::unique_ptr<IORequest>(new IORequest{IORING_OP_WRITE, p_iFd, const_cast<void *>(p_pBuffer), uiBytes, p_lOffset, std::move(p_fOnComplete)}));
+}
+
+void AsyncFileIO::Enqueue(std::unique_ptr<IORequest> &&p_pRequest)
+{
+    long long llFailure = 0;
+    {
+        std::lock_guard<std::mutex> oLock{m_oPendingMutex};
+        if (m_bIsStopping)
+        {
+            llFailure = -ECANCELED;
+        }
+        else if (m_iRingError != 0)
+        {
+            llFailure = m_iRingError;
+        }
+        else if (m_eBackend == AsyncIOBackend::IoUring)
+        {
+            m_vecPending.push_back(std::move(p_pRequest));
+        }
+        else
+        {
+            m_uiPoolInFlight++;
+        }
+    }
+    if (llFailure != 0)
+    {
+        //! Outside the lock , the handler may well call us back
+        p_pRequest->m_fOnComplete(llFailure);
+    }
+    else if (m_eBackend == AsyncIOBackend::IoUring)
+    {
+        //! Coalesced , a burst of requests wakes the I/O thread once
+        m_oWakeup.Signal();
+    }
+    else
+    {
+        SubmitToPool(std::move(p_pRequest));
+    }
+}
+
+void AsyncFileIO::SubmitToPool(std::unique_ptr<IORequest> &&p_pRequest)
+{
+    //! Fire and forget , the completion handler is the result
+    m_oFallbackPool.PostTask([this, pRequest = std::move(p_pRequest)]()
+                             {
+        ssize_t sResult = pRequest->m_ucOpcode == IORING_OP_READ
+                              ? pread(pRequest->m_iFd, pRequest->m_pBuffer, pRequest->m_uiBytes, pRequest->m_lOffset)
+                              : pwrite(pRequest->m_iFd, pRequest->m_pBuffer, pRequest->m_uiBytes, pRequest->m_lOffset);
+        pRequest->m_fOnComplete(sResult < 0 ? -errno : sResult);
+        CompleteFromPool(); });
+}
+
+void AsyncFileIO::CompleteFromPool()
+{
+    std::lock_guard<std::mutex> oLock{m_oPendingMutex};
+    if (--m_uiPoolInFlight == 0)
+    {
+        m_oDoneCv.notify_all();
+    }
+}
+
+void AsyncFileIO::Stop()
+{
+    std::unique_lock<std::mutex> oLock{m_oPendingMutex};
+    m_bIsStopping = true;
+    if (m_eBackend == AsyncIOBackend::IoUring)
+    {
+        m_oWakeup.Signal();
+        m_oDoneCv.wait(oLock, [this]()
+                       { return m_bIsEventLoopDone; });
+    }
+    else
+    {
+        m_oDoneCv.wait(oLock, [this]()
+                       { return m_uiPoolInFlight == 0; });
+    }
+}
+
+void AsyncFileIO::EventLoop()
+{
+    while (true)
+    {
+        bool bIsStopping;
+        int iRingError;
+        {
+            //! Take the whole batch queued since last time
+            std::lock_guard<std::mutex> oLock{m_oPendingMutex};
+            bIsStopping = m_bIsStopping;
+            iRingError = m_iRingError;
+            for (auto &pRequest : m_vecPending)
+            {
+                m_vecBacklog.push_back(std::move(pRequest));
+            }
+            m_vecPending.clear();
+        }
+        if (iRingError != 0)
+        {
+            FailBacklog(iRingError);
+        }
+        else
+        {
+            if (!m_bIsWakeupPollArmed)
+            {
+                ArmWakeupPoll();
+            }
+            FillSubmissionQueue();
+        }
+        if (bIsStopping && m_uiInFlight == 0 && m_vecBacklog.empty())
+        {
+            break;
+        }
+
+        if (iRingError != 0)
+        {
+            //! Only requests the kernel took are left , their completions still get posted , poll for them
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        else
+        {
+            //! One syscall submits the whole batch and waits for the first completion (or a wakeup)
+            int iResult = m_pRing->SubmitAndWait(1);
+            if (iResult == -EAGAIN || iResult == -EBUSY)
+            {
+                //! Kernel short of memory / completions to reap first , entries not taken stay queued for the next round
+                std::this_thread::yield();
+            }
+            else if (iResult < 0)
+            {
+                OnRingError(iResult);
+            }
+        }
+        m_pRing->ForEachCompletion([this](const io_uring_cqe &p_oCqe)
+                                   {
+            if (p_oCqe.user_data == WAKEUP_USER_DATA)
+            {
+                //! One shot poll , cleared before taking the next batch so no request is missed
+                m_bIsWakeupPollArmed = false;
+                m_oWakeup.Clear();
+                return;
+            }
+            std::unique_ptr<IORequest> pRequest(reinterpret_cast<IORequest *>(p_oCqe.user_data));
+            m_uiInFlight--;
+            pRequest->m_fOnComplete(p_oCqe.res); });
+    }
+
+    //! A still armed wakeup poll is cancelled with the ring
+    {
+        std::lock_guard<std::mutex> oLock{m_oPendingMutex};
+        m_bIsEventLoopDone = true;
+    }
+    m_oDoneCv.notify_all();
+}
+
+void AsyncFileIO::FailBacklog(long long p_llError)
+{
+    for (; m_sBacklogHead < m_vecBacklog.size(); ++m_sBacklogHead)
+    {
+        m_vecBacklog[m_sBacklogHead]->m_fOnComplete(p_llError);
+    }
+    m_vecBacklog.clear();
+    m_sBacklogHead = 0;
+}
+
+void AsyncFileIO::OnRingError(int p_iError)
+{
+    {
+        std::lock_guard<std::mutex> oLock{m_oPendingMutex};
+        m_iRingError = p_iError;
+    }
+    //! Entries the kernel never took won't complete , hand them back to their callers
+    m_pRing->DiscardUnsubmitted([this, p_iError](const io_uring_sqe &p_oSqe)
+                                {
+        if (p_oSqe.user_data == WAKEUP_USER_DATA)
+        {
+            m_bIsWakeupPollArmed = false;
+            return;
+        }
+        std::unique_ptr<IORequest> pRequest(reinterpret_cast<IORequest *>(p_oSqe.user_data));
+        m_uiInFlight--;
+        pRequest->m_fOnComplete(p_iError); });
+    FailBacklog(p_iError);
+}
+
+void AsyncFileIO::ArmWakeupPoll()
+{
+    io_uring_sqe *pSqe = m_pRing->GetSqe();
+    if (!pSqe)
+    {
+        return;
+    }
+    pSqe->opcode = IORING_OP_POLL_ADD;
+    pSqe->fd = m_oWakeup.GetFd();
+    pSqe->poll32_events = POLLIN;
+    pSqe->user_data = WAKEUP_USER_DATA;
+    m_bIsWakeupPollArmed = true;
+}
+
+void AsyncFileIO::FillSubmissionQueue()
+{
+    //! Never more in flight than the completion queue holds (minus the wakeup poll), it can't overflow then
+    unsigned int uiMaxInFlight = m_pRing->GetCqEntries() - 1;
+    while (m_sBacklogHead < m_vecBacklog.size() && m_uiInFlight < uiMaxInFlight)
+    {
+        io_uring_sqe *pSqe = m_pRing->GetSqe();
+        if (!pSqe)
+        {
+            break;
+        }
+        IORequest *pRequest = m_vecBacklog[m_sBacklogHead++].release();
+        pSqe->opcode = pRequest->m_ucOpcode;
+        pSqe->fd = pRequest->m_iFd;
+        pSqe->addr = reinterpret_cast<unsigned long long>(pRequest->m_pBuffer);
+        pSqe->len = pRequest->m_uiBytes;
+        pSqe->off = pRequest->m_lOffset;
+        pSqe->user_data = reinterpret_cast<unsigned long long>(pRequest);
+        m_uiInFlight++;
+    }
+    if (m_sBacklogHead == m_vecBacklog.size())
+    {
+        m_vecBacklog.clear();
+        m_sBacklogHead = 0;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+#pragma once
+
+//! System includes
+#include <functional>
+#include <memory>
+#include <vector>
+#include <sys/types.h>
+
+//! Threading
+#include <mutex>
+#include <condition_variable>
+#include "Thread.h"
+#include "BasicThreadPool.h"
+
+//! Channels
+#include "CompactChannel.h"
+#include "ReadinessNotifier.h"
+
+#include "IoUring.h"
+
+/*
+    - Async pread / pwrite , so CPU workers never block on disk
+    - io_uring backend : one I/O thread owns the ring , requests queued by any thread are submitted in batches
+      (everything queued since the last io_uring_enter goes in the next one) , thousands of requests can be in flight
+    - ThreadPool backend : fallback when io_uring isn't available , each request is a blocking pread / pwrite task on the pool
+    - completions are delivered on a result channel (ReadValue blocks like a future) or to a callback
+*/
+
+//! Questions / Edgecases:
+//! Q: How does the I/O thread notice new requests while it is blocked in io_uring_enter ?
+//!     a POLL_ADD on an eventfd is always armed in the ring , queuing a request signals it (coalesced , see ReadinessNotifier)
+//! Q: What if more requests are queued than the ring holds ?
+//!     they wait in the backlog , in flight requests are capped to the completion queue size so it can never overflow
+//! Q: Where do callbacks run ?
+//!     on the I/O thread (or the pool worker for the fallback) , keep them short , hand heavy work to a pool
+//! Q: What happens on Stop ?
+//!     queued and in flight requests still complete , requests made after Stop complete right away with -ECANCELED
+//! Q: What if io_uring_enter fails ?
+//!     EINTR / EAGAIN / EBUSY are retried (completions reaped first) , any other error completes every request the kernel
+//!     didn't take (and every later one) with that error , the ones it took still complete normally
+
+enum class AsyncIOBackend
+{
+    IoUring,
+    ThreadPool
+};
+
+//! Same as pread / pwrite : bytes transferred (may be short) or -errno
+struct IOResult
+{
+    long long m_llResult{0};
+};
+
+class AsyncFileIO
+{
+public:
+    using ResultChannel = std::shared_ptr<OneShotChannel<IOResult>>;
+    using CompletionHandler = std::function<void(long long)>;
+
+    //! Falls back to p_oFallbackPool if io_uring can't be set up (or p_ePreferredBackend is ThreadPool)
+    //! p_uiQueueDepth is the ring size , not a limit on queued requests
+    AsyncFileIO(BasicThreadPool &p_oFallbackPool, unsigned int p_uiQueueDepth = 256, AsyncIOBackend p_ePreferredBackend = AsyncIOBackend::IoUring);
+    ~AsyncFileIO();
+
+    //! p_pBuffer has to stay valid till the completion
+    ResultChannel Read(int p_iFd, void *p_pBuffer, std::size_t p_sBytes, off_t p_lOffset);
+    ResultChannel Write(int p_iFd, const void *p_pBuffer, std::size_t p_sBytes, off_t p_lOffset);
+    void Read(int p_iFd, void *p_pBuffer, std::size_t p_sBytes, off_t p_lOffset, CompletionHandler &&p_fOnComplete);
+    void Write(int p_iFd, const void *p_pBuffer, std::size_t p_sBytes, off_t p_lOffset, CompletionHandler &&p_fOnComplete);
+
+    //! Waits for every queued / in flight request to complete
+    void Stop();
+
+    AsyncIOBackend GetBackend() const
+    {
+        return m_eBackend;
+    }
+
+private:
+    struct IORequest
+    {
+        unsigned char m_ucOpcode;
+        int m_iFd;
+        void *m_pBuffer;
+        unsigned int m_uiBytes;
+        off_t m_lOffset;
+        CompletionHandler m_fOnComplete;
+    };
+
+    static ResultChannel MakeResultChannel(CompletionHandler *p_fOutOnComplete);
+    void Enqueue(std::unique_ptr<IORequest> &&p_pRequest);
+    void SubmitToPool(std::unique_ptr<IORequest> &&p_pRequest);
+    void EventLoop();
+    void ArmWakeupPoll();
+    void FillSubmissionQueue();
+    void FailBacklog(long long p_llError);
+    void OnRingError(int p_iError);
+    void CompleteFromPool();
+
+    BasicThreadPool &m_oFallbackPool;
+    AsyncIOBackend m_eBackend{AsyncIOBackend::ThreadPool};
+    std::unique_ptr<IoUring> m_pRing;
+
+    //! Requests queued by callers , moved to the I/O thread in batches
+    std::mutex m_oPendingMutex;
+    std::vector<std::unique_ptr<IORequest>> m_vecPending;
+    bool m_bIsStopping{false};
+    //! -errno once io_uring_enter failed for good , every request not taken by the kernel completes with it
+    int m_iRingError{0};
+    bool m_bIsEventLoopDone{false};
+    unsigned int m_uiPoolInFlight{0};
+    std::condition_variable m_oDoneCv;
+    ReadinessNotifier m_oWakeup;
+
+    //! I/O thread only
+    std::vector<std::unique_ptr<IORequest>> m_vecBacklog;
+    std::size_t m_sBacklogHead{0};
+    unsigned int m_uiInFlight{0};
+    bool m_bIsWakeupPollArmed{false};
+
+    Thread m_oIOThread;
+};
\ No newline at end of file
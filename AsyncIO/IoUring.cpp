@@ -0,0 +1,115 @@
+#include "IoUring.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <system_error>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+IoUring::IoUring(unsigned int p_uiEntries)
+{
+    io_uring_params oParams;
+    std::memset(&oParams, 0, sizeof(oParams));
+    m_iFd = static_cast<int>(syscall(__NR_io_uring_setup, p_uiEntries, &oParams));
+    if (m_iFd < 0)
+    {
+        throw std::system_error(errno, std::generic_category(), "io_uring_setup");
+    }
+    m_uiSqEntries = oParams.sq_entries;
+    m_uiCqEntries = oParams.cq_entries;
+
+    m_sSqRingSize = oParams.sq_off.array + oParams.sq_entries * sizeof(unsigned int);
+    m_sCqRingSize = oParams.cq_off.cqes + oParams.cq_entries * sizeof(io_uring_cqe);
+    //! Newer kernels map both rings with one mmap
+    bool bIsSingleMmap = oParams.features & IORING_FEAT_SINGLE_MMAP;
+    if (bIsSingleMmap)
+    {
+        m_sSqRingSize = m_sCqRingSize = std::max(m_sSqRingSize, m_sCqRingSize);
+    }
+    m_pSqRing = mmap(nullptr, m_sSqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_iFd, IORING_OFF_SQ_RING);
+    m_pCqRing = bIsSingleMmap ? m_pSqRing : mmap(nullptr, m_sCqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_iFd, IORING_OFF_CQ_RING);
+    m_sSqesSize = oParams.sq_entries * sizeof(io_uring_sqe);
+    void *pSqes = mmap(nullptr, m_sSqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_iFd, IORING_OFF_SQES);
+    if (m_pSqRing == MAP_FAILED || m_pCqRing == MAP_FAILED || pSqes == MAP_FAILED)
+    {
+        int iError = errno;
+        if (m_pSqRing != MAP_FAILED)
+        {
+            munmap(m_pSqRing, m_sSqRingSize);
+        }
+        if (!bIsSingleMmap && m_pCqRing != MAP_FAILED)
+        {
+            munmap(m_pCqRing, m_sCqRingSize);
+        }
+        if (pSqes != MAP_FAILED)
+        {
+            munmap(pSqes, m_sSqesSize);
+        }
+        close(m_iFd);
+        throw std::system_error(iError, std::generic_category(), "io_uring mmap");
+    }
+    m_pSqes = static_cast<io_uring_sqe *>(pSqes);
+
+    char *pSqRing = static_cast<char *>(m_pSqRing);
+    m_pSqHead = reinterpret_cast<unsigned int *>(pSqRing + oParams.sq_off.head);
+    m_pSqTail = reinterpret_cast<unsigned int *>(pSqRing + oParams.sq_off.tail);
+    m_pSqMask = reinterpret_cast<unsigned int *>(pSqRing + oParams.sq_off.ring_mask);
+    m_pSqArray = reinterpret_cast<unsigned int *>(pSqRing + oParams.sq_off.array);
+    m_uiSqeTail = *m_pSqTail;
+
+    char *pCqRing = static_cast<char *>(m_pCqRing);
+    m_pCqHead = reinterpret_cast<unsigned int *>(pCqRing + oParams.cq_off.head);
+    m_pCqTail = reinterpret_cast<unsigned int *>(pCqRing + oParams.cq_off.tail);
+    m_pCqMask = reinterpret_cast<unsigned int *>(pCqRing + oParams.cq_off.ring_mask);
+    m_pCqes = reinterpret_cast<io_uring_cqe *>(pCqRing + oParams.cq_off.cqes);
+}
+
+IoUring::~IoUring()
+{
+    munmap(m_pSqes, m_sSqesSize);
+    if (m_pCqRing != m_pSqRing)
+    {
+        munmap(m_pCqRing, m_sCqRingSize);
+    }
+    munmap(m_pSqRing, m_sSqRingSize);
+    close(m_iFd);
+}
+
+io_uring_sqe *IoUring::GetSqe()
+{
+    unsigned int uiHead = __atomic_load_n(m_pSqHead, __ATOMIC_ACQUIRE);
+    if (m_uiSqeTail - uiHead >= m_uiSqEntries)
+    {
+        return nullptr;
+    }
+    unsigned int uiIndex = m_uiSqeTail & *m_pSqMask;
+    m_pSqArray[uiIndex] = uiIndex;
+    m_uiSqeTail++;
+    io_uring_sqe *pSqe = &m_pSqes[uiIndex];
+    std::memset(pSqe, 0, sizeof(*pSqe));
+    return pSqe;
+}
+
+int IoUring::SubmitAndWait(unsigned int p_uiMinComplete)
+{
+    //! Publish the new entries before the kernel looks at the tail
+    __atomic_store_n(m_pSqTail, m_uiSqeTail, __ATOMIC_RELEASE);
+    unsigned int uiFlags = p_uiMinComplete > 0 ? IORING_ENTER_GETEVENTS : 0;
+    while (true)
+    {
+        //! Counted from the sq head , whatever a failed / interrupted call left behind is submitted again (never twice)
+        unsigned int uiToSubmit = m_uiSqeTail - __atomic_load_n(m_pSqHead, __ATOMIC_ACQUIRE);
+        long lResult = syscall(__NR_io_uring_enter, m_iFd, uiToSubmit, p_uiMinComplete, uiFlags, nullptr, 0);
+        if (lResult >= 0)
+        {
+            return static_cast<int>(lResult);
+        }
+        if (errno != EINTR)
+        {
+            return -errno;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+
+//! System includes
+#include <cstddef>
+#include <linux/io_uring.h>
+
+/*
+    - Minimal io_uring ring over the raw syscalls (no liburing dependency)
+    - Single threaded : only the owner thread touches the rings
+    - Submission entries queued through GetSqe are handed to the kernel in one io_uring_enter by SubmitAndWait
+*/
+
+class IoUring
+{
+public:
+    //! Throws std::system_error if io_uring isn't usable (old kernel , seccomp , kernel.io_uring_disabled)
+    explicit IoUring(unsigned int p_uiEntries);
+    ~IoUring();
+
+    IoUring(const IoUring &) = delete;
+    IoUring &operator=(const IoUring &) = delete;
+
+    //! Zeroed submission entry , nullptr if the submission queue is full
+    io_uring_sqe *GetSqe();
+
+    //! Submits every entry the kernel didn't take yet and waits for at least p_uiMinComplete completions
+    //! returns -errno on failure (EINTR is retried) , entries not taken stay queued for the next call
+    int SubmitAndWait(unsigned int p_uiMinComplete);
+
+    //! Takes back every entry the kernel didn't take yet , p_fVisitor sees each one before it is dropped
+    template <typename Visitor>
+    unsigned int DiscardUnsubmitted(Visitor &&p_fVisitor)
+    {
+        unsigned int uiHead = __atomic_load_n(m_pSqHead, __ATOMIC_ACQUIRE);
+        unsigned int uiCount = m_uiSqeTail - uiHead;
+        for (unsigned int uiTail = uiHead; uiTail != m_uiSqeTail; ++uiTail)
+        {
+            p_fVisitor(m_pSqes[m_pSqArray[uiTail & *m_pSqMask]]);
+        }
+        //! Single threaded owner , the kernel only looks at the tail inside io_uring_enter
+        m_uiSqeTail = uiHead;
+        __atomic_store_n(m_pSqTail, uiHead, __ATOMIC_RELEASE);
+        return uiCount;
+    }
+
+    //! Calls p_fVisitor for every available completion then hands the entries back to the kernel
+    template <typename Visitor>
+    unsigned int ForEachCompletion(Visitor &&p_fVisitor)
+    {
+        unsigned int uiHead = *m_pCqHead;
+        unsigned int uiTail = __atomic_load_n(m_pCqTail, __ATOMIC_ACQUIRE);
+        unsigned int uiCount = uiTail - uiHead;
+        for (; uiHead != uiTail; ++uiHead)
+        {
+            p_fVisitor(m_pCqes[uiHead & *m_pCqMask]);
+        }
+        __atomic_store_n(m_pCqHead, uiHead, __ATOMIC_RELEASE);
+        return uiCount;
+    }
+
+    unsigned int GetSqEntries() const
+    {
+        return m_uiSqEntries;
+    }
+
+    unsigned int GetCqEntries() const
+    {
+        return m_uiCqEntries;
+    }
+
+private:
+    int m_iFd{-1};
+    unsigned int m_uiSqEntries{0};
+    unsigned int m_uiCqEntries{0};
+
+    //! Mappings
+    void *m_pSqRing{nullptr};
+    std::size_t m_sSqRingSize{0};
+    void *m_pCqRing{nullptr};
+    std::size_t m_sCqRingSize{0};
+    io_uring_sqe *m_pSqes{nullptr};
+    std::size_t m_sSqesSize{0};
+
+    //! Submission queue
+    unsigned int *m_pSqHead{nullptr};
+    unsigned int *m_pSqTail{nullptr};
+    unsigned int *m_pSqMask{nullptr};
+    unsigned int *m_pSqArray{nullptr};
+    unsigned int m_uiSqeTail{0};
+
+    //! Completion queue
+    unsigned int *m_pCqHead{nullptr};
+    unsigned int *m_pCqTail{nullptr};
+    unsigned int *m_pCqMask{nullptr};
+    io_uring_cqe *m_pCqes{nullptr};
+};
\ No newline at end of file
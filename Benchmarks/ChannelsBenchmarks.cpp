@@ -0,0 +1,176 @@
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "BufferedChannel.h"
+#include "UnBufferedChannel.h"
+#include "ShardedChannel.h"
+#include "UnboundedChannel.h"
+#include "PriorityChannel.h"
+#include "ChannelAdapter.h"
+#include "CompactChannel.h"
+
+//! Messages moved per benchmark iteration , big enough to hide the threads creation
+constexpr int MESSAGES_PER_ITERATION = 20000;
+
+template <typename Channel>
+std::unique_ptr<Channel> MakeChannel();
+
+template <>
+std::unique_ptr<BufferedChannel<int>> MakeChannel<BufferedChannel<int>>()
+{
+    return std::make_unique<BufferedChannel<int>>(1024);
+}
+
+template <>
+std::unique_ptr<UnBufferedChannel<int>> MakeChannel<UnBufferedChannel<int>>()
+{
+    return std::make_unique<UnBufferedChannel<int>>();
+}
+
+template <>
+std::unique_ptr<ShardedChannel<int>> MakeChannel<ShardedChannel<int>>()
+{
+    return std::make_unique<ShardedChannel<int>>(1024);
+}
+
+template <>
+std::unique_ptr<UnboundedChannel<int>> MakeChannel<UnboundedChannel<int>>()
+{
+    return std::make_unique<UnboundedChannel<int>>();
+}
+
+template <>
+std::unique_ptr<PriorityChannel<int>> MakeChannel<PriorityChannel<int>>()
+{
+    return std::make_unique<PriorityChannel<int>>(1024);
+}
+
+template <>
+std::unique_ptr<CompactChannel<int>> MakeChannel<CompactChannel<int>>()
+{
+    return std::make_unique<CompactChannel<int>>();
+}
+
+//! Compile time configured channels , same 1024 capacity
+using StaticChannel = Channel<int, 1024>;
+using StaticSpscChannel = SpscChannel<int, 1024>;
+using AdaptedStaticChannel = ChannelAdapter<StaticChannel>;
+
+template <>
+std::unique_ptr<StaticChannel> MakeChannel<StaticChannel>()
+{
+    return std::make_unique<StaticChannel>();
+}
+
+template <>
+std::unique_ptr<StaticSpscChannel> MakeChannel<StaticSpscChannel>()
+{
+    return std::make_unique<StaticSpscChannel>();
+}
+
+template <>
+std::unique_ptr<AdaptedStaticChannel> MakeChannel<AdaptedStaticChannel>()
+{
+    return std::make_unique<AdaptedStaticChannel>();
+}
+
+//! range(0) producers , range(1) consumers, all of them hammering the same channel
+template <typename Channel>
+void BM_ChannelThroughput(benchmark::State &p_oState)
+{
+    const int iProducersCount = p_oState.range(0);
+    const int iConsumersCount = p_oState.range(1);
+    const int iMessagesPerProducer = MESSAGES_PER_ITERATION / iProducersCount;
+    const int iTotalMessages = iMessagesPerProducer * iProducersCount;
+
+    for (auto _ : p_oState)
+    {
+        auto pChannel = MakeChannel<Channel>();
+        std::vector<std::thread> vecThreads;
+        for (int i = 0; i < iConsumersCount; ++i)
+        {
+            //! Split the reads so every consumer exits without needing a Close
+            int iReadsCount = iTotalMessages / iConsumersCount + (i < iTotalMessages % iConsumersCount ? 1 : 0);
+            vecThreads.emplace_back([&pChannel, iReadsCount]()
+                                    {
+                                        int iValue = 0;
+                                        for (int j = 0; j < iReadsCount; ++j)
+                                        {
+                                            pChannel->ReadValue(iValue);
+                                        }
+                                        benchmark::DoNotOptimize(iValue); });
+        }
+        for (int i = 0; i < iProducersCount; ++i)
+        {
+            vecThreads.emplace_back([&pChannel, iMessagesPerProducer]()
+                                    {
+                                        for (int j = 0; j < iMessagesPerProducer; ++j)
+                                        {
+                                            pChannel->SendValue(std::move(j));
+                                        } });
+        }
+        for (auto &oThread : vecThreads)
+        {
+            oThread.join();
+        }
+    }
+    p_oState.SetItemsProcessed(p_oState.iterations() * iTotalMessages);
+}
+
+#define CHANNEL_THROUGHPUT_ARGS                     \
+    ArgNames({"producers", "consumers"})            \
+        ->Args({1, 1})   /* SPSC */                 \
+        ->Args({4, 1})   /* MPSC */                 \
+        ->Args({16, 1})  /* MPSC */                 \
+        ->Args({4, 4})   /* MPMC */                 \
+        ->Args({16, 16}) /* MPMC */                 \
+        ->UseRealTime()                             \
+        ->Unit(benchmark::kMillisecond)
+
+BENCHMARK_TEMPLATE(BM_ChannelThroughput, BufferedChannel<int>)->CHANNEL_THROUGHPUT_ARGS;
+BENCHMARK_TEMPLATE(BM_ChannelThroughput, UnBufferedChannel<int>)->CHANNEL_THROUGHPUT_ARGS;
+BENCHMARK_TEMPLATE(BM_ChannelThroughput, CompactChannel<int>)->CHANNEL_THROUGHPUT_ARGS;
+BENCHMARK_TEMPLATE(BM_ChannelThroughput, UnboundedChannel<int>)->CHANNEL_THROUGHPUT_ARGS;
+BENCHMARK_TEMPLATE(BM_ChannelThroughput, PriorityChannel<int>)->CHANNEL_THROUGHPUT_ARGS;
+BENCHMARK_TEMPLATE(BM_ChannelThroughput, StaticChannel)->CHANNEL_THROUGHPUT_ARGS;
+BENCHMARK_TEMPLATE(BM_ChannelThroughput, StaticSpscChannel)->ArgNames({"producers", "consumers"})->Args({1, 1})->UseRealTime()->Unit(benchmark::kMillisecond);
+//! Producers scaling , relaxed FIFO vs the single lock BufferedChannel
+BENCHMARK_TEMPLATE(BM_ChannelThroughput, ShardedChannel<int>)->CHANNEL_THROUGHPUT_ARGS->Args({32, 4});
+BENCHMARK_TEMPLATE(BM_ChannelThroughput, BufferedChannel<int>)->ArgNames({"producers", "consumers"})->Args({32, 4})->UseRealTime()->Unit(benchmark::kMillisecond);
+
+//! Round trip latency : main thread sends on one channel , echo thread answers on another
+template <typename Channel>
+void BM_ChannelPingPong(benchmark::State &p_oState)
+{
+    auto pPing = MakeChannel<Channel>();
+    auto pPong = MakeChannel<Channel>();
+    std::thread oEcho([&pPing, &pPong]()
+                      {
+                          int iValue;
+                          while (pPing->ReadValue(iValue))
+                          {
+                              pPong->SendValue(std::move(iValue));
+                          } });
+    int iValue = 0;
+    for (auto _ : p_oState)
+    {
+        pPing->SendValue(std::move(iValue));
+        pPong->ReadValue(iValue);
+    }
+    pPing->Close();
+    oEcho.join();
+    p_oState.SetItemsProcessed(p_oState.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_ChannelPingPong, BufferedChannel<int>)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ChannelPingPong, UnBufferedChannel<int>)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ChannelPingPong, UnboundedChannel<int>)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ChannelPingPong, CompactChannel<int>)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ChannelPingPong, PriorityChannel<int>)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ChannelPingPong, StaticChannel)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_ChannelPingPong, StaticSpscChannel)->UseRealTime();
+//! Same channel behind the virtual IChannel<T> interface
+BENCHMARK_TEMPLATE(BM_ChannelPingPong, AdaptedStaticChannel)->UseRealTime();
\ No newline at end of file
@@ -0,0 +1,43 @@
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "BufferedChannel.h"
+#include "ChannelSelector.h"
+
+constexpr int MESSAGES_PER_ITERATION = 20000;
+
+//! Fan in : one producer round robins over range(0) channels , one consumer selects over all of them
+void BM_SelectorFanIn(benchmark::State &p_oState)
+{
+    const int iChannelsCount = p_oState.range(0);
+    for (auto _ : p_oState)
+    {
+        ChannelSelector oSelector;
+        std::vector<std::shared_ptr<IChannel<int>>> vecChannels;
+        int iHandledCount = 0;
+        for (int i = 0; i < iChannelsCount; ++i)
+        {
+            vecChannels.push_back(std::make_shared<BufferedChannel<int>>(1024));
+            oSelector.AddChannel<int>(vecChannels.back(), [&iHandledCount](int &)
+                                      { iHandledCount++; });
+        }
+        std::thread oProducer([&vecChannels]()
+                              {
+                                  for (int j = 0; j < MESSAGES_PER_ITERATION; ++j)
+                                  {
+                                      vecChannels[j % vecChannels.size()]->SendValue(std::move(j));
+                                  } });
+        while (iHandledCount < MESSAGES_PER_ITERATION)
+        {
+            oSelector.SelectAndExecute();
+        }
+        oProducer.join();
+        oSelector.Close();
+    }
+    p_oState.SetItemsProcessed(p_oState.iterations() * MESSAGES_PER_ITERATION);
+}
+
+BENCHMARK(BM_SelectorFanIn)->ArgName("channels")->Arg(1)->Arg(10)->Arg(100)->Arg(1000)->UseRealTime()->Unit(benchmark::kMillisecond);
\ No newline at end of file
@@ -0,0 +1,18 @@
+#include <benchmark/benchmark.h>
+
+#include "Semaphore.h"
+
+//! All benchmark threads fight over a semaphore of capacity 2
+static Semaphore s_oSemaphore(2);
+
+void BM_SemaphoreContention(benchmark::State &p_oState)
+{
+    for (auto _ : p_oState)
+    {
+        s_oSemaphore.Accquire();
+        s_oSemaphore.Release();
+    }
+    p_oState.SetItemsProcessed(p_oState.iterations());
+}
+
+BENCHMARK(BM_SemaphoreContention)->ThreadRange(1, 16)->UseRealTime();
\ No newline at end of file
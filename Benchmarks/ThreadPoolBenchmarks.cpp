@@ -0,0 +1,87 @@
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "BasicThreadPool.h"
+#include "Strand.h"
+#include "TaskGraph.h"
+
+constexpr int TASKS_PER_ITERATION = 10000;
+
+//! Submit a burst of tiny tasks then collect all the results
+void BM_ThreadPoolThroughput(benchmark::State &p_oState)
+{
+    BasicThreadPool oPool(static_cast<unsigned int>(p_oState.range(0)));
+    std::vector<BasicThreadPool::ResultChannel<int>> vecResults;
+    vecResults.reserve(TASKS_PER_ITERATION);
+    for (auto _ : p_oState)
+    {
+        for (int i = 0; i < TASKS_PER_ITERATION; ++i)
+        {
+            vecResults.push_back(oPool.SubmitTask<int>([i]()
+                                                       { return i; }));
+        }
+        int iValue;
+        for (auto &pResult : vecResults)
+        {
+            pResult->ReadValue(iValue);
+        }
+        benchmark::DoNotOptimize(iValue);
+        vecResults.clear();
+    }
+    p_oState.SetItemsProcessed(p_oState.iterations() * TASKS_PER_ITERATION);
+}
+
+BENCHMARK(BM_ThreadPoolThroughput)->ArgName("workers")->Arg(1)->Arg(4)->Arg(16)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+//! Same burst spread over many ordered streams (keys) , one strand per stream sharing 16 workers
+void BM_KeyedExecutorThroughput(benchmark::State &p_oState)
+{
+    BasicThreadPool oPool(16);
+    KeyedExecutor oExecutor(oPool, static_cast<std::size_t>(p_oState.range(0)));
+    std::atomic<int> iExecuted{0};
+    for (auto _ : p_oState)
+    {
+        iExecuted.store(0, std::memory_order_relaxed);
+        for (int i = 0; i < TASKS_PER_ITERATION; ++i)
+        {
+            oExecutor.Post(i, [&iExecuted]()
+                           { iExecuted.fetch_add(1, std::memory_order_release); });
+        }
+        while (iExecuted.load(std::memory_order_acquire) != TASKS_PER_ITERATION)
+        {
+            std::this_thread::yield();
+        }
+    }
+    p_oState.SetItemsProcessed(p_oState.iterations() * TASKS_PER_ITERATION);
+}
+
+BENCHMARK(BM_KeyedExecutorThroughput)->ArgName("strands")->Arg(16)->Arg(1024)->Arg(16384)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+//! Fork / join of width tiny tasks between a source and a sink , the graph is built once and run every iteration
+void BM_TaskGraphRun(benchmark::State &p_oState)
+{
+    BasicThreadPool oPool(4);
+    TaskGraph oGraph;
+    std::atomic<int> iExecuted{0};
+    TaskGraph::TaskHandle oSource = oGraph.Emplace([]() {});
+    TaskGraph::TaskHandle oSink = oGraph.Emplace([]() {});
+    for (int i = 0; i < p_oState.range(0); ++i)
+    {
+        oGraph.Emplace([&iExecuted]()
+                       { iExecuted.fetch_add(1, std::memory_order_relaxed); })
+            .Succeed(oSource)
+            .Precede(oSink);
+    }
+    for (auto _ : p_oState)
+    {
+        oGraph.Run(oPool);
+        oGraph.Wait();
+    }
+    benchmark::DoNotOptimize(iExecuted.load());
+    p_oState.SetItemsProcessed(p_oState.iterations() * oGraph.GetTasksCount());
+}
+
+BENCHMARK(BM_TaskGraphRun)->ArgName("width")->Arg(16)->Arg(1024)->UseRealTime()->Unit(benchmark::kMicrosecond);
\ No newline at end of file
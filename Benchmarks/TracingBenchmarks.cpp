@@ -0,0 +1,39 @@
+#include <ostream>
+
+#include <benchmark/benchmark.h>
+
+#include "Tracing.h"
+
+//! Cost of one tracepoint when tracing is enabled at runtime
+void BM_TraceRecordEnabled(benchmark::State &p_oState)
+{
+    Tracer::Instance().Enable();
+    std::ostream oNullOutput{nullptr};
+    unsigned long long ullCount = 0;
+    for (auto _ : p_oState)
+    {
+        Tracer::Instance().Record("Benchmark", TracePhase::Instant, ullCount);
+        //! Keep the ring from filling up , otherwise we would be measuring the drop path
+        if (++ullCount % (TraceBuffer::s_sCapacity / 2) == 0)
+        {
+            p_oState.PauseTiming();
+            Tracer::Instance().FlushToChromeTrace(oNullOutput);
+            p_oState.ResumeTiming();
+        }
+    }
+    Tracer::Instance().Disable();
+    p_oState.SetItemsProcessed(p_oState.iterations());
+}
+
+void BM_TraceRecordDisabled(benchmark::State &p_oState)
+{
+    unsigned long long ullCount = 0;
+    for (auto _ : p_oState)
+    {
+        Tracer::Instance().Record("Benchmark", TracePhase::Instant, ullCount++);
+    }
+    p_oState.SetItemsProcessed(p_oState.iterations());
+}
+
+BENCHMARK(BM_TraceRecordEnabled);
+BENCHMARK(BM_TraceRecordDisabled);
\ No newline at end of file
@@ -0,0 +1,430 @@
+#pragma once
+
+//! System includes
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+//! Threading
+#include <mutex>
+#include <condition_variable>
+
+//! Channel Interface
+#include "IChannel.h"
+
+/*
+- Fan out channel , every message is written once in a ring and read by ALL subscribers
+- Each subscriber has its own cursor (sequence of the next message it will read) , Disruptor style
+- Subscribers read the message in place (Read with a visitor), no copies per subscriber
+- Ring slot is only reused once every subscriber moved past it , so the slowest subscriber applies backpressure on producers
+    - unless it subscribed with LagPolicy::Drop , then producers overwrite what it didn't read yet and it skips ahead
+      (Dropped() tells how many messages it lost)
+- A Subscriber is an IChannel<T> by itself so it can be read directly or added to a ChannelSelector
+    - multiple threads reading from the same subscriber share its messages (each message once per subscriber)
+    - SendValue on a subscriber publishes to the whole BroadcastChannel
+*/
+
+//! Questions / Edgecases:
+//! Q: Why is the visitor called without holding the lock ?
+//!     same as selectors handlers, it is user code , and also the whole point is that it reads the slot in place
+//!     the slot is safe without the lock since the subscriber is marked as reading , producers won't reuse it till it is done
+//! Q: What does a new subscriber see ?
+//!     only messages published after it subscribed
+
+enum class LagPolicy
+{
+    Block, //! Producers wait for this subscriber
+    Drop   //! Producers never wait for this subscriber, it skips messages it was too slow to read
+};
+
+template <typename T>
+class BroadcastChannel
+{
+    struct SubscriberState
+    {
+        unsigned long long m_ullCursor{0};
+        unsigned long long m_ullDropped{0};
+        LagPolicy m_eLagPolicy{LagPolicy::Block};
+        bool m_bIsReading{false};
+        bool m_bIsClosed{false};
+    };
+
+    struct State
+    {
+        explicit State(std::size_t p_sCapacity)
+            : m_vecRing(RoundUpToPowerOfTwo(p_sCapacity)), m_ullMask(m_vecRing.size() - 1)
+        {
+        }
+
+        std::mutex m_oMutex;
+        std::condition_variable m_oRecieveCv;
+        std::condition_variable m_oSlotAvailableCv;
+
+        std::vector<std::optional<T>> m_vecRing;
+        unsigned long long m_ullMask;
+        unsigned long long m_ullNextSequence{0};
+        std::map<unsigned long long, SubscriberState> m_oSubscribers;
+        unsigned long long m_ullSubscriberId{0};
+        bool m_bIsTerminated{false};
+
+        //! Listeners for Channel operations , keyed by {subscriber Id , listener Id}
+        std::mutex m_oListenersMutex;
+        std::map<std::pair<unsigned long long, unsigned long long>, std::function<void(void)>> m_oOnDataAvailableListeners;
+        std::map<std::pair<unsigned long long, unsigned long long>, std::function<void(void)>> m_oOnCloseListeners;
+        unsigned long long m_ullListenerId{0};
+    };
+
+public:
+    class Subscriber : public IChannel<T>
+    {
+    public:
+        Subscriber(std::shared_ptr<State> p_pState, unsigned long long p_ullId)
+            : m_pState(std::move(p_pState)), m_ullId(p_ullId)
+        {
+        }
+
+        //! std::optional<T> reads from IChannel
+        using IChannel<T>::ReadValue;
+        using IChannel<T>::TryReadValue;
+
+        //! Read next message in place , p_fVisitor is called with a const T&
+        //! Blocks till a message is available, returns false if the channel / subscription is closed
+        template <typename Visitor>
+        bool Read(Visitor &&p_fVisitor)
+        {
+            constexpr bool bBlock = true;
+            return Consume(std::forward<Visitor>(p_fVisitor), bBlock);
+        }
+
+        template <typename Visitor>
+        bool TryRead(Visitor &&p_fVisitor)
+        {
+            constexpr bool bBlock = false;
+            return Consume(std::forward<Visitor>(p_fVisitor), bBlock);
+        }
+
+        //! Number of messages this subscriber skipped because it was lagging (LagPolicy::Drop only)
+        unsigned long long Dropped()
+        {
+            std::lock_guard<std::mutex> oLock{m_pState->m_oMutex};
+            auto subscriberIt = m_pState->m_oSubscribers.find(m_ullId);
+            return subscriberIt == m_pState->m_oSubscribers.end() ? 0 : subscriberIt->second.m_ullDropped;
+        }
+
+        //! IChannel , publishes to all subscribers
+        virtual bool SendValue(T &&p_tValue) override
+        {
+            return BroadcastChannel::Publish(*m_pState, p_tValue, true);
+        }
+
+        virtual bool SendValue(T &p_tValue) override
+        {
+            return BroadcastChannel::Publish(*m_pState, p_tValue, false);
+        }
+
+        //! IChannel reads have to copy , other subscribers still need that slot
+        virtual bool ReadValue(T &p_tValue) override
+        {
+            return Read([&p_tValue](const T &p_tSlot)
+                        { p_tValue = p_tSlot; });
+        }
+
+        virtual bool TryReadValue(T &p_tValue) override
+        {
+            return TryRead([&p_tValue](const T &p_tSlot)
+                           { p_tValue = p_tSlot; });
+        }
+
+        //! Closes this subscription only, the BroadcastChannel and other subscribers are not affected
+        virtual void Close() override
+        {
+            {
+                std::lock_guard<std::mutex> oLock{m_pState->m_oMutex};
+                auto subscriberIt = m_pState->m_oSubscribers.find(m_ullId);
+                if (subscriberIt == m_pState->m_oSubscribers.end() || subscriberIt->second.m_bIsClosed)
+                {
+                    return;
+                }
+                subscriberIt->second.m_bIsClosed = true;
+                //! Stop gating producers , unless some thread is still reading its slot
+                if (!subscriberIt->second.m_bIsReading)
+                {
+                    m_pState->m_oSubscribers.erase(subscriberIt);
+                }
+            }
+            m_pState->m_oRecieveCv.notify_all();
+            m_pState->m_oSlotAvailableCv.notify_all();
+            NotifyOnCloseListeners();
+        }
+
+        ~Subscriber()
+        {
+            Close();
+            std::lock_guard<std::mutex> oLock{m_pState->m_oListenersMutex};
+            EraseListeners(m_pState->m_oOnDataAvailableListeners);
+            EraseListeners(m_pState->m_oOnCloseListeners);
+        }
+
+    protected:
+        virtual unsigned long long RegisterChannelOperationsListener(
+            std::function<void(void)> p_fOnDataAvailableCallback,
+            std::function<void(void)> p_fOnCloseAvailableCallback) override
+        {
+            std::lock_guard<std::mutex> oLock{m_pState->m_oListenersMutex};
+            unsigned long long iIdToUse = m_pState->m_ullListenerId;
+            m_pState->m_oOnDataAvailableListeners[{m_ullId, iIdToUse}] = std::move(p_fOnDataAvailableCallback);
+            m_pState->m_oOnCloseListeners[{m_ullId, iIdToUse}] = std::move(p_fOnCloseAvailableCallback);
+            m_pState->m_ullListenerId++;
+            return iIdToUse;
+        }
+
+        virtual void UnRegisterChannelOperationsListener(int p_iId) override
+        {
+            std::lock_guard<std::mutex> oLock{m_pState->m_oListenersMutex};
+            m_pState->m_oOnDataAvailableListeners.erase({m_ullId, p_iId});
+            m_pState->m_oOnCloseListeners.erase({m_ullId, p_iId});
+        }
+
+    private:
+        template <typename Visitor>
+        bool Consume(Visitor &&p_fVisitor, bool p_bBlock)
+        {
+            const std::optional<T> *pSlot = nullptr;
+            {
+                std::unique_lock<std::mutex> oLock{m_pState->m_oMutex};
+                auto subscriberIt = m_pState->m_oSubscribers.find(m_ullId);
+                if (subscriberIt == m_pState->m_oSubscribers.end())
+                {
+                    return false;
+                }
+                SubscriberState &oSubscriber = subscriberIt->second;
+                auto isReadable = [this, &oSubscriber]()
+                {
+                    return !oSubscriber.m_bIsReading && oSubscriber.m_ullCursor < m_pState->m_ullNextSequence;
+                };
+                if (p_bBlock)
+                {
+                    //! Another thread reading through this same subscriber holds its cursor , wait for it too
+                    m_pState->m_oRecieveCv.wait(oLock, [this, &oSubscriber, &isReadable]()
+                                                { return m_pState->m_bIsTerminated || oSubscriber.m_bIsClosed || isReadable(); });
+                }
+                if (m_pState->m_bIsTerminated || oSubscriber.m_bIsClosed || !isReadable())
+                {
+                    return false;
+                }
+                oSubscriber.m_bIsReading = true;
+                pSlot = &m_pState->m_vecRing[oSubscriber.m_ullCursor & m_pState->m_ullMask];
+            }
+
+            //! Slot is pinned by our cursor, read it in place without holding the lock
+            try
+            {
+                p_fVisitor(static_cast<const T &>(**pSlot));
+            }
+            catch (...)
+            {
+                //! Unpin it (the message stays unread) , otherwise blocked producers / readers of this subscriber would wait forever
+                constexpr bool bIsConsumed = false;
+                EndRead(bIsConsumed);
+                throw;
+            }
+            constexpr bool bIsConsumed = true;
+            EndRead(bIsConsumed);
+            return true;
+        }
+
+        //! Releases the slot pinned by Consume , moving past it if it was read
+        void EndRead(bool p_bIsConsumed)
+        {
+            {
+                std::lock_guard<std::mutex> oLock{m_pState->m_oMutex};
+                auto subscriberIt = m_pState->m_oSubscribers.find(m_ullId);
+                SubscriberState &oSubscriber = subscriberIt->second;
+                oSubscriber.m_bIsReading = false;
+                if (p_bIsConsumed)
+                {
+                    oSubscriber.m_ullCursor++;
+                }
+                if (oSubscriber.m_bIsClosed)
+                {
+                    //! Closed while we were reading , it is our job to stop it from gating producers now
+                    m_pState->m_oSubscribers.erase(subscriberIt);
+                }
+                else
+                {
+                    BroadcastChannel::SkipOverwrittenMessages(*m_pState, oSubscriber);
+                }
+            }
+            m_pState->m_oSlotAvailableCv.notify_all();
+            //! Other readers of this same subscriber may be waiting on m_bIsReading
+            m_pState->m_oRecieveCv.notify_all();
+        }
+
+        void NotifyOnCloseListeners()
+        {
+            std::lock_guard<std::mutex> oLock{m_pState->m_oListenersMutex};
+            for (auto &entry : m_pState->m_oOnCloseListeners)
+            {
+                if (entry.first.first == m_ullId)
+                {
+                    entry.second();
+                }
+            }
+        }
+
+        template <typename Listeners>
+        void EraseListeners(Listeners &p_oListeners)
+        {
+            auto beginIt = p_oListeners.lower_bound({m_ullId, 0});
+            auto endIt = p_oListeners.lower_bound({m_ullId + 1, 0});
+            p_oListeners.erase(beginIt, endIt);
+        }
+
+        std::shared_ptr<State> m_pState;
+        unsigned long long m_ullId;
+    };
+
+    BroadcastChannel(std::size_t p_sCapacity)
+    {
+        if (p_sCapacity <= 0)
+        {
+            throw std::logic_error("Cannot Create a BroadcastChannel With Len <= 0");
+        }
+        m_pState = std::make_shared<State>(p_sCapacity);
+    }
+
+    //! New subscriber starts reading from the next published message
+    std::shared_ptr<Subscriber> Subscribe(LagPolicy p_eLagPolicy = LagPolicy::Block)
+    {
+        std::lock_guard<std::mutex> oLock{m_pState->m_oMutex};
+        unsigned long long ullId = m_pState->m_ullSubscriberId++;
+        SubscriberState &oSubscriber = m_pState->m_oSubscribers[ullId];
+        oSubscriber.m_ullCursor = m_pState->m_ullNextSequence;
+        oSubscriber.m_eLagPolicy = p_eLagPolicy;
+        return std::make_shared<Subscriber>(m_pState, ullId);
+    }
+
+    //! Block till the slowest (blocking) subscriber frees a slot
+    bool SendValue(T &&p_tValue)
+    {
+        return Publish(*m_pState, p_tValue, true);
+    }
+
+    bool SendValue(T &p_tValue)
+    {
+        return Publish(*m_pState, p_tValue, false);
+    }
+
+    void Close()
+    {
+        {
+            std::lock_guard<std::mutex> oLock{m_pState->m_oMutex};
+            m_pState->m_bIsTerminated = true;
+        }
+        m_pState->m_oSlotAvailableCv.notify_all();
+        m_pState->m_oRecieveCv.notify_all();
+        std::lock_guard<std::mutex> oLock{m_pState->m_oListenersMutex};
+        for (auto &entry : m_pState->m_oOnCloseListeners)
+        {
+            entry.second();
+        }
+    }
+
+    ~BroadcastChannel()
+    {
+        Close();
+    }
+
+private:
+    static std::size_t RoundUpToPowerOfTwo(std::size_t p_sValue)
+    {
+        std::size_t sPowerOfTwo = 1;
+        while (sPowerOfTwo < p_sValue)
+        {
+            sPowerOfTwo <<= 1;
+        }
+        return sPowerOfTwo;
+    }
+
+    //! Called while holding the state lock
+    //! sequence of the oldest message that still can't be overwritten
+    static unsigned long long GatingSequence(State &p_oState)
+    {
+        unsigned long long ullGatingSequence = p_oState.m_ullNextSequence;
+        for (auto &entry : p_oState.m_oSubscribers)
+        {
+            const SubscriberState &oSubscriber = entry.second;
+            //! A dropping subscriber only gates the slot it is reading right now
+            if (oSubscriber.m_eLagPolicy == LagPolicy::Block || oSubscriber.m_bIsReading)
+            {
+                ullGatingSequence = std::min(ullGatingSequence, oSubscriber.m_ullCursor);
+            }
+        }
+        return ullGatingSequence;
+    }
+
+    //! Called while holding the state lock
+    static void SkipOverwrittenMessages(State &p_oState, SubscriberState &p_oSubscriber)
+    {
+        unsigned long long ullCapacity = p_oState.m_vecRing.size();
+        if (p_oSubscriber.m_bIsReading || p_oState.m_ullNextSequence - p_oSubscriber.m_ullCursor <= ullCapacity)
+        {
+            return;
+        }
+        unsigned long long ullOldestAvailable = p_oState.m_ullNextSequence - ullCapacity;
+        p_oSubscriber.m_ullDropped += ullOldestAvailable - p_oSubscriber.m_ullCursor;
+        p_oSubscriber.m_ullCursor = ullOldestAvailable;
+    }
+
+    static bool Publish(State &p_oState, T &p_tValue, bool p_bMove)
+    {
+        {
+            std::unique_lock<std::mutex> oLock{p_oState.m_oMutex};
+            //! Block till the slot we are about to overwrite was read by every subscriber gating us
+            p_oState.m_oSlotAvailableCv.wait(oLock, [&p_oState]()
+                                             { return p_oState.m_bIsTerminated ||
+                                                      p_oState.m_ullNextSequence - GatingSequence(p_oState) < p_oState.m_vecRing.size(); });
+            if (p_oState.m_bIsTerminated)
+            {
+                return false;
+            }
+            std::optional<T> &oSlot = p_oState.m_vecRing[p_oState.m_ullNextSequence & p_oState.m_ullMask];
+            if (p_bMove)
+            {
+                //! Move
+                oSlot.emplace(std::move(p_tValue));
+            }
+            else
+            {
+                //! Copy
+                oSlot.emplace(p_tValue);
+            }
+            p_oState.m_ullNextSequence++;
+            for (auto &entry : p_oState.m_oSubscribers)
+            {
+                if (entry.second.m_eLagPolicy == LagPolicy::Drop)
+                {
+                    SkipOverwrittenMessages(p_oState, entry.second);
+                }
+            }
+        }
+        //! Every subscriber has to see it
+        p_oState.m_oRecieveCv.notify_all();
+
+        //! Lock is release before calling it , to avoid deadlocks
+        std::lock_guard<std::mutex> oLock{p_oState.m_oListenersMutex};
+        for (auto &entry : p_oState.m_oOnDataAvailableListeners)
+        {
+            entry.second();
+        }
+        return true;
+    }
+
+    std::shared_ptr<State> m_pState;
+};
\ No newline at end of file
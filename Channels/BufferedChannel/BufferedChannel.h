@@ -2,6 +2,12 @@
 
 #include <map>
 #include <queue>
+#include <deque>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
 
 //! Threading
 #include <mutex>
@@ -10,12 +16,19 @@
 //! Channel Interface
 #include "IChannel.h"
 
-template <typename T>
+//! Instrumentation
+#include "Metrics.h"
+#include "Tracing.h"
+
+template <typename T, typename Allocator = std::allocator<T>>
 class BufferedChannel : public IChannel<T>
 {
 public:
-    BufferedChannel(std::size_t p_sChannelMaxSize)
-        : m_sChannelMaxSize(p_sChannelMaxSize)
+    BufferedChannel(std::size_t p_sChannelMaxSize, const Allocator &p_oAllocator = Allocator())
+        : m_oBuffer(p_oAllocator),
+          m_sChannelMaxSize(p_sChannelMaxSize),
+          m_oOnDataAvailableListeners(ListenersAllocator(p_oAllocator)),
+          m_oOnCloseListeners(ListenersAllocator(p_oAllocator))
     {
         if (m_sChannelMaxSize <= 0)
         {
@@ -39,6 +52,26 @@ public:
     }
 
     bool SendValue(T &p_tValue, bool p_bMove)
+    {
+        if (p_bMove)
+        {
+            //! Move
+            return Emplace(std::move(p_tValue));
+        }
+        else if constexpr (std::is_copy_constructible_v<T>)
+        {
+            //! Copy
+            return Emplace(static_cast<const T &>(p_tValue));
+        }
+        else
+        {
+            throw std::logic_error("Cannot Copy a move only value into a BufferedChannel, send it as T&&");
+        }
+    }
+
+    //! Same as SendValue , but the value is constructed from p_args right in the buffer (no temporary T to move)
+    template <typename... Args>
+    bool Emplace(Args &&...p_args)
     {
         //! Lock is released after updating internal state
         //! This is important cause of the callback that we call (user defined code)
@@ -49,23 +82,18 @@ public:
         {
             std::unique_lock<std::mutex> olock{m_oBufferMutex};
             //! Block till a slot is available in the buffer
-            m_oSlotAvailableCv.wait(olock, [this]()
-                                    { return m_oBuffer.size() < m_sChannelMaxSize || m_bIsTerminated; });
+            auto isSlotAvailable = [this]()
+            { return m_oBuffer.size() < m_sChannelMaxSize || m_bIsTerminated; };
+            CONCURRENCY_LIB_METRICS_ONLY(MetricsTimedWait(m_oSlotAvailableCv, olock, isSlotAvailable, m_oMetrics.m_oSendBlockTime);)
+            m_oSlotAvailableCv.wait(olock, isSlotAvailable);
 
             if (m_bIsTerminated)
             {
                 return false;
             }
-            if (p_bMove)
-            {
-                //! Move
-                m_oBuffer.push(std::move(p_tValue));
-            }
-            else
-            {
-                //! Copy
-                m_oBuffer.push(p_tValue);
-            }
+            m_oBuffer.emplace(std::forward<Args>(p_args)...);
+            CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oEnqueued.Add();)
+            CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oHighWaterMark.Update(m_oBuffer.size());)
         }
 
         //! Notify anyone waiting to read from the buffer that a value is available
@@ -74,44 +102,33 @@ public:
         //! this happens within the context of the thread that creates and puts it on the channel (Producer)
         //! Lock is release before calling it , to avoid deadlocks
         NotifyOnDataAvailableListeners();
+        CONCURRENCY_LIB_TRACE("Channel::Send", TracePhase::Instant, reinterpret_cast<unsigned long long>(this));
 
         return true;
     }
 
     virtual bool ReadValue(T &p_tValue) override
     {
-        {
-            std::unique_lock<std::mutex> olock{m_oBufferMutex};
-            //! Block till a value is available in the buffer, i.e Not Empty
-            m_oRecieveCv.wait(olock, [this]()
-                              { return !m_oBuffer.empty() || m_bIsTerminated; });
-            if (m_bIsTerminated)
-            {
-                return false;
-            }
-            //! Consume value
-            p_tValue = std::move(m_oBuffer.front());
-            m_oBuffer.pop();
-        }
-        //! Notify Prodcuers that a slot has become available
-        m_oSlotAvailableCv.notify_one();
-        return true;
+        constexpr bool bIsBlocking = true;
+        return Read(p_tValue, bIsBlocking);
     }
 
     virtual bool TryReadValue(T &p_tValue) override
     {
-        {
-            std::lock_guard<std::mutex> oLock{m_oBufferMutex};
-            if (m_bIsTerminated || m_oBuffer.empty())
-            {
-                return false;
-            }
-            //! Consume value
-            p_tValue = std::move(m_oBuffer.front());
-            m_oBuffer.pop();
-        }
-        m_oSlotAvailableCv.notify_one();
-        return true;
+        constexpr bool bIsBlocking = false;
+        return Read(p_tValue, bIsBlocking);
+    }
+
+    virtual bool ReadValue(std::optional<T> &p_oValue) override
+    {
+        constexpr bool bIsBlocking = true;
+        return Read(p_oValue, bIsBlocking);
+    }
+
+    virtual bool TryReadValue(std::optional<T> &p_oValue) override
+    {
+        constexpr bool bIsBlocking = false;
+        return Read(p_oValue, bIsBlocking);
     }
 
     virtual void Close() override
@@ -130,6 +147,14 @@ public:
         Close();
     }
 
+    //! All zeros unless built with CONCURRENCY_LIB_METRICS
+    ChannelMetricsSnapshot GetMetricsSnapshot() const
+    {
+        ChannelMetricsSnapshot oSnapshot;
+        CONCURRENCY_LIB_METRICS_ONLY(oSnapshot = m_oMetrics.Snapshot();)
+        return oSnapshot;
+    }
+
 protected:
     virtual unsigned long long RegisterChannelOperationsListener(
         std::function<void(void)> p_fOnDataAvailableCallback,
@@ -145,11 +170,53 @@ protected:
 
     virtual void UnRegisterChannelOperationsListener(int p_iId) override
     {
+        //! Producers may be iterating the listeners (Notify*) at the same time
+        //! holding the lock also guarantees that once we return , the removed listener is not being executed anymore
+        std::lock_guard<std::mutex> oLock{m_oListenersMutex};
         m_oOnDataAvailableListeners.erase(p_iId);
         m_oOnCloseListeners.erase(p_iId);
     }
 
 private:
+    //! p_oOutput is either a T& or an std::optional<T>& , the value is moved out of the buffer in both cases
+    template <typename Output>
+    bool Read(Output &p_oOutput, bool p_bIsBlocking)
+    {
+        {
+            std::unique_lock<std::mutex> olock{m_oBufferMutex};
+            if (p_bIsBlocking)
+            {
+                //! Block till a value is available in the buffer, i.e Not Empty
+                auto isValueAvailable = [this]()
+                { return !m_oBuffer.empty() || m_bIsTerminated; };
+                CONCURRENCY_LIB_METRICS_ONLY(MetricsTimedWait(m_oRecieveCv, olock, isValueAvailable, m_oMetrics.m_oReceiveBlockTime);)
+                m_oRecieveCv.wait(olock, isValueAvailable);
+            }
+            if (m_bIsTerminated || m_oBuffer.empty())
+            {
+                return false;
+            }
+            //! Consume value
+            MoveValueOut(p_oOutput);
+            m_oBuffer.pop();
+            CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oDequeued.Add();)
+        }
+        //! Notify Prodcuers that a slot has become available
+        m_oSlotAvailableCv.notify_one();
+        CONCURRENCY_LIB_TRACE("Channel::Receive", TracePhase::Instant, reinterpret_cast<unsigned long long>(this));
+        return true;
+    }
+
+    void MoveValueOut(T &p_tValue)
+    {
+        p_tValue = std::move(m_oBuffer.front());
+    }
+
+    void MoveValueOut(std::optional<T> &p_oValue)
+    {
+        p_oValue.emplace(std::move(m_oBuffer.front()));
+    }
+
     void NotifyOnDataAvailableListeners()
     {
         std::lock_guard<std::mutex> oLock{m_oListenersMutex};
@@ -171,13 +238,23 @@ private:
     std::condition_variable m_oRecieveCv;
     std::condition_variable m_oSlotAvailableCv;
 
-    std::queue<T> m_oBuffer;
+    std::queue<T, std::deque<T, Allocator>> m_oBuffer;
     std::size_t m_sChannelMaxSize;
     bool m_bIsTerminated{false};
 
     //! Listeners for Channel operations
     std::mutex m_oListenersMutex;
-    std::map<int, std::function<void(void)>> m_oOnDataAvailableListeners;
-    std::map<int, std::function<void(void)>> m_oOnCloseListeners;
+    using ListenersAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<std::pair<const int, std::function<void(void)>>>;
+    using ListenersMap = std::map<int, std::function<void(void)>, std::less<int>, ListenersAllocator>;
+    ListenersMap m_oOnDataAvailableListeners;
+    ListenersMap m_oOnCloseListeners;
     unsigned long long m_iID{0};
-};
\ No newline at end of file
+
+    CONCURRENCY_LIB_METRICS_ONLY(ChannelMetrics m_oMetrics;)
+};
+
+//! BufferedChannel drawing all of its memory (buffer + listeners) from a std::pmr::memory_resource
+//! the resource has to be thread safe (synchronized_pool_resource) if listeners are used,
+//! since the buffer and the listeners are guarded by different mutexes
+template <typename T>
+using PmrBufferedChannel = BufferedChannel<T, std::pmr::polymorphic_allocator<T>>;
\ No newline at end of file
@@ -0,0 +1,255 @@
+#pragma once
+
+//! System includes
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+
+//! Threading
+#include <mutex>
+#include <condition_variable>
+
+/*
+    - Byte oriented channel over one contiguous ring (bip buffer) , for variable sized records (serialized messages , frames ..)
+    - Producer : Reserve(n) -> write the record in place -> Commit(written)
+    - Consumer : Peek() -> parse in place -> Release(consumed)
+    - The ring is allocated once , records go from producer to consumer with no allocation and no intermediate copy
+    - A reservation is always contiguous , when the end of the ring is too short it is taken from the start (second region)
+      so a record never straddles the wrap
+*/
+
+//! Questions / Edgecases:
+//! Q: How does the consumer know where records start / end ?
+//!     it doesn't , it is a byte stream , frame records yourself (length prefix ..) , Peek may return several records
+//!     and Release may consume only part of what was peeked
+//! Q: Multiple producers / consumers ?
+//!     Supported , but only one reservation (and one peek) is outstanding at a time , others block in Reserve (Peek) till it is committed (released)
+//!     writes / reads themselves happen outside of the lock
+//! Q: Alignment ?
+//!     Reservations start right after the previous commit , keep records sizes a multiple of the alignment you need or memcpy fields
+//! Q: Close ?
+//!     same as BufferedChannel , Reserve / Peek fail once closed , bytes still in the ring are dropped
+
+class ByteStreamChannel
+{
+public:
+    explicit ByteStreamChannel(std::size_t p_sCapacity)
+        : m_pBuffer(std::make_unique<std::byte[]>(p_sCapacity)),
+          m_sCapacity(p_sCapacity)
+    {
+        if (m_sCapacity <= 0)
+        {
+            throw std::logic_error("Cannot Create a ByteStreamChannel With Len <= 0");
+        }
+    }
+
+    ByteStreamChannel(const ByteStreamChannel &) = delete;
+    ByteStreamChannel &operator=(const ByteStreamChannel &) = delete;
+
+    ~ByteStreamChannel()
+    {
+        Close();
+    }
+
+    //! Block till p_sSize contiguous bytes are free , nullptr once closed
+    //! the returned bytes belong to the caller till Commit
+    std::byte *Reserve(std::size_t p_sSize)
+    {
+        CheckReservationSize(p_sSize);
+        std::unique_lock<std::mutex> oLock{m_oMutex};
+        std::byte *pReserved = nullptr;
+        m_oSpaceAvailableCv.wait(oLock, [this, p_sSize, &pReserved]()
+                                 { return m_bIsTerminated || (pReserved = TryReserveUnlocked(p_sSize)) != nullptr; });
+        return m_bIsTerminated ? nullptr : pReserved;
+    }
+
+    //! nullptr if closed or there isn't p_sSize contiguous bytes free right now
+    std::byte *TryReserve(std::size_t p_sSize)
+    {
+        CheckReservationSize(p_sSize);
+        std::lock_guard<std::mutex> oLock{m_oMutex};
+        return m_bIsTerminated ? nullptr : TryReserveUnlocked(p_sSize);
+    }
+
+    //! Publish the first p_sSize bytes of the reservation (may be less than reserved , the rest is given back)
+    void Commit(std::size_t p_sSize)
+    {
+        {
+            std::lock_guard<std::mutex> oLock{m_oMutex};
+            if (!m_bIsReserving || p_sSize > m_sReservedSize)
+            {
+                throw std::logic_error("ByteStreamChannel Commit without a matching Reserve");
+            }
+            if (m_bIsReservedInSecondRegion)
+            {
+                m_sSecondEnd += p_sSize;
+            }
+            else
+            {
+                m_sFirstEnd += p_sSize;
+            }
+            m_bIsReserving = false;
+            ResetIfEmpty();
+        }
+        m_oDataAvailableCv.notify_all();
+        //! Other producers may be waiting for the reservation to be over
+        m_oSpaceAvailableCv.notify_all();
+    }
+
+    //! Block till bytes are available , false once closed
+    //! p_pData / p_sSize : every contiguous byte committed so far (from the oldest) , they stay valid till Release
+    bool Peek(const std::byte *&p_pData, std::size_t &p_sSize)
+    {
+        std::unique_lock<std::mutex> oLock{m_oMutex};
+        m_oDataAvailableCv.wait(oLock, [this]()
+                                { return m_bIsTerminated || (!m_bIsPeeking && m_sFirstEnd > m_sFirstStart); });
+        if (m_bIsTerminated)
+        {
+            return false;
+        }
+        PeekUnlocked(p_pData, p_sSize);
+        return true;
+    }
+
+    bool TryPeek(const std::byte *&p_pData, std::size_t &p_sSize)
+    {
+        std::lock_guard<std::mutex> oLock{m_oMutex};
+        if (m_bIsTerminated || m_bIsPeeking || m_sFirstEnd == m_sFirstStart)
+        {
+            return false;
+        }
+        PeekUnlocked(p_pData, p_sSize);
+        return true;
+    }
+
+    //! Give back the first p_sSize peeked bytes to producers
+    void Release(std::size_t p_sSize)
+    {
+        {
+            std::lock_guard<std::mutex> oLock{m_oMutex};
+            if (!m_bIsPeeking || p_sSize > m_sPeekedSize)
+            {
+                throw std::logic_error("ByteStreamChannel Release without a matching Peek");
+            }
+            m_sFirstStart += p_sSize;
+            if (m_sFirstStart == m_sFirstEnd && m_bIsSecondRegionUsed)
+            {
+                //! First region consumed , the second one (at the start of the ring) becomes the first
+                m_sFirstStart = 0;
+                m_sFirstEnd = m_sSecondEnd;
+                m_sSecondEnd = 0;
+                m_bIsSecondRegionUsed = false;
+                m_bIsReservedInSecondRegion = false;
+            }
+            ResetIfEmpty();
+            m_bIsPeeking = false;
+        }
+        m_oSpaceAvailableCv.notify_all();
+        //! Other consumers may be waiting for the peek to be over
+        m_oDataAvailableCv.notify_all();
+    }
+
+    void Close()
+    {
+        {
+            std::lock_guard<std::mutex> oLock{m_oMutex};
+            m_bIsTerminated = true;
+        }
+        m_oSpaceAvailableCv.notify_all();
+        m_oDataAvailableCv.notify_all();
+    }
+
+    std::size_t GetCapacity() const
+    {
+        return m_sCapacity;
+    }
+
+private:
+    void CheckReservationSize(std::size_t p_sSize) const
+    {
+        if (p_sSize <= 0 || p_sSize > m_sCapacity)
+        {
+            throw std::logic_error("ByteStreamChannel reservation has to be in ]0, capacity]");
+        }
+    }
+
+    //! Lock is held
+    std::byte *TryReserveUnlocked(std::size_t p_sSize)
+    {
+        if (m_bIsReserving)
+        {
+            return nullptr;
+        }
+        std::size_t sOffset;
+        if (m_bIsSecondRegionUsed)
+        {
+            //! Second region grows up to where the first one starts
+            if (m_sFirstStart - m_sSecondEnd < p_sSize)
+            {
+                return nullptr;
+            }
+            sOffset = m_sSecondEnd;
+            m_bIsReservedInSecondRegion = true;
+        }
+        else if (m_sCapacity - m_sFirstEnd >= p_sSize)
+        {
+            sOffset = m_sFirstEnd;
+            m_bIsReservedInSecondRegion = false;
+        }
+        else if (m_sFirstStart >= p_sSize)
+        {
+            //! Not enough room at the end , wrap to the start of the ring
+            m_bIsSecondRegionUsed = true;
+            m_sSecondEnd = 0;
+            sOffset = 0;
+            m_bIsReservedInSecondRegion = true;
+        }
+        else
+        {
+            return nullptr;
+        }
+        m_bIsReserving = true;
+        m_sReservedSize = p_sSize;
+        return m_pBuffer.get() + sOffset;
+    }
+
+    //! Lock is held
+    void PeekUnlocked(const std::byte *&p_pData, std::size_t &p_sSize)
+    {
+        m_bIsPeeking = true;
+        m_sPeekedSize = m_sFirstEnd - m_sFirstStart;
+        p_pData = m_pBuffer.get() + m_sFirstStart;
+        p_sSize = m_sPeekedSize;
+    }
+
+    //! Lock is held , an empty ring restarts from offset 0 so the whole capacity is contiguous again
+    //! not while a reservation is pending at the end of the first region , it would move under the producer
+    void ResetIfEmpty()
+    {
+        if (m_sFirstStart == m_sFirstEnd && !m_bIsSecondRegionUsed && !m_bIsReserving)
+        {
+            m_sFirstStart = 0;
+            m_sFirstEnd = 0;
+        }
+    }
+
+    std::unique_ptr<std::byte[]> m_pBuffer;
+    std::size_t m_sCapacity;
+
+    //! First region [m_sFirstStart, m_sFirstEnd) , second region [0, m_sSecondEnd) once the producer wrapped
+    std::size_t m_sFirstStart{0};
+    std::size_t m_sFirstEnd{0};
+    std::size_t m_sSecondEnd{0};
+    bool m_bIsSecondRegionUsed{false};
+
+    bool m_bIsReserving{false};
+    bool m_bIsReservedInSecondRegion{false};
+    std::size_t m_sReservedSize{0};
+    bool m_bIsPeeking{false};
+    std::size_t m_sPeekedSize{0};
+
+    bool m_bIsTerminated{false};
+    std::mutex m_oMutex;
+    std::condition_variable m_oSpaceAvailableCv;
+    std::condition_variable m_oDataAvailableCv;
+};
\ No newline at end of file
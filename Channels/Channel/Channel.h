@@ -0,0 +1,328 @@
+#pragma once
+
+//! System includes
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+//! Channel Interface
+#include "WaitPolicies.h"
+
+/*
+    - Compile time configured bounded channel , no virtual dispatch , no allocation
+    - Capacity is a template argument : the ring is an inline array , indexed with a mask (Capacity has to be a power of two)
+    - Producers / Consumers (Arity::Single or Arity::Multi) pick the algorithm at compile time :
+        Multi side claims positions with a CAS , Single side with a plain store (no read modify write on the hot path)
+    - WaitPolicy decides how a blocked Send / Read waits (see WaitPolicies.h)
+    - same method names and Close semantics as BufferedChannel (Close makes every Send / Read fail , buffered values are dropped)
+    - ChannelAdapter<Channel<...>> exposes it as IChannel<T> for the ChannelSelector and other runtime code
+*/
+
+//! Questions / Edgecases:
+//! Q: Why per slot sequence numbers even for single producer / single consumer ?
+//!     the slot sequence is the only word the two sides share per message , producer and consumer never read each other's index
+//!     so the Single variants only drop the CAS , the hand off stays the same for every arity
+//! Q: What if the Arity lies (two threads Send on an Arity::Single producer side) ?
+//!     Undefined , both would claim the same position , the Arity is a promise from the caller
+//! Q: Can T be move only / non default constructible ?
+//!     Yes , values are constructed in place in the slot (Emplace) and moved out (ReadValue into std::optional<T>)
+//! Q: What if T's constructor throws inside the slot ?
+//!     the position is already claimed (other producers went past it) , so the slot is published as a tombstone and the exception rethrown
+//!     consumers free a tombstone and move on to the next position , the ring never stalls and no unconstructed T is destroyed
+
+enum class Arity
+{
+    Single,
+    Multi
+};
+
+template <typename T, std::size_t Capacity, Arity Producers = Arity::Multi, Arity Consumers = Arity::Multi, typename WaitPolicy = FutexWaitPolicy>
+class Channel
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Channel Capacity has to be a power of two");
+
+public:
+    using ValueType = T;
+
+    static constexpr std::size_t s_sCapacity = Capacity;
+    static constexpr Arity s_eProducers = Producers;
+    static constexpr Arity s_eConsumers = Consumers;
+
+    Channel()
+    {
+        for (std::size_t sSlot = 0; sSlot < Capacity; ++sSlot)
+        {
+            m_arrSlots[sSlot].m_sSequence.store(sSlot, std::memory_order_relaxed);
+        }
+    }
+
+    Channel(const Channel &) = delete;
+    Channel &operator=(const Channel &) = delete;
+
+    //! Values still buffered are destroyed with the channel
+    ~Channel()
+    {
+        std::size_t sTail = m_sTail.load(std::memory_order_relaxed);
+        for (std::size_t sPosition = m_sHead.load(std::memory_order_relaxed); sPosition != sTail; ++sPosition)
+        {
+            Slot &oSlot = m_arrSlots[sPosition & s_sMask];
+            if (!oSlot.m_bIsTombstone)
+            {
+                oSlot.Value()->~T();
+            }
+        }
+    }
+
+    //! Block till a slot is free
+    bool SendValue(T &&p_tValue)
+    {
+        return Emplace(std::move(p_tValue));
+    }
+
+    bool SendValue(const T &p_tValue)
+    {
+        return Emplace(p_tValue);
+    }
+
+    //! Same as SendValue , but the value is constructed from p_args right in the slot
+    //! if T's constructor throws , the exception propagates and nothing is sent (see Q above)
+    template <typename... Args>
+    bool Emplace(Args &&...p_args)
+    {
+        //! Carried out of the wait policy , rethrown once it is done waiting
+        std::exception_ptr pException;
+        bool bResult = m_oSpaceAvailable.WaitUntil([&]()
+                                                   { return TryPush<Args...>(pException, p_args...); },
+                                                   [this]()
+                                                   { return IsClosed(); });
+        if (bResult)
+        {
+            m_oDataAvailable.WakeUpOne();
+        }
+        if (pException)
+        {
+            std::rethrow_exception(pException);
+        }
+        return bResult;
+    }
+
+    //! Never blocks , false if full or closed
+    template <typename... Args>
+    bool TryEmplace(Args &&...p_args)
+    {
+        std::exception_ptr pException;
+        if (IsClosed() || !TryPush<Args...>(pException, p_args...))
+        {
+            return false;
+        }
+        m_oDataAvailable.WakeUpOne();
+        if (pException)
+        {
+            std::rethrow_exception(pException);
+        }
+        return true;
+    }
+
+    //! Block till a value is available
+    bool ReadValue(T &p_tValue)
+    {
+        constexpr bool bIsBlocking = true;
+        return Read(p_tValue, bIsBlocking);
+    }
+
+    bool TryReadValue(T &p_tValue)
+    {
+        constexpr bool bIsBlocking = false;
+        return Read(p_tValue, bIsBlocking);
+    }
+
+    bool ReadValue(std::optional<T> &p_oValue)
+    {
+        constexpr bool bIsBlocking = true;
+        return Read(p_oValue, bIsBlocking);
+    }
+
+    bool TryReadValue(std::optional<T> &p_oValue)
+    {
+        constexpr bool bIsBlocking = false;
+        return Read(p_oValue, bIsBlocking);
+    }
+
+    void Close()
+    {
+        m_bIsClosed.store(true);
+        m_oDataAvailable.WakeUpAll();
+        m_oSpaceAvailable.WakeUpAll();
+    }
+
+    bool IsClosed() const
+    {
+        return m_bIsClosed.load(std::memory_order_acquire);
+    }
+
+    static constexpr std::size_t GetCapacity()
+    {
+        return Capacity;
+    }
+
+private:
+    //! Sequence == position : free for the producer at that position , position + 1 : holds its value
+    struct Slot
+    {
+        std::atomic<std::size_t> m_sSequence;
+        //! Published with the sequence , set when T's constructor threw (no value in the storage)
+        bool m_bIsTombstone{false};
+        alignas(T) unsigned char m_arrStorage[sizeof(T)];
+
+        T *Value()
+        {
+            return std::launder(reinterpret_cast<T *>(m_arrStorage));
+        }
+    };
+
+    static constexpr std::size_t s_sMask = Capacity - 1;
+    static constexpr std::size_t s_sCacheLineSize = 64;
+
+    template <typename Output>
+    bool Read(Output &p_oOutput, bool p_bIsBlocking)
+    {
+        bool bResult = false;
+        if (p_bIsBlocking)
+        {
+            bResult = m_oDataAvailable.WaitUntil([&]()
+                                                 { return TryPop(p_oOutput); },
+                                                 [this]()
+                                                 { return IsClosed(); });
+        }
+        else
+        {
+            bResult = !IsClosed() && TryPop(p_oOutput);
+        }
+        if (bResult)
+        {
+            m_oSpaceAvailable.WakeUpOne();
+        }
+        return bResult;
+    }
+
+    //! Claims the next position of one side , nullptr if the ring is full (producers) / empty (consumers)
+    //! p_sLag is 0 for producers (slot has to be free) and 1 for consumers (slot has to hold a value)
+    template <Arity Side>
+    Slot *Claim(std::atomic<std::size_t> &p_oIndex, std::size_t p_sLag, std::size_t &p_sPosition)
+    {
+        p_sPosition = p_oIndex.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot &oSlot = m_arrSlots[p_sPosition & s_sMask];
+            std::ptrdiff_t sDiff = static_cast<std::ptrdiff_t>(oSlot.m_sSequence.load(std::memory_order_acquire) - (p_sPosition + p_sLag));
+            if (sDiff == 0)
+            {
+                if constexpr (Side == Arity::Single)
+                {
+                    //! Only this thread moves the index
+                    p_oIndex.store(p_sPosition + 1, std::memory_order_relaxed);
+                    return &oSlot;
+                }
+                else if (p_oIndex.compare_exchange_weak(p_sPosition, p_sPosition + 1, std::memory_order_relaxed))
+                {
+                    return &oSlot;
+                }
+            }
+            else if (sDiff < 0)
+            {
+                return nullptr;
+            }
+            else
+            {
+                //! Another thread of the same side took it
+                p_sPosition = p_oIndex.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    //! Args are the ones given to Emplace , p_args are only forwarded (moved from) once a slot is claimed
+    //! a throwing constructor publishes a tombstone and hands the exception back in p_pOutException (the slot is still used up)
+    template <typename... Args>
+    bool TryPush(std::exception_ptr &p_pOutException, std::remove_reference_t<Args> &...p_args)
+    {
+        std::size_t sPosition = 0;
+        Slot *pSlot = Claim<Producers>(m_sTail, 0, sPosition);
+        if (pSlot == nullptr)
+        {
+            return false;
+        }
+        if constexpr (std::is_nothrow_constructible_v<T, Args &&...>)
+        {
+            new (pSlot->m_arrStorage) T(std::forward<Args>(p_args)...);
+        }
+        else
+        {
+            try
+            {
+                new (pSlot->m_arrStorage) T(std::forward<Args>(p_args)...);
+            }
+            catch (...)
+            {
+                pSlot->m_bIsTombstone = true;
+                p_pOutException = std::current_exception();
+            }
+        }
+        pSlot->m_sSequence.store(sPosition + 1, std::memory_order_release);
+        return true;
+    }
+
+    template <typename Output>
+    bool TryPop(Output &p_oOutput)
+    {
+        while (true)
+        {
+            std::size_t sPosition = 0;
+            Slot *pSlot = Claim<Consumers>(m_sHead, 1, sPosition);
+            if (pSlot == nullptr)
+            {
+                return false;
+            }
+            if (pSlot->m_bIsTombstone)
+            {
+                //! Nothing to read , free it and look at the next position
+                pSlot->m_bIsTombstone = false;
+                pSlot->m_sSequence.store(sPosition + Capacity, std::memory_order_release);
+                m_oSpaceAvailable.WakeUpOne();
+                continue;
+            }
+            MoveValueOut(*pSlot->Value(), p_oOutput);
+            pSlot->Value()->~T();
+            //! Free for the producer one lap later
+            pSlot->m_sSequence.store(sPosition + Capacity, std::memory_order_release);
+            return true;
+        }
+    }
+
+    static void MoveValueOut(T &p_tSource, T &p_tValue)
+    {
+        p_tValue = std::move(p_tSource);
+    }
+
+    static void MoveValueOut(T &p_tSource, std::optional<T> &p_oValue)
+    {
+        p_oValue.emplace(std::move(p_tSource));
+    }
+
+    alignas(s_sCacheLineSize) std::atomic<std::size_t> m_sTail{0};
+    alignas(s_sCacheLineSize) std::atomic<std::size_t> m_sHead{0};
+    alignas(s_sCacheLineSize) std::atomic<bool> m_bIsClosed{false};
+    alignas(s_sCacheLineSize) WaitPolicy m_oDataAvailable;
+    alignas(s_sCacheLineSize) WaitPolicy m_oSpaceAvailable;
+    alignas(s_sCacheLineSize) std::array<Slot, Capacity> m_arrSlots;
+};
+
+//! Single producer / single consumer shorthand
+template <typename T, std::size_t Capacity, typename WaitPolicy = FutexWaitPolicy>
+using SpscChannel = Channel<T, Capacity, Arity::Single, Arity::Single, WaitPolicy>;
\ No newline at end of file
@@ -0,0 +1,154 @@
+#pragma once
+
+//! System includes
+#include <atomic>
+#include <functional>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+//! Threading
+#include <mutex>
+
+//! Channel Interface
+#include "IChannel.h"
+#include "Channel.h"
+
+//! Instrumentation
+#include "Tracing.h"
+
+/*
+    - Exposes a compile time Channel<...> as IChannel<T> , for the ChannelSelector and code written against the interface
+    - owns the channel , the virtual call and the listeners are only paid through the adapter
+    - GetChannel() hands out the underlying channel , for the hot path producers / consumers that know its type
+*/
+
+//! Questions / Edgecases:
+//! Q: Do sends through GetChannel() wake the ChannelSelector ?
+//!     No, listeners are only notified by sends going through the adapter , a channel read by a selector has to be fed through it
+
+template <typename StaticChannel>
+class ChannelAdapter : public IChannel<typename StaticChannel::ValueType>
+{
+public:
+    using T = typename StaticChannel::ValueType;
+
+    ChannelAdapter() = default;
+    ChannelAdapter(const ChannelAdapter &) = delete;
+    ChannelAdapter &operator=(const ChannelAdapter &) = delete;
+
+    virtual bool SendValue(T &&p_tValue) override
+    {
+        return Emplace(std::move(p_tValue));
+    }
+
+    virtual bool SendValue(T &p_tValue) override
+    {
+        if constexpr (std::is_copy_constructible_v<T>)
+        {
+            return Emplace(static_cast<const T &>(p_tValue));
+        }
+        else
+        {
+            throw std::logic_error("Cannot Copy a move only value into a Channel, send it as T&&");
+        }
+    }
+
+    template <typename... Args>
+    bool Emplace(Args &&...p_args)
+    {
+        if (!m_oChannel.Emplace(std::forward<Args>(p_args)...))
+        {
+            return false;
+        }
+        if (m_bHasListeners.load(std::memory_order_acquire))
+        {
+            NotifyOnDataAvailableListeners();
+        }
+        CONCURRENCY_LIB_TRACE("Channel::Send", TracePhase::Instant, reinterpret_cast<unsigned long long>(this));
+        return true;
+    }
+
+    virtual bool ReadValue(T &p_tValue) override
+    {
+        return m_oChannel.ReadValue(p_tValue);
+    }
+
+    virtual bool TryReadValue(T &p_tValue) override
+    {
+        return m_oChannel.TryReadValue(p_tValue);
+    }
+
+    virtual bool ReadValue(std::optional<T> &p_oValue) override
+    {
+        return m_oChannel.ReadValue(p_oValue);
+    }
+
+    virtual bool TryReadValue(std::optional<T> &p_oValue) override
+    {
+        return m_oChannel.TryReadValue(p_oValue);
+    }
+
+    virtual void Close() override
+    {
+        m_oChannel.Close();
+        NotifyOnCloseListeners();
+    }
+
+    StaticChannel &GetChannel()
+    {
+        return m_oChannel;
+    }
+
+protected:
+    virtual unsigned long long RegisterChannelOperationsListener(
+        std::function<void(void)> p_fOnDataAvailableCallback,
+        std::function<void(void)> p_fOnCloseAvailableCallback) override
+    {
+        std::lock_guard<std::mutex> oLock{m_oListenersMutex};
+        unsigned long long iIdToUse = m_iID;
+        m_oOnDataAvailableListeners[iIdToUse] = std::move(p_fOnDataAvailableCallback);
+        m_oOnCloseListeners[iIdToUse] = std::move(p_fOnCloseAvailableCallback);
+        m_iID++;
+        m_bHasListeners.store(true, std::memory_order_release);
+        return iIdToUse;
+    }
+
+    virtual void UnRegisterChannelOperationsListener(int p_iId) override
+    {
+        std::lock_guard<std::mutex> oLock{m_oListenersMutex};
+        m_oOnDataAvailableListeners.erase(p_iId);
+        m_oOnCloseListeners.erase(p_iId);
+        m_bHasListeners.store(!m_oOnDataAvailableListeners.empty(), std::memory_order_release);
+    }
+
+private:
+    void NotifyOnDataAvailableListeners()
+    {
+        std::lock_guard<std::mutex> oLock{m_oListenersMutex};
+        for (auto &entry : m_oOnDataAvailableListeners)
+        {
+            entry.second();
+        }
+    }
+
+    void NotifyOnCloseListeners()
+    {
+        std::lock_guard<std::mutex> oLock{m_oListenersMutex};
+        for (auto &entry : m_oOnCloseListeners)
+        {
+            entry.second();
+        }
+    }
+
+    StaticChannel m_oChannel;
+
+    //! Listeners for Channel operations , producers skip the lock while there is none
+    std::mutex m_oListenersMutex;
+    std::atomic<bool> m_bHasListeners{false};
+    std::map<int, std::function<void(void)>> m_oOnDataAvailableListeners;
+    std::map<int, std::function<void(void)>> m_oOnCloseListeners;
+    unsigned long long m_iID{0};
+};
\ No newline at end of file
@@ -0,0 +1,139 @@
+#pragma once
+
+//! System includes
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <thread>
+
+//! Channel Interface
+#include "Futex.h"
+
+/*
+    - How a Channel<...> waits for data / free space , picked at compile time
+    - a policy instance guards one condition (data available or space available) :
+        WaitUntil(attempt, isClosed) retries attempt till it succeeds (true) or the channel is closed (false)
+        WakeUpOne / WakeUpAll are called after the other side changed the condition
+    - BusySpinWaitPolicy : never gives the core back , lowest latency , only for pinned threads with a core each
+    - YieldWaitPolicy : yields between attempts , never sleeps , wake ups cost nothing
+    - FutexWaitPolicy : spins a little then sleeps on a futex , wakers only enter the kernel when someone sleeps
+*/
+
+//! Questions / Edgecases:
+//! Q: How does FutexWaitPolicy avoid lost wakeups ?
+//!     same protocol as SharedMemoryChannel , a sleeper reads the epoch , announces itself in the waiters count , retries , then sleeps on that epoch
+//!     a waker changed the ring before , checks the waiters count and bumps the epoch , a full fence on both sides so one sees the other
+
+class BusySpinWaitPolicy
+{
+public:
+    template <typename Attempt, typename IsClosed>
+    bool WaitUntil(Attempt &&p_fAttempt, IsClosed &&p_fIsClosed)
+    {
+        while (!p_fIsClosed())
+        {
+            if (p_fAttempt())
+            {
+                return true;
+            }
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+        }
+        return false;
+    }
+
+    void WakeUpOne()
+    {
+    }
+
+    void WakeUpAll()
+    {
+    }
+};
+
+class YieldWaitPolicy
+{
+public:
+    template <typename Attempt, typename IsClosed>
+    bool WaitUntil(Attempt &&p_fAttempt, IsClosed &&p_fIsClosed)
+    {
+        while (!p_fIsClosed())
+        {
+            if (p_fAttempt())
+            {
+                return true;
+            }
+            std::this_thread::yield();
+        }
+        return false;
+    }
+
+    void WakeUpOne()
+    {
+    }
+
+    void WakeUpAll()
+    {
+    }
+};
+
+class FutexWaitPolicy
+{
+public:
+    template <typename Attempt, typename IsClosed>
+    bool WaitUntil(Attempt &&p_fAttempt, IsClosed &&p_fIsClosed)
+    {
+        for (int iSpin = 0; iSpin < s_iSpinsBeforeBlocking; ++iSpin)
+        {
+            if (p_fIsClosed())
+            {
+                return false;
+            }
+            if (p_fAttempt())
+            {
+                return true;
+            }
+            std::this_thread::yield();
+        }
+        while (true)
+        {
+            std::uint32_t uiEpoch = m_uiEpoch.load(std::memory_order_acquire);
+            m_uiWaiters.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            bool bIsClosed = p_fIsClosed();
+            bool bResult = !bIsClosed && p_fAttempt();
+            if (!bIsClosed && !bResult)
+            {
+                FutexWait(&m_uiEpoch, uiEpoch);
+            }
+            m_uiWaiters.fetch_sub(1);
+            if (bIsClosed || bResult)
+            {
+                return bResult;
+            }
+        }
+    }
+
+    void WakeUpOne()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_uiWaiters.load(std::memory_order_relaxed) > 0)
+        {
+            m_uiEpoch.fetch_add(1);
+            FutexWake(&m_uiEpoch, 1);
+        }
+    }
+
+    void WakeUpAll()
+    {
+        m_uiEpoch.fetch_add(1);
+        FutexWake(&m_uiEpoch, INT_MAX);
+    }
+
+private:
+    static constexpr int s_iSpinsBeforeBlocking = 64;
+
+    std::atomic<std::uint32_t> m_uiEpoch{0};
+    std::atomic<std::uint32_t> m_uiWaiters{0};
+};
\ No newline at end of file
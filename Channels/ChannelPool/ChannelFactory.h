@@ -0,0 +1,38 @@
+#pragma once
+
+//! System includes
+#include <memory>
+
+//! Channels
+#include "BufferedChannel.h"
+#include "UnBufferedChannel.h"
+#include "SlabAllocator.h"
+
+/*
+- Creates channels whose memory is recycled through the SlabPool
+    - the channel object and the shared_ptr control block (single block through allocate_shared)
+    - listeners map nodes
+    - BufferedChannel deque chunks
+- Meant for the short lived, per request channels (reply channels, thread pool results ...)
+- Channels returned are normal channels, they can be used as IChannel<T> and added to ChannelSelector
+*/
+class ChannelFactory
+{
+public:
+    template <typename T>
+    using PooledUnBufferedChannel = UnBufferedChannel<T, SlabAllocator<T>>;
+    template <typename T>
+    using PooledBufferedChannel = BufferedChannel<T, SlabAllocator<T>>;
+
+    template <typename T>
+    static std::shared_ptr<PooledUnBufferedChannel<T>> MakeUnBufferedChannel()
+    {
+        return std::allocate_shared<PooledUnBufferedChannel<T>>(SlabAllocator<PooledUnBufferedChannel<T>>{});
+    }
+
+    template <typename T>
+    static std::shared_ptr<PooledBufferedChannel<T>> MakeBufferedChannel(std::size_t p_sChannelMaxSize)
+    {
+        return std::allocate_shared<PooledBufferedChannel<T>>(SlabAllocator<PooledBufferedChannel<T>>{}, p_sChannelMaxSize);
+    }
+};
\ No newline at end of file
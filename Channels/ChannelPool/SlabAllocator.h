@@ -0,0 +1,144 @@
+#pragma once
+
+//! System includes
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+//! Threading
+#include <mutex>
+
+/*
+- Process wide pool of fixed size blocks, grouped by size classes
+- Blocks are carved out of big slabs and handed back to a free list on deallocation, never to the OS
+- Short lived channels (and thier control blocks, map nodes, deque chunks) keep hitting the same few size classes
+  so after warm up allocating / freeing them is just a push / pop on a free list
+- Requests bigger than the biggest size class (or over aligned ones) go to the global allocator as usual
+*/
+class SlabPool
+{
+public:
+    static constexpr std::size_t s_sClassGranularity = 16;
+    static constexpr std::size_t s_sMaxBlockSize = 1024;
+    static constexpr std::size_t s_sSlabSize = 64 * 1024;
+
+    static SlabPool &Instance()
+    {
+        //! Intentionally leaked, blocks may be returned by static objects destroyed after us
+        static SlabPool *s_pInstance = new SlabPool();
+        return *s_pInstance;
+    }
+
+    SlabPool(const SlabPool &) = delete;
+    SlabPool &operator=(const SlabPool &) = delete;
+
+    void *Allocate(std::size_t p_sBytes, std::size_t p_sAlignment)
+    {
+        if (!IsPooled(p_sBytes, p_sAlignment))
+        {
+            return ::operator new(p_sBytes, std::align_val_t{p_sAlignment});
+        }
+        SizeClass &oSizeClass = m_arrSizeClasses[ClassIndex(p_sBytes)];
+        std::lock_guard<std::mutex> oLock{oSizeClass.m_oMutex};
+        if (oSizeClass.m_pFreeList == nullptr)
+        {
+            Refill(oSizeClass, ClassSize(p_sBytes));
+        }
+        FreeBlock *pBlock = oSizeClass.m_pFreeList;
+        oSizeClass.m_pFreeList = pBlock->m_pNext;
+        return pBlock;
+    }
+
+    void Deallocate(void *p_pBlock, std::size_t p_sBytes, std::size_t p_sAlignment)
+    {
+        if (!IsPooled(p_sBytes, p_sAlignment))
+        {
+            ::operator delete(p_pBlock, std::align_val_t{p_sAlignment});
+            return;
+        }
+        SizeClass &oSizeClass = m_arrSizeClasses[ClassIndex(p_sBytes)];
+        std::lock_guard<std::mutex> oLock{oSizeClass.m_oMutex};
+        FreeBlock *pBlock = static_cast<FreeBlock *>(p_pBlock);
+        pBlock->m_pNext = oSizeClass.m_pFreeList;
+        oSizeClass.m_pFreeList = pBlock;
+    }
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock *m_pNext;
+    };
+
+    struct SizeClass
+    {
+        std::mutex m_oMutex;
+        FreeBlock *m_pFreeList{nullptr};
+        std::vector<std::unique_ptr<std::byte[]>> m_vecSlabs;
+    };
+
+    static constexpr std::size_t s_sClassesCount = s_sMaxBlockSize / s_sClassGranularity;
+
+    SlabPool() = default;
+
+    static bool IsPooled(std::size_t p_sBytes, std::size_t p_sAlignment)
+    {
+        return p_sBytes != 0 && p_sBytes <= s_sMaxBlockSize && p_sAlignment <= s_sClassGranularity;
+    }
+    static std::size_t ClassIndex(std::size_t p_sBytes)
+    {
+        return (p_sBytes - 1) / s_sClassGranularity;
+    }
+    static std::size_t ClassSize(std::size_t p_sBytes)
+    {
+        return (ClassIndex(p_sBytes) + 1) * s_sClassGranularity;
+    }
+
+    //! Called while holding the size class lock
+    void Refill(SizeClass &p_oSizeClass, std::size_t p_sBlockSize)
+    {
+        p_oSizeClass.m_vecSlabs.emplace_back(new std::byte[s_sSlabSize]);
+        std::byte *pSlab = p_oSizeClass.m_vecSlabs.back().get();
+        std::size_t sBlocksCount = s_sSlabSize / p_sBlockSize;
+        for (std::size_t sBlock = 0; sBlock < sBlocksCount; ++sBlock)
+        {
+            FreeBlock *pBlock = reinterpret_cast<FreeBlock *>(pSlab + sBlock * p_sBlockSize);
+            pBlock->m_pNext = p_oSizeClass.m_pFreeList;
+            p_oSizeClass.m_pFreeList = pBlock;
+        }
+    }
+
+    std::array<SizeClass, s_sClassesCount> m_arrSizeClasses;
+};
+
+/*
+- Stateless std allocator on top of the SlabPool
+- can be passed as the Allocator parameter of the channels, or to std::allocate_shared
+  to recycle the channel object and its control block too
+*/
+template <typename T>
+class SlabAllocator
+{
+public:
+    using value_type = T;
+
+    SlabAllocator() noexcept = default;
+    template <typename U>
+    SlabAllocator(const SlabAllocator<U> &) noexcept {}
+
+    T *allocate(std::size_t p_sCount)
+    {
+        return static_cast<T *>(SlabPool::Instance().Allocate(p_sCount * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *p_pBlock, std::size_t p_sCount) noexcept
+    {
+        SlabPool::Instance().Deallocate(p_pBlock, p_sCount * sizeof(T), alignof(T));
+    }
+
+    template <typename U>
+    bool operator==(const SlabAllocator<U> &) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const SlabAllocator<U> &) const noexcept { return false; }
+};
\ No newline at end of file
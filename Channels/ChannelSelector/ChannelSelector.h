@@ -1,7 +1,11 @@
 #pragma once
 
 //! System includes
+#include <limits>
 #include <map>
+#include <memory>
+#include <memory_resource>
+#include <optional>
 
 //! Threading
 #include <condition_variable>
@@ -9,12 +13,22 @@
 
 //! Channels
 #include "IChannel.h"
+#include "ReadinessNotifier.h"
+
+//! Tasks
+#include "InplaceTask.h"
+
+//! Instrumentation
+#include "Metrics.h"
+#include "Tracing.h"
 
 /*
     - Support multiple listeners on that same select channel
     - Support multiple diff Select statements at the same time
     - Support readers from one of the member channels directly, not through select statement
     - Support Diff Input channels sources with DIFF DATA TYPESSSSSS
+    - Optionally expose a readiness fd (eventfd, Linux) , so an epoll loop can wait on sockets and channels together
+      then drain with TrySelectAndExecute / Drain instead of blocking in SelectAndExecute
 */
 
 //! Questions / Edgecases:
@@ -30,37 +44,64 @@
 //!     1- if user's code involve heavy computation ? this will block all others for uncesseary time
 //!     2- if user's code recalls some method from channel =>
 //!             Deadlock (OR undefined behaviour according to C++ standard , double locking withing same thread)
+//! Q: Are values copied on their way to the handler ?
+//!     No, they are moved out of the channel into the decorated handler (move only values work too)
+//!     the user callback is shared between decorated handlers (ref counted), not copied per value
+//! Q: lock order:
+//!     producers call HandleChannelInputReady / HandleChannelClose holding the channel listeners lock , then take the selector lock
+//!     so the selector never registers / unregisters on a channel (listeners lock) while holding its own lock , otherwise ABBA deadlock
 
 class ChannelSelector
 {
 public:
+    //! Selector bookkeeping (channels states, handlers) draws its memory from p_pMemoryResource
+    //! every allocation and free into it happens while holding the selector lock, so an unsynchronized resource is fine
+    ChannelSelector(std::pmr::memory_resource *p_pMemoryResource = std::pmr::get_default_resource())
+        : m_oChannelsUnRegisterationHandlers(p_pMemoryResource),
+          m_oChannelsState(p_pMemoryResource),
+          m_oChannelsHandlers(p_pMemoryResource)
+    {
+    }
+
     template <typename T>
     void AddChannel(std::shared_ptr<IChannel<T>> p_pChannel, std::function<void(T &)> &&p_fOnChannelDataAvailable)
     {
-        std::lock_guard<std::mutex> oLock{m_oChannelsStateMutex};
-        unsigned long long ullChanneldId = m_ullChannelId;
-
-        m_oChannelsHandlers[ullChanneldId] = [p_pChannel, p_fOnChannelDataAvailable, ullChanneldId, this](std::function<void(void)> *p_fOutExecutionCallback) -> bool
+        unsigned long long ullChanneldId;
         {
-            return ReadAndDecorateHandler<T>(p_pChannel, p_fOnChannelDataAvailable, ullChanneldId, p_fOutExecutionCallback);
-        };
+            std::lock_guard<std::mutex> oLock{m_oChannelsStateMutex};
+            ullChanneldId = m_ullChannelId++;
+
+            auto pOnChannelDataAvailable = std::make_shared<std::function<void(T &)>>(std::move(p_fOnChannelDataAvailable));
+            m_oChannelsHandlers[ullChanneldId] = [p_pChannel, pOnChannelDataAvailable, ullChanneldId, this](DecoratedHandler *p_fOutExecutionCallback) -> bool
+            {
+                return ReadAndDecorateHandler<T>(p_pChannel, pOnChannelDataAvailable, ullChanneldId, p_fOutExecutionCallback);
+            };
+        }
 
         //! a copy of that pointer is kept, not ref since this will be executed in an async way (in the future)
         //! the HandleChannelInput is what is stored , not user passed callback ,
         //! We want the callback to be as light weight as possible and ALSO we want to execute user code in the consumers context
         //! HandleChannelInput just notifies any waiting threads (cosnumers) , and the user callback is executed in that context
+        //! Registered without holding the selector lock (see Q: lock order above)
         auto onDataAvailableHandler = std::bind(&ChannelSelector::HandleChannelInputReady, this, ullChanneldId);
         auto onChannelCloseHandler = std::bind(&ChannelSelector::HandleChannelClose, this, ullChanneldId);
         unsigned long long ullSelectorId = p_pChannel->RegisterChannelOperationsListener(onDataAvailableHandler, onChannelCloseHandler);
-        m_oChannelsUnRegisterationHandlers[ullChanneldId] = {
-            ullSelectorId,
-            [ullSelectorId, p_pChannel]()
-            { p_pChannel->UnRegisterChannelOperationsListener(ullSelectorId); }};
-        m_ullChannelId++;
+        std::function<void(void)> fUnRegister = [ullSelectorId, p_pChannel]()
+        { p_pChannel->UnRegisterChannelOperationsListener(ullSelectorId); };
+        {
+            std::lock_guard<std::mutex> oLock{m_oChannelsStateMutex};
+            if (!m_bIsTerminated)
+            {
+                m_oChannelsUnRegisterationHandlers[ullChanneldId] = {ullSelectorId, std::move(fUnRegister)};
+                return;
+            }
+        }
+        //! Selector was closed while we were registering
+        fUnRegister();
     }
     bool SelectAndExecute()
     {
-        std::function<void(void)> fChannelHandler;
+        DecoratedHandler fChannelHandler;
         {
             //! Muiltple Threads may be selecting from multiple channels , so this should be thread safe
             std::unique_lock<std::mutex> oLock{m_oChannelsStateMutex};
@@ -73,28 +114,95 @@ public:
             {
                 return false;
             }
-            //! Consume Data
-            bool bIsChannelReady = SelectAndReadFromAvailableChannel(&fChannelHandler);
             //! No channel was ready
-            if (!bIsChannelReady)
+            if (!SelectReadyHandler(&fChannelHandler))
             {
                 return true;
             }
         }
-        //! [IMP]
-        //! Execute user code, without holding lock
-        //! - So Other producers can put data without waiting on use code to finish
-        //! - So if UserCode has loop or Sleep for example we don't need to block other producers from putting data on this channel
-        //! - So we can Avoid Deadlocks if user tries calling other operations that hold that same Lock (double locking from same thread)
-        fChannelHandler();
+        ExecuteHandler(fChannelHandler);
         return true;
     }
+
+    //! Non blocking SelectAndExecute , executes at most one handler
+    //! returns false if nothing was ready (or the selector is closed)
+    bool TrySelectAndExecute()
+    {
+        DecoratedHandler fChannelHandler;
+        {
+            std::lock_guard<std::mutex> oLock{m_oChannelsStateMutex};
+            if (m_bIsTerminated || !AnyChannelReady() || !SelectReadyHandler(&fChannelHandler))
+            {
+                return false;
+            }
+        }
+        ExecuteHandler(fChannelHandler);
+        return true;
+    }
+
+    //! Readable whenever some channel has data (or the selector got closed), created on first call
+    //! an I/O loop adds it to its epoll set (level triggered) and calls Drain when it fires
+    int GetReadinessFd()
+    {
+        std::lock_guard<std::mutex> oLock{m_oChannelsStateMutex};
+        if (!m_pReadinessNotifier)
+        {
+            m_pReadinessNotifier = std::make_unique<ReadinessNotifier>();
+            //! Data that arrived before anyone asked for the fd
+            if (m_bIsTerminated || AnyChannelReady())
+            {
+                m_pReadinessNotifier->Signal();
+            }
+        }
+        return m_pReadinessNotifier->GetFd();
+    }
+
+    //! Clears the readiness fd then executes ready handlers , at most p_sMaxHandlers so one busy channel can't starve the I/O loop
+    //! if some channel is still ready afterwards (limit hit , data sent meanwhile) the fd is signaled again, the next epoll_wait returns right away
+    //! returns the number of handlers executed
+    std::size_t Drain(std::size_t p_sMaxHandlers = std::numeric_limits<std::size_t>::max())
+    {
+        ReadinessNotifier *pReadinessNotifier = GetReadinessNotifier();
+        if (pReadinessNotifier)
+        {
+            pReadinessNotifier->Clear();
+        }
+        std::size_t sHandlersCount = 0;
+        while (sHandlersCount < p_sMaxHandlers && TrySelectAndExecute())
+        {
+            sHandlersCount++;
+        }
+        if (pReadinessNotifier && (sHandlersCount == p_sMaxHandlers || IsAnyChannelReady()))
+        {
+            pReadinessNotifier->Signal();
+        }
+        return sHandlersCount;
+    }
+
+    bool IsClosed()
+    {
+        std::lock_guard<std::mutex> oLock{m_oChannelsStateMutex};
+        return m_bIsTerminated;
+    }
     void Close()
     {
+        UnRegisterationHandlersMap oChannelsUnRegisterationHandlers(m_oChannelsUnRegisterationHandlers.get_allocator());
+        {
+            std::lock_guard<std::mutex> oLock{m_oChannelsStateMutex};
+            m_bIsTerminated = true;
+            m_oChannelReadyCv.notify_all();
+            oChannelsUnRegisterationHandlers.swap(m_oChannelsUnRegisterationHandlers);
+            //! Wake the I/O loop so it notices
+            if (m_pReadinessNotifier)
+            {
+                m_pReadinessNotifier->Signal();
+            }
+        }
+        //! Channels listeners locks are taken without holding the selector lock (see Q: lock order above)
+        UnRegisterFromAllChannels(oChannelsUnRegisterationHandlers);
+        //! The swapped out nodes still belong to the memory resource , free them back under the selector lock
         std::lock_guard<std::mutex> oLock{m_oChannelsStateMutex};
-        m_bIsTerminated = true;
-        m_oChannelReadyCv.notify_all();
-        UnRegisterFromAllChannels();
+        oChannelsUnRegisterationHandlers.clear();
     }
 
     ~ChannelSelector()
@@ -102,22 +210,73 @@ public:
         Close();
     }
 
+    //! All zeros unless built with CONCURRENCY_LIB_METRICS
+    SelectorMetricsSnapshot GetMetricsSnapshot() const
+    {
+        SelectorMetricsSnapshot oSnapshot;
+        CONCURRENCY_LIB_METRICS_ONLY(oSnapshot = m_oMetrics.Snapshot();)
+        return oSnapshot;
+    }
+
 private:
+    //! A read value bound to its user callback , move only so move only values can be captured
+    using DecoratedHandler = InplaceTask<>;
+
+    //! Has to be called holding the selector lock
+    bool SelectReadyHandler(DecoratedHandler *p_fOutDecoratedHandler)
+    {
+        CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oSelects.Add();)
+        CONCURRENCY_LIB_TRACE("Selector::Select", TracePhase::Instant, reinterpret_cast<unsigned long long>(this));
+        //! Consume Data
+        bool bIsChannelReady = SelectAndReadFromAvailableChannel(p_fOutDecoratedHandler);
+        if (!bIsChannelReady)
+        {
+            CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oEmptyWakeups.Add();)
+        }
+        return bIsChannelReady;
+    }
+
+    void ExecuteHandler(DecoratedHandler &p_fChannelHandler)
+    {
+        CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oHandled.Add();)
+        CONCURRENCY_LIB_TRACE("Selector::Handler", TracePhase::Begin, reinterpret_cast<unsigned long long>(this));
+        //! [IMP]
+        //! Execute user code, without holding lock
+        //! - So Other producers can put data without waiting on use code to finish
+        //! - So if UserCode has loop or Sleep for example we don't need to block other producers from putting data on this channel
+        //! - So we can Avoid Deadlocks if user tries calling other operations that hold that same Lock (double locking from same thread)
+        p_fChannelHandler();
+        CONCURRENCY_LIB_TRACE("Selector::Handler", TracePhase::End, reinterpret_cast<unsigned long long>(this));
+    }
+
+    bool IsAnyChannelReady()
+    {
+        std::lock_guard<std::mutex> oLock{m_oChannelsStateMutex};
+        return AnyChannelReady();
+    }
+
+    ReadinessNotifier *GetReadinessNotifier()
+    {
+        std::lock_guard<std::mutex> oLock{m_oChannelsStateMutex};
+        return m_pReadinessNotifier.get();
+    }
+
     template <typename T>
-    bool ReadAndDecorateHandler(std::shared_ptr<IChannel<T>> p_pChannel, std::function<void(T &)> p_fOnChannelDataAvailable, unsigned long long p_ullChanneldId, std::function<void(void)> *p_fOutDecoratedHandler)
+    bool ReadAndDecorateHandler(const std::shared_ptr<IChannel<T>> &p_pChannel, const std::shared_ptr<std::function<void(T &)>> &p_pOnChannelDataAvailable, unsigned long long p_ullChanneldId, DecoratedHandler *p_fOutDecoratedHandler)
     {
         /*
         - Try Read value from the channel if availble
         - Created a callback with Read value passed as closure to be able to use it in a templated fashion and have type knowledge
         */
-        T tVal;
-        bool bResult = p_pChannel->TryReadValue(tVal);
+        //! optional , T doesn't have to be default constructible
+        std::optional<T> oValue;
+        bool bResult = p_pChannel->TryReadValue(oValue);
         if (bResult)
         {
-            //! C++ is stupid BTW
-            *p_fOutDecoratedHandler = [p_fOnChannelDataAvailable, tVal]() mutable
+            //! The value is moved into the handler, the user callback is shared (the channel may be removed before the handler runs)
+            *p_fOutDecoratedHandler = [p_pOnChannelDataAvailable, tVal = std::move(*oValue)]() mutable
             {
-                p_fOnChannelDataAvailable(tVal);
+                (*p_pOnChannelDataAvailable)(tVal);
             };
         }
         //! If No data available for that channel , then it must have been consumed by other threads in the mean time
@@ -128,7 +287,7 @@ private:
         }
         return bResult;
     }
-    bool SelectAndReadFromAvailableChannel(std::function<void(void)> *p_fOutDecoratedHandler)
+    bool SelectAndReadFromAvailableChannel(DecoratedHandler *p_fOutDecoratedHandler)
     {
         for (auto &channelEntry : m_oChannelsState)
         {
@@ -137,9 +296,13 @@ private:
                 continue;
             }
             auto handlerIt = m_oChannelsHandlers.find(channelEntry.first);
-            bool readSuccess = handlerIt->second(p_fOutDecoratedHandler);
-            channelEntry.second--;
-            return readSuccess;
+            //! a failed read (stale count , consumed through the channel directly) already reset the state to 0
+            //! decrementing it would wrap around and spin forever , try the next ready channel instead
+            if (handlerIt->second(p_fOutDecoratedHandler))
+            {
+                channelEntry.second--;
+                return true;
+            }
         }
         return false;
     }
@@ -164,13 +327,22 @@ private:
     */
     void HandleChannelInputReady(unsigned long long p_ullChannelId)
     {
-        //! as light weight as possible, to prevent blocking Producers that produced message
-        std::lock_guard<std::mutex>
-            oLock{m_oChannelsStateMutex};
-        //! mark which channel was mark ready for faster checking
-        m_oChannelsState[p_ullChannelId]++;
-        //! Announce that some channel is ready
-        m_oChannelReadyCv.notify_one();
+        ReadinessNotifier *pReadinessNotifier;
+        {
+            //! as light weight as possible, to prevent blocking Producers that produced message
+            std::lock_guard<std::mutex>
+                oLock{m_oChannelsStateMutex};
+            //! mark which channel was mark ready for faster checking
+            m_oChannelsState[p_ullChannelId]++;
+            //! Announce that some channel is ready
+            m_oChannelReadyCv.notify_one();
+            pReadinessNotifier = m_pReadinessNotifier.get();
+        }
+        //! Coalesced , a burst of messages costs one eventfd write (outside the lock)
+        if (pReadinessNotifier)
+        {
+            pReadinessNotifier->Signal();
+        }
     }
     void HandleChannelClose(unsigned long long p_ullChanneldId)
     {
@@ -179,10 +351,11 @@ private:
         m_oChannelsState.erase(p_ullChanneldId);
     }
 
-    void UnRegisterFromAllChannels()
-    {
+    using UnRegisterationHandlersMap = std::pmr::map<unsigned long long, std::pair<unsigned long long, std::function<void(void)>>>;
 
-        for (auto &channelUnRegisterationHandlerEntry : m_oChannelsUnRegisterationHandlers)
+    static void UnRegisterFromAllChannels(UnRegisterationHandlersMap &p_oChannelsUnRegisterationHandlers)
+    {
+        for (auto &channelUnRegisterationHandlerEntry : p_oChannelsUnRegisterationHandlers)
         {
             channelUnRegisterationHandlerEntry.second.second();
         }
@@ -196,9 +369,14 @@ private:
     std::mutex m_oChannelsStateMutex;
     std::condition_variable m_oChannelReadyCv;
     unsigned long long m_ullChannelId = 0;
-    std::map<unsigned long long, std::pair<unsigned long long, std::function<void(void)>>> m_oChannelsUnRegisterationHandlers;
-    std::map<unsigned long long, unsigned long long> m_oChannelsState;
-    std::map<unsigned long long, std::function<bool(std::function<void(void)> *)>> m_oChannelsHandlers;
+    UnRegisterationHandlersMap m_oChannelsUnRegisterationHandlers;
+    std::pmr::map<unsigned long long, unsigned long long> m_oChannelsState;
+    std::pmr::map<unsigned long long, std::function<bool(DecoratedHandler *)>> m_oChannelsHandlers;
 
     bool m_bIsTerminated{false};
+
+    //! Only created if someone asked for the readiness fd , never destroyed before the selector
+    std::unique_ptr<ReadinessNotifier> m_pReadinessNotifier;
+
+    CONCURRENCY_LIB_METRICS_ONLY(SelectorMetrics m_oMetrics;)
 };
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+
+//! System includes
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <cstring>
+
+#if defined(__linux__)
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+/*
+    - eventfd that becomes readable when something is ready , so it can sit in an epoll / poll set next to sockets
+    - writes are coalesced : only the first Signal after a Clear reaches the kernel , a burst of messages is one syscall
+    - Linux only , constructing it elsewhere throws
+*/
+
+//! Questions / Edgecases:
+//! Q: Can a wakeup be lost between Clear and Signal ?
+//!     no , Clear empties the counter first and only then clears the flag , the caller drains after Clear
+//!     a Signal landing before the flag is cleared skips its write , but its data was published before it , so that drain sees it
+//!     a Signal landing after finds the flag cleared and writes the fd again
+//!     (clearing the flag first would let the read eat that write while the flag stays set , no Signal would ever write again)
+//! Q: Why non blocking ?
+//!     Clear reads whatever is there, an empty counter must not block the I/O loop thread
+
+class ReadinessNotifier
+{
+public:
+    ReadinessNotifier()
+    {
+#if defined(__linux__)
+        m_iFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (m_iFd < 0)
+        {
+            throw std::runtime_error(std::string("eventfd failed: ") + std::strerror(errno));
+        }
+#else
+        throw std::logic_error("ReadinessNotifier needs eventfd (Linux)");
+#endif
+    }
+
+    ReadinessNotifier(const ReadinessNotifier &) = delete;
+    ReadinessNotifier &operator=(const ReadinessNotifier &) = delete;
+
+    ~ReadinessNotifier()
+    {
+#if defined(__linux__)
+        close(m_iFd);
+#endif
+    }
+
+    int GetFd() const
+    {
+        return m_iFd;
+    }
+
+    //! Producers side , cheap when already signaled (one atomic exchange , no syscall)
+    void Signal()
+    {
+        if (m_bIsSignaled.exchange(true, std::memory_order_acq_rel))
+        {
+            return;
+        }
+#if defined(__linux__)
+        std::uint64_t ullOne = 1;
+        //! only fails on counter overflow, which one pending write never reaches
+        [[maybe_unused]] ssize_t sWritten = write(m_iFd, &ullOne, sizeof(ullOne));
+#endif
+    }
+
+    //! Consumer side , call before draining whatever the fd announced (counter first , then the flag , see Q above)
+    void Clear()
+    {
+#if defined(__linux__)
+        std::uint64_t ullCounter;
+        [[maybe_unused]] ssize_t sRead = read(m_iFd, &ullCounter, sizeof(ullCounter));
+#endif
+        m_bIsSignaled.store(false, std::memory_order_seq_cst);
+    }
+
+private:
+    int m_iFd{-1};
+    std::atomic<bool> m_bIsSignaled{false};
+};
\ No newline at end of file
@@ -0,0 +1,367 @@
+#pragma once
+
+//! System includes
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+//! Threading
+#include <mutex>
+#include <thread>
+
+//! Channel Interface
+#include "IChannel.h"
+#include "Futex.h"
+
+//! Instrumentation
+#include "Tracing.h"
+
+/*
+    - Small footprint channels for the one channel per request / per task cases (thread pool results , async io replies ..)
+    - the whole state is one 32 bits atomic word (slot state + closed + sleepers) next to the inline value , waits are futex waits on that word
+    - listeners (ChannelSelector) live out of line , allocated on the first registration only
+    - CompactChannel<T> : same semantics as UnBufferedChannel , one slot , a Send waits while the slot is full , a Read while it is empty
+    - OneShotChannel<T> : a single value ever , the Send never blocks , a second Send fails , once the value is read every Read fails
+    - vtable pointer + state word + listeners pointer + T , 24 bytes for an int (UnBufferedChannel is several hundred)
+*/
+
+//! Questions / Edgecases:
+//! Q: How are lost wakeups avoided ?
+//!     a waiter sets the sleepers bit with a CAS then sleeps on the exact word value it wrote , any change of the word makes the futex wait return
+//!     whoever finishes a Send / Read / Close clears the sleepers bit in the same CAS and wakes everyone sleeping on the word if it was set
+//! Q: Why wake every sleeper ?
+//!     readers and writers share the one word , these channels mostly have one reader and one writer , so it is rarely more than one thread
+//! Q: No metrics ?
+//!     a ChannelMetrics would be bigger than the channel itself , use UnBufferedChannel when they are needed
+
+template <typename T, bool IsOneShot = false>
+class CompactChannel : public IChannel<T>
+{
+public:
+    CompactChannel() = default;
+    CompactChannel(const CompactChannel &) = delete;
+    CompactChannel &operator=(const CompactChannel &) = delete;
+
+    ~CompactChannel()
+    {
+        if ((m_uiState.load(std::memory_order_acquire) & s_uiSlotMask) == s_uiFull)
+        {
+            Value()->~T();
+        }
+        delete m_pListeners.load(std::memory_order_acquire);
+    }
+
+    //! Blocks while the slot is full (CompactChannel) , fails if a value was already sent (OneShotChannel)
+    virtual bool SendValue(T &&p_tValue) override
+    {
+        return Emplace(std::move(p_tValue));
+    }
+
+    virtual bool SendValue(T &p_tValue) override
+    {
+        if constexpr (std::is_copy_constructible_v<T>)
+        {
+            return Emplace(static_cast<const T &>(p_tValue));
+        }
+        else
+        {
+            throw std::logic_error("Cannot Copy a move only value into a CompactChannel, send it as T&&");
+        }
+    }
+
+    //! Same as SendValue , but the value is constructed from p_args right in the slot
+    //! if T's constructor throws the exception propagates and the slot is left empty (a one shot channel can still be sent)
+    template <typename... Args>
+    bool Emplace(Args &&...p_args)
+    {
+        //! Claim the empty slot
+        int iSpins = 0;
+        std::uint32_t uiState = m_uiState.load(std::memory_order_acquire);
+        std::uint32_t uiPreviousUsed = 0;
+        while (true)
+        {
+            if ((uiState & s_uiClosed) != 0 || (IsOneShot && (uiState & s_uiUsed) != 0))
+            {
+                return false;
+            }
+            if ((uiState & s_uiSlotMask) == s_uiEmpty)
+            {
+                uiPreviousUsed = uiState & s_uiUsed;
+                if (m_uiState.compare_exchange_weak(uiState, (uiState & ~s_uiSlotMask) | s_uiWriting | s_uiUsed, std::memory_order_acquire))
+                {
+                    break;
+                }
+                continue;
+            }
+            Wait(uiState, iSpins);
+            uiState = m_uiState.load(std::memory_order_acquire);
+        }
+
+        try
+        {
+            new (m_arrStorage) T(std::forward<Args>(p_args)...);
+        }
+        catch (...)
+        {
+            //! Give the slot back as it was (a one shot can still be sent) , waiters sleeping on Writing are woken
+            uiState = m_uiState.load(std::memory_order_relaxed);
+            while (!Transition(uiState, (uiState & ~(s_uiSlotMask | s_uiUsed)) | s_uiEmpty | uiPreviousUsed))
+            {
+            }
+            throw;
+        }
+
+        //! Publish it , unless the channel got closed meanwhile
+        uiState = m_uiState.load(std::memory_order_relaxed);
+        while (true)
+        {
+            if ((uiState & s_uiClosed) != 0)
+            {
+                Value()->~T();
+                while (!Transition(uiState, (uiState & ~s_uiSlotMask) | s_uiEmpty))
+                {
+                }
+                return false;
+            }
+            if (Transition(uiState, (uiState & ~s_uiSlotMask) | s_uiFull))
+            {
+                break;
+            }
+        }
+
+        NotifyOnDataAvailableListeners();
+        CONCURRENCY_LIB_TRACE("Channel::Send", TracePhase::Instant, reinterpret_cast<unsigned long long>(this));
+        return true;
+    }
+
+    virtual bool ReadValue(T &p_tValue) override
+    {
+        constexpr bool bIsBlocking = true;
+        return Read(p_tValue, bIsBlocking);
+    }
+
+    virtual bool TryReadValue(T &p_tValue) override
+    {
+        constexpr bool bIsBlocking = false;
+        return Read(p_tValue, bIsBlocking);
+    }
+
+    virtual bool ReadValue(std::optional<T> &p_oValue) override
+    {
+        constexpr bool bIsBlocking = true;
+        return Read(p_oValue, bIsBlocking);
+    }
+
+    virtual bool TryReadValue(std::optional<T> &p_oValue) override
+    {
+        constexpr bool bIsBlocking = false;
+        return Read(p_oValue, bIsBlocking);
+    }
+
+    //! Wakes every waiter , Send / Read fail from now on , a value still in the slot is dropped
+    virtual void Close() override
+    {
+        std::uint32_t uiState = m_uiState.load(std::memory_order_relaxed);
+        while (!Transition(uiState, uiState | s_uiClosed))
+        {
+        }
+        NotifyOnCloseListeners();
+    }
+
+protected:
+    virtual unsigned long long RegisterChannelOperationsListener(
+        std::function<void(void)> p_fOnDataAvailableCallback,
+        std::function<void(void)> p_fOnCloseAvailableCallback) override
+    {
+        Listeners *pListeners = GetOrCreateListeners();
+        std::lock_guard<std::mutex> oLock{pListeners->m_oMutex};
+        unsigned long long iIdToUse = pListeners->m_iID;
+        pListeners->m_oOnDataAvailable[iIdToUse] = std::move(p_fOnDataAvailableCallback);
+        pListeners->m_oOnClose[iIdToUse] = std::move(p_fOnCloseAvailableCallback);
+        pListeners->m_iID++;
+        return iIdToUse;
+    }
+
+    virtual void UnRegisterChannelOperationsListener(int p_iId) override
+    {
+        Listeners *pListeners = m_pListeners.load(std::memory_order_acquire);
+        if (pListeners == nullptr)
+        {
+            return;
+        }
+        std::lock_guard<std::mutex> oLock{pListeners->m_oMutex};
+        pListeners->m_oOnDataAvailable.erase(p_iId);
+        pListeners->m_oOnClose.erase(p_iId);
+    }
+
+private:
+    //! State word layout
+    static constexpr std::uint32_t s_uiSlotMask = 0x3;
+    static constexpr std::uint32_t s_uiEmpty = 0x0;
+    static constexpr std::uint32_t s_uiWriting = 0x1;
+    static constexpr std::uint32_t s_uiFull = 0x2;
+    static constexpr std::uint32_t s_uiReading = 0x3;
+    static constexpr std::uint32_t s_uiClosed = 0x4;
+    static constexpr std::uint32_t s_uiSleepers = 0x8;
+    //! A value was sent once , only checked by OneShotChannel
+    static constexpr std::uint32_t s_uiUsed = 0x10;
+    static constexpr int s_iSpinsBeforeBlocking = 64;
+
+    struct Listeners
+    {
+        std::mutex m_oMutex;
+        std::map<int, std::function<void(void)>> m_oOnDataAvailable;
+        std::map<int, std::function<void(void)>> m_oOnClose;
+        unsigned long long m_iID{0};
+    };
+
+    T *Value()
+    {
+        return std::launder(reinterpret_cast<T *>(m_arrStorage));
+    }
+
+    template <typename Output>
+    bool Read(Output &p_oOutput, bool p_bIsBlocking)
+    {
+        //! Claim the full slot
+        int iSpins = 0;
+        std::uint32_t uiState = m_uiState.load(std::memory_order_acquire);
+        while (true)
+        {
+            if ((uiState & s_uiClosed) != 0)
+            {
+                return false;
+            }
+            if ((uiState & s_uiSlotMask) == s_uiFull)
+            {
+                if (m_uiState.compare_exchange_weak(uiState, (uiState & ~s_uiSlotMask) | s_uiReading, std::memory_order_acquire))
+                {
+                    break;
+                }
+                continue;
+            }
+            //! The one value was already read
+            if (!p_bIsBlocking || (IsOneShot && (uiState & s_uiSlotMask) == s_uiEmpty && (uiState & s_uiUsed) != 0))
+            {
+                return false;
+            }
+            Wait(uiState, iSpins);
+            uiState = m_uiState.load(std::memory_order_acquire);
+        }
+
+        MoveValueOut(p_oOutput);
+        Value()->~T();
+
+        //! Free the slot , closed or not the value is out
+        uiState = m_uiState.load(std::memory_order_relaxed);
+        while (!Transition(uiState, (uiState & ~s_uiSlotMask) | s_uiEmpty))
+        {
+        }
+        return true;
+    }
+
+    void MoveValueOut(T &p_tValue)
+    {
+        p_tValue = std::move(*Value());
+    }
+
+    void MoveValueOut(std::optional<T> &p_oValue)
+    {
+        p_oValue.emplace(std::move(*Value()));
+    }
+
+    //! CAS p_uiExpected -> p_uiDesired , clears the sleepers bit and wakes them if it was set
+    bool Transition(std::uint32_t &p_uiExpected, std::uint32_t p_uiDesired)
+    {
+        if (!m_uiState.compare_exchange_weak(p_uiExpected, p_uiDesired & ~s_uiSleepers, std::memory_order_acq_rel, std::memory_order_relaxed))
+        {
+            return false;
+        }
+        if ((p_uiExpected & s_uiSleepers) != 0)
+        {
+            FutexWake(&m_uiState, INT_MAX);
+        }
+        return true;
+    }
+
+    //! Yields a little , then announces itself in the word and sleeps till the word changes
+    void Wait(std::uint32_t p_uiState, int &p_iSpins)
+    {
+        if (p_iSpins < s_iSpinsBeforeBlocking)
+        {
+            p_iSpins++;
+            std::this_thread::yield();
+            return;
+        }
+        if ((p_uiState & s_uiSleepers) == 0 &&
+            !m_uiState.compare_exchange_strong(p_uiState, p_uiState | s_uiSleepers, std::memory_order_relaxed))
+        {
+            //! Word changed , caller rechecks
+            return;
+        }
+        FutexWait(&m_uiState, p_uiState | s_uiSleepers);
+    }
+
+    Listeners *GetOrCreateListeners()
+    {
+        Listeners *pListeners = m_pListeners.load(std::memory_order_acquire);
+        if (pListeners != nullptr)
+        {
+            return pListeners;
+        }
+        Listeners *pNewListeners = new Listeners();
+        if (!m_pListeners.compare_exchange_strong(pListeners, pNewListeners, std::memory_order_acq_rel))
+        {
+            //! Another thread registered first
+            delete pNewListeners;
+            return pListeners;
+        }
+        return pNewListeners;
+    }
+
+    void NotifyOnDataAvailableListeners()
+    {
+        Listeners *pListeners = m_pListeners.load(std::memory_order_acquire);
+        if (pListeners == nullptr)
+        {
+            return;
+        }
+        std::lock_guard<std::mutex> oLock{pListeners->m_oMutex};
+        for (auto &entry : pListeners->m_oOnDataAvailable)
+        {
+            entry.second();
+        }
+    }
+
+    void NotifyOnCloseListeners()
+    {
+        Listeners *pListeners = m_pListeners.load(std::memory_order_acquire);
+        if (pListeners == nullptr)
+        {
+            return;
+        }
+        std::lock_guard<std::mutex> oLock{pListeners->m_oMutex};
+        for (auto &entry : pListeners->m_oOnClose)
+        {
+            entry.second();
+        }
+    }
+
+    std::atomic<std::uint32_t> m_uiState{s_uiEmpty};
+    alignas(T) unsigned char m_arrStorage[sizeof(T)];
+    std::atomic<Listeners *> m_pListeners{nullptr};
+};
+
+//! Single use reply channel (one value , one reader) , the thread pool hands one out per task
+template <typename T>
+using OneShotChannel = CompactChannel<T, true>;
+
+static_assert(sizeof(CompactChannel<long long>) <= 64 && sizeof(OneShotChannel<long long>) <= 64,
+              "compact channels have to fit in a cache line for small values");
\ No newline at end of file
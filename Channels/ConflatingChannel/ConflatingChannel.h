@@ -0,0 +1,289 @@
+#pragma once
+
+//! System includes
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+
+//! Threading
+#include <mutex>
+
+//! Channel Interface
+#include "IChannel.h"
+#include "Futex.h"
+
+//! Instrumentation
+#include "Metrics.h"
+#include "Tracing.h"
+
+/*
+    - Latest value channel (prices , states ..) : a Send overwrites the pending value , a Read gets the newest one
+    - a slow reader skips stale updates instead of working through a backlog , producers never block on it
+    - The pending value is a pointer swapped atomically , producers never take a lock (unless a selector listens on the channel)
+    - One spare value is kept around , so a steady producer / reader pair reuses two allocations back and forth
+    - Readers sleep on a futex , woken only if one actually sleeps
+    - Works as a ChannelSelector source
+*/
+
+//! Questions / Edgecases:
+//! Q: What happens to an overwritten value ?
+//!     it is dropped (recycled as the spare) , it is never delivered
+//! Q: Multiple readers ?
+//!     each pending value is delivered to exactly one of them
+//! Q: Close ?
+//!     same as BufferedChannel , Send / Read fail once closed , a pending value is dropped
+//! Q: Want one latest value per instrument / entity ?
+//!     see KeyedConflatingChannel
+
+template <typename T>
+class ConflatingChannel : public IChannel<T>
+{
+public:
+    ConflatingChannel() = default;
+    ConflatingChannel(const ConflatingChannel &) = delete;
+    ConflatingChannel &operator=(const ConflatingChannel &) = delete;
+
+    ~ConflatingChannel()
+    {
+        Close();
+        delete m_pPending.exchange(nullptr);
+        delete m_pSpare.exchange(nullptr);
+    }
+
+    virtual bool SendValue(T &&p_tValue) override
+    {
+        return Emplace(std::move(p_tValue));
+    }
+
+    virtual bool SendValue(T &p_tValue) override
+    {
+        if constexpr (std::is_copy_constructible_v<T>)
+        {
+            return Emplace(static_cast<const T &>(p_tValue));
+        }
+        else
+        {
+            throw std::logic_error("Cannot Copy a move only value into a ConflatingChannel, send it as T&&");
+        }
+    }
+
+    //! Never blocks , replaces whatever value is still pending
+    template <typename... Args>
+    bool Emplace(Args &&...p_args)
+    {
+        if (m_bIsTerminated.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        T *pStale = m_pPending.exchange(MakeValue(std::forward<Args>(p_args)...), std::memory_order_acq_rel);
+        if (pStale != nullptr)
+        {
+            Recycle(pStale);
+        }
+        CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oEnqueued.Add();)
+        WakeUpReader();
+        if (m_bHasListeners.load(std::memory_order_acquire))
+        {
+            NotifyOnDataAvailableListeners();
+        }
+        CONCURRENCY_LIB_TRACE("Channel::Send", TracePhase::Instant, reinterpret_cast<unsigned long long>(this));
+        return true;
+    }
+
+    virtual bool ReadValue(T &p_tValue) override
+    {
+        constexpr bool bIsBlocking = true;
+        return Read(p_tValue, bIsBlocking);
+    }
+
+    virtual bool TryReadValue(T &p_tValue) override
+    {
+        constexpr bool bIsBlocking = false;
+        return Read(p_tValue, bIsBlocking);
+    }
+
+    virtual bool ReadValue(std::optional<T> &p_oValue) override
+    {
+        constexpr bool bIsBlocking = true;
+        return Read(p_oValue, bIsBlocking);
+    }
+
+    virtual bool TryReadValue(std::optional<T> &p_oValue) override
+    {
+        constexpr bool bIsBlocking = false;
+        return Read(p_oValue, bIsBlocking);
+    }
+
+    virtual void Close() override
+    {
+        m_bIsTerminated.store(true);
+        m_uiReadersEpoch.fetch_add(1);
+        FutexWake(&m_uiReadersEpoch, INT_MAX);
+        NotifyOnCloseListeners();
+    }
+
+    //! All zeros unless built with CONCURRENCY_LIB_METRICS
+    ChannelMetricsSnapshot GetMetricsSnapshot() const
+    {
+        ChannelMetricsSnapshot oSnapshot;
+        CONCURRENCY_LIB_METRICS_ONLY(oSnapshot = m_oMetrics.Snapshot();)
+        return oSnapshot;
+    }
+
+protected:
+    virtual unsigned long long RegisterChannelOperationsListener(
+        std::function<void(void)> p_fOnDataAvailableCallback,
+        std::function<void(void)> p_fOnCloseAvailableCallback) override
+    {
+        std::lock_guard<std::mutex> oLock{m_oListenersMutex};
+        unsigned long long iIdToUse = m_iID;
+        m_oOnDataAvailableListeners[iIdToUse] = std::move(p_fOnDataAvailableCallback);
+        m_oOnCloseListeners[iIdToUse] = std::move(p_fOnCloseAvailableCallback);
+        m_iID++;
+        m_bHasListeners.store(true, std::memory_order_release);
+        return iIdToUse;
+    }
+
+    virtual void UnRegisterChannelOperationsListener(int p_iId) override
+    {
+        //! Producers may be iterating the listeners (Notify*) at the same time
+        //! holding the lock also guarantees that once we return , the removed listener is not being executed anymore
+        std::lock_guard<std::mutex> oLock{m_oListenersMutex};
+        m_oOnDataAvailableListeners.erase(p_iId);
+        m_oOnCloseListeners.erase(p_iId);
+        m_bHasListeners.store(!m_oOnDataAvailableListeners.empty(), std::memory_order_release);
+    }
+
+private:
+    //! Reuses the spare value if there is one , if T's constructor throws the spare is kept for the next call
+    template <typename... Args>
+    T *MakeValue(Args &&...p_args)
+    {
+        T *pSpare = m_pSpare.exchange(nullptr, std::memory_order_acquire);
+        if (pSpare != nullptr)
+        {
+            if constexpr (std::is_move_assignable_v<T>)
+            {
+                try
+                {
+                    *pSpare = T(std::forward<Args>(p_args)...);
+                }
+                catch (...)
+                {
+                    //! A throwing constructor / assignment must not leak the spare
+                    Recycle(pSpare);
+                    throw;
+                }
+                return pSpare;
+            }
+            delete pSpare;
+        }
+        return new T(std::forward<Args>(p_args)...);
+    }
+
+    //! Keep it as the spare , unless there is one already
+    void Recycle(T *p_pValue)
+    {
+        T *pExpected = nullptr;
+        if (!m_pSpare.compare_exchange_strong(pExpected, p_pValue, std::memory_order_release, std::memory_order_relaxed))
+        {
+            delete p_pValue;
+        }
+    }
+
+    //! p_oOutput is either a T& or an std::optional<T>&
+    template <typename Output>
+    bool Read(Output &p_oOutput, bool p_bIsBlocking)
+    {
+        while (true)
+        {
+            if (m_bIsTerminated.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+            T *pValue = m_pPending.exchange(nullptr, std::memory_order_acq_rel);
+            if (pValue != nullptr)
+            {
+                MoveValueOut(p_oOutput, *pValue);
+                Recycle(pValue);
+                CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oDequeued.Add();)
+                CONCURRENCY_LIB_TRACE("Channel::Receive", TracePhase::Instant, reinterpret_cast<unsigned long long>(this));
+                return true;
+            }
+            if (!p_bIsBlocking)
+            {
+                return false;
+            }
+            //! Announce ourselves , check again , then sleep on the epoch we read before checking
+            std::uint32_t uiEpoch = m_uiReadersEpoch.load(std::memory_order_acquire);
+            m_uiSleepingReaders.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (m_pPending.load(std::memory_order_acquire) == nullptr && !m_bIsTerminated.load(std::memory_order_acquire))
+            {
+                CONCURRENCY_LIB_METRICS_ONLY(MetricsClock::time_point oStart = MetricsClock::now();)
+                FutexWait(&m_uiReadersEpoch, uiEpoch);
+                CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oReceiveBlockTime.Record(MetricsElapsedNanoseconds(oStart));)
+            }
+            m_uiSleepingReaders.fetch_sub(1);
+        }
+    }
+
+    void WakeUpReader()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_uiSleepingReaders.load(std::memory_order_relaxed) > 0)
+        {
+            m_uiReadersEpoch.fetch_add(1);
+            FutexWake(&m_uiReadersEpoch, 1);
+        }
+    }
+
+    static void MoveValueOut(T &p_tValue, T &p_tSource)
+    {
+        p_tValue = std::move(p_tSource);
+    }
+
+    static void MoveValueOut(std::optional<T> &p_oValue, T &p_tSource)
+    {
+        p_oValue.emplace(std::move(p_tSource));
+    }
+
+    void NotifyOnDataAvailableListeners()
+    {
+        std::lock_guard<std::mutex> oLock{m_oListenersMutex};
+        for (auto &entry : m_oOnDataAvailableListeners)
+        {
+            entry.second();
+        }
+    }
+    void NotifyOnCloseListeners()
+    {
+        std::lock_guard<std::mutex> oLock{m_oListenersMutex};
+        for (auto &entry : m_oOnCloseListeners)
+        {
+            entry.second();
+        }
+    }
+
+    std::atomic<T *> m_pPending{nullptr};
+    std::atomic<T *> m_pSpare{nullptr};
+    std::atomic<bool> m_bIsTerminated{false};
+
+    //! Futex word readers sleep on , bumped only when someone sleeps
+    std::atomic<std::uint32_t> m_uiReadersEpoch{0};
+    std::atomic<std::uint32_t> m_uiSleepingReaders{0};
+
+    //! Listeners for Channel operations , producers skip the lock while there is none
+    std::mutex m_oListenersMutex;
+    std::atomic<bool> m_bHasListeners{false};
+    std::map<int, std::function<void(void)>> m_oOnDataAvailableListeners;
+    std::map<int, std::function<void(void)>> m_oOnCloseListeners;
+    unsigned long long m_iID{0};
+
+    CONCURRENCY_LIB_METRICS_ONLY(ChannelMetrics m_oMetrics;)
+};
\ No newline at end of file
@@ -0,0 +1,249 @@
+#pragma once
+
+//! System includes
+#include <deque>
+#include <functional>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+//! Threading
+#include <mutex>
+#include <condition_variable>
+
+//! Channel Interface
+#include "IChannel.h"
+
+//! Instrumentation
+#include "Metrics.h"
+#include "Tracing.h"
+
+/*
+    - ConflatingChannel with one slot per key : values are (key , value) pairs , a Send overwrites the pending value of its key only
+    - Readers get every key that changed , once , with its latest value , keys in the order they first became pending
+    - Producers never wait for readers (short lock to overwrite the slot) , there is never more than one pending value per key
+    - Works as a ChannelSelector source (IChannel<std::pair<Key, T>>)
+*/
+
+//! Questions / Edgecases:
+//! Q: Can a busy key starve the others ?
+//!     No, overwriting a pending key keeps its place in line , it is not pushed back
+//! Q: Close ?
+//!     same as BufferedChannel , Send / Read fail once closed , pending values are dropped
+
+template <typename Key, typename T, typename Hash = std::hash<Key>>
+class KeyedConflatingChannel : public IChannel<std::pair<Key, T>>
+{
+public:
+    using Entry = std::pair<Key, T>;
+
+    KeyedConflatingChannel() = default;
+
+    ~KeyedConflatingChannel()
+    {
+        Close();
+    }
+
+    virtual bool SendValue(Entry &&p_oEntry) override
+    {
+        return Emplace(std::move(p_oEntry.first), std::move(p_oEntry.second));
+    }
+
+    virtual bool SendValue(Entry &p_oEntry) override
+    {
+        if constexpr (std::is_copy_constructible_v<Entry>)
+        {
+            return Emplace(static_cast<const Key &>(p_oEntry.first), static_cast<const T &>(p_oEntry.second));
+        }
+        else
+        {
+            throw std::logic_error("Cannot Copy a move only value into a KeyedConflatingChannel, send it as T&&");
+        }
+    }
+
+    //! Never blocks , replaces the pending value of p_oKey if there is one
+    template <typename KeyArg, typename... Args>
+    bool Emplace(KeyArg &&p_oKey, Args &&...p_args)
+    {
+        {
+            std::lock_guard<std::mutex> oLock{m_oMutex};
+            if (m_bIsTerminated)
+            {
+                return false;
+            }
+            auto it = m_oPending.find(p_oKey);
+            if (it != m_oPending.end())
+            {
+                //! Conflate , keeps its place in line
+                it->second = T(std::forward<Args>(p_args)...);
+            }
+            else
+            {
+                it = m_oPending.emplace(std::piecewise_construct, std::forward_as_tuple(std::forward<KeyArg>(p_oKey)), std::forward_as_tuple(std::forward<Args>(p_args)...)).first;
+                try
+                {
+                    m_oOrder.push_back(it->first);
+                }
+                catch (...)
+                {
+                    //! Don't leave a pending key that no reader will ever reach
+                    m_oPending.erase(it);
+                    throw;
+                }
+                CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oHighWaterMark.Update(m_oOrder.size());)
+            }
+            CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oEnqueued.Add();)
+        }
+        m_oRecieveCv.notify_one();
+        NotifyOnDataAvailableListeners();
+        CONCURRENCY_LIB_TRACE("Channel::Send", TracePhase::Instant, reinterpret_cast<unsigned long long>(this));
+        return true;
+    }
+
+    virtual bool ReadValue(Entry &p_oEntry) override
+    {
+        constexpr bool bIsBlocking = true;
+        return Read(p_oEntry, bIsBlocking);
+    }
+
+    virtual bool TryReadValue(Entry &p_oEntry) override
+    {
+        constexpr bool bIsBlocking = false;
+        return Read(p_oEntry, bIsBlocking);
+    }
+
+    virtual bool ReadValue(std::optional<Entry> &p_oEntry) override
+    {
+        constexpr bool bIsBlocking = true;
+        return Read(p_oEntry, bIsBlocking);
+    }
+
+    virtual bool TryReadValue(std::optional<Entry> &p_oEntry) override
+    {
+        constexpr bool bIsBlocking = false;
+        return Read(p_oEntry, bIsBlocking);
+    }
+
+    virtual void Close() override
+    {
+        {
+            std::lock_guard<std::mutex> oLock{m_oMutex};
+            m_bIsTerminated = true;
+        }
+        m_oRecieveCv.notify_all();
+        NotifyOnCloseListeners();
+    }
+
+    //! Keys with a pending value
+    std::size_t GetPendingKeysCount()
+    {
+        std::lock_guard<std::mutex> oLock{m_oMutex};
+        return m_oOrder.size();
+    }
+
+    //! All zeros unless built with CONCURRENCY_LIB_METRICS
+    ChannelMetricsSnapshot GetMetricsSnapshot() const
+    {
+        ChannelMetricsSnapshot oSnapshot;
+        CONCURRENCY_LIB_METRICS_ONLY(oSnapshot = m_oMetrics.Snapshot();)
+        return oSnapshot;
+    }
+
+protected:
+    virtual unsigned long long RegisterChannelOperationsListener(
+        std::function<void(void)> p_fOnDataAvailableCallback,
+        std::function<void(void)> p_fOnCloseAvailableCallback) override
+    {
+        std::lock_guard<std::mutex> oLock{m_oListenersMutex};
+        unsigned long long iIdToUse = m_iID;
+        m_oOnDataAvailableListeners[iIdToUse] = std::move(p_fOnDataAvailableCallback);
+        m_oOnCloseListeners[iIdToUse] = std::move(p_fOnCloseAvailableCallback);
+        m_iID++;
+        return iIdToUse;
+    }
+
+    virtual void UnRegisterChannelOperationsListener(int p_iId) override
+    {
+        //! Producers may be iterating the listeners (Notify*) at the same time
+        //! holding the lock also guarantees that once we return , the removed listener is not being executed anymore
+        std::lock_guard<std::mutex> oLock{m_oListenersMutex};
+        m_oOnDataAvailableListeners.erase(p_iId);
+        m_oOnCloseListeners.erase(p_iId);
+    }
+
+private:
+    //! p_oOutput is either an Entry& or an std::optional<Entry>&
+    template <typename Output>
+    bool Read(Output &p_oOutput, bool p_bIsBlocking)
+    {
+        {
+            std::unique_lock<std::mutex> oLock{m_oMutex};
+            if (p_bIsBlocking)
+            {
+                auto isValueAvailable = [this]()
+                { return !m_oOrder.empty() || m_bIsTerminated; };
+                CONCURRENCY_LIB_METRICS_ONLY(MetricsTimedWait(m_oRecieveCv, oLock, isValueAvailable, m_oMetrics.m_oReceiveBlockTime);)
+                m_oRecieveCv.wait(oLock, isValueAvailable);
+            }
+            if (m_bIsTerminated || m_oOrder.empty())
+            {
+                return false;
+            }
+            auto it = m_oPending.find(m_oOrder.front());
+            m_oOrder.pop_front();
+            MoveValueOut(p_oOutput, it->first, it->second);
+            m_oPending.erase(it);
+            CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oDequeued.Add();)
+        }
+        CONCURRENCY_LIB_TRACE("Channel::Receive", TracePhase::Instant, reinterpret_cast<unsigned long long>(this));
+        return true;
+    }
+
+    //! The key is copied out , it stays in the map till erased
+    static void MoveValueOut(Entry &p_oEntry, const Key &p_oKey, T &p_tValue)
+    {
+        p_oEntry.first = p_oKey;
+        p_oEntry.second = std::move(p_tValue);
+    }
+
+    static void MoveValueOut(std::optional<Entry> &p_oEntry, const Key &p_oKey, T &p_tValue)
+    {
+        p_oEntry.emplace(p_oKey, std::move(p_tValue));
+    }
+
+    void NotifyOnDataAvailableListeners()
+    {
+        std::lock_guard<std::mutex> oLock{m_oListenersMutex};
+        for (auto &entry : m_oOnDataAvailableListeners)
+        {
+            entry.second();
+        }
+    }
+    void NotifyOnCloseListeners()
+    {
+        std::lock_guard<std::mutex> oLock{m_oListenersMutex};
+        for (auto &entry : m_oOnCloseListeners)
+        {
+            entry.second();
+        }
+    }
+
+    //! One pending value per key , m_oOrder holds every pending key once , oldest first
+    std::unordered_map<Key, T, Hash> m_oPending;
+    std::deque<Key> m_oOrder;
+    bool m_bIsTerminated{false};
+    std::mutex m_oMutex;
+    std::condition_variable m_oRecieveCv;
+
+    //! Listeners for Channel operations
+    std::mutex m_oListenersMutex;
+    std::map<int, std::function<void(void)>> m_oOnDataAvailableListeners;
+    std::map<int, std::function<void(void)>> m_oOnCloseListeners;
+    unsigned long long m_iID{0};
+
+    CONCURRENCY_LIB_METRICS_ONLY(ChannelMetrics m_oMetrics;)
+};
\ No newline at end of file
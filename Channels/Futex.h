@@ -0,0 +1,46 @@
+#pragma once
+
+//! System includes
+#include <atomic>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <thread>
+#endif
+
+/*
+    - Thin futex wrappers over a 32 bits atomic word
+    - p_bIsShared for words living in memory mapped by several processes , private (cheaper) otherwise
+    - Not Linux : falls back to yielding , correct but spinning
+*/
+
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t) && std::atomic<std::uint32_t>::is_always_lock_free,
+              "futex words have to be plain 32 bits words");
+
+//! Sleeps while *p_pWord == p_uiExpected , may return spuriously , callers recheck their condition
+inline void FutexWait(std::atomic<std::uint32_t> *p_pWord, std::uint32_t p_uiExpected, bool p_bIsShared = false)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(p_pWord), p_bIsShared ? FUTEX_WAIT : FUTEX_WAIT_PRIVATE, p_uiExpected, nullptr, nullptr, 0);
+#else
+    if (p_pWord->load() == p_uiExpected)
+    {
+        std::this_thread::yield();
+    }
+#endif
+}
+
+inline void FutexWake(std::atomic<std::uint32_t> *p_pWord, int p_iWaitersCount, bool p_bIsShared = false)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<std::uint32_t *>(p_pWord), p_bIsShared ? FUTEX_WAKE : FUTEX_WAKE_PRIVATE, p_iWaitersCount, nullptr, nullptr, 0);
+#else
+    (void)p_pWord;
+    (void)p_iWaitersCount;
+    (void)p_bIsShared;
+#endif
+}
\ No newline at end of file
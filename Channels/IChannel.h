@@ -1,6 +1,9 @@
 #pragma once
 
 #include <functional>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
 
 template <typename T>
 class IChannel
@@ -12,6 +15,18 @@ public:
     virtual bool TryReadValue(T &p_tValue) = 0;
     virtual void Close() = 0;
 
+    //! Read into an empty optional , T is constructed straight from the channel storage (no default constructible T needed)
+    //! channels keeping their values in optional like storage override these , the defaults go through a default constructed T
+    virtual bool ReadValue(std::optional<T> &p_oValue)
+    {
+        return ReadThroughDefaultValue(p_oValue, false);
+    }
+
+    virtual bool TryReadValue(std::optional<T> &p_oValue)
+    {
+        return ReadThroughDefaultValue(p_oValue, true);
+    }
+
     virtual ~IChannel() = default;
 
 protected:
@@ -22,4 +37,27 @@ protected:
         std::function<void(void)> m_fOnCloseAvailableCallback) = 0;
     virtual void UnRegisterChannelOperationsListener(int) = 0;
     friend class ChannelSelector;
+    //! Dataflow stages (Pipelines/Dataflow.h) are scheduled by the same listeners
+    friend class DataflowStage;
+
+private:
+    bool ReadThroughDefaultValue(std::optional<T> &p_oValue, bool p_bIsTry)
+    {
+        if constexpr (std::is_default_constructible_v<T>)
+        {
+            T tValue;
+            if (!(p_bIsTry ? TryReadValue(tValue) : ReadValue(tValue)))
+            {
+                return false;
+            }
+            p_oValue.emplace(std::move(tValue));
+            return true;
+        }
+        else
+        {
+            (void)p_oValue;
+            (void)p_bIsTry;
+            throw std::logic_error("This channel can only read default constructible values");
+        }
+    }
 };
\ No newline at end of file
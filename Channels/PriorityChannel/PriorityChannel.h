@@ -0,0 +1,363 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//! Threading
+#include <mutex>
+#include <condition_variable>
+
+//! Channel Interface
+#include "IChannel.h"
+
+//! Instrumentation
+#include "Metrics.h"
+#include "Tracing.h"
+
+/*
+    - BufferedChannel delivering the highest priority value first (control messages overtaking bulk data on the same inbox)
+    - Compare is used like std::priority_queue : the value that is NOT less than the others comes out first
+    - Values of the same priority keep their FIFO order (sequence number tie break)
+    - Buffer is a 4-ary heap in one array reserved up front : O(log4 n) send / read , shallow and cache friendly , no allocation per message
+    - Bounded capacity , blocking and Close semantics are the same as BufferedChannel
+*/
+
+template <typename T, typename Compare = std::less<T>, typename Allocator = std::allocator<T>>
+class PriorityChannel : public IChannel<T>
+{
+public:
+    PriorityChannel(std::size_t p_sChannelMaxSize, const Compare &p_oCompare = Compare(), const Allocator &p_oAllocator = Allocator())
+        : m_oBuffer(HeapAllocator(p_oAllocator)),
+          m_oCompare(p_oCompare),
+          m_sChannelMaxSize(p_sChannelMaxSize),
+          m_oOnDataAvailableListeners(ListenersAllocator(p_oAllocator)),
+          m_oOnCloseListeners(ListenersAllocator(p_oAllocator))
+    {
+        if (m_sChannelMaxSize <= 0)
+        {
+            throw std::logic_error("Cannot Create a PriorityChannel With Len <= 0");
+        }
+        m_oBuffer.reserve(m_sChannelMaxSize);
+    }
+
+    //! Blocks while the channel holds p_sChannelMaxSize values
+    virtual bool SendValue(T &&p_tValue) override
+    {
+        constexpr bool bMove = true;
+        return SendValue(p_tValue, bMove);
+    }
+
+    virtual bool SendValue(T &p_tValue) override
+    {
+        constexpr bool bMove = false;
+        return SendValue(p_tValue, bMove);
+    }
+
+    bool SendValue(T &p_tValue, bool p_bMove)
+    {
+        if (p_bMove)
+        {
+            //! Move
+            return Emplace(std::move(p_tValue));
+        }
+        else if constexpr (std::is_copy_constructible_v<T>)
+        {
+            //! Copy
+            return Emplace(static_cast<const T &>(p_tValue));
+        }
+        else
+        {
+            throw std::logic_error("Cannot Copy a move only value into a PriorityChannel, send it as T&&");
+        }
+    }
+
+    //! Same as SendValue , but the value is constructed from p_args at the end of the heap (no temporary T)
+    //! then moved up to its place like any other entry
+    template <typename... Args>
+    bool Emplace(Args &&...p_args)
+    {
+        //! Lock is released after updating internal state
+        //! This is important cause of the callback that we call (user defined code)
+        //! What if that user code uses that same channel again to Send while we are holding mutex!!
+        //! => Deadlock || Undefined behaviour cause of multiple locking within same thread
+        //! So we release lock
+        //! Also this minimized suprios wakeups on the Consumer threads
+        {
+            std::unique_lock<std::mutex> olock{m_oBufferMutex};
+            //! Block till a slot is available in the buffer
+            auto isSlotAvailable = [this]()
+            { return m_oBuffer.size() < m_sChannelMaxSize || m_bIsTerminated; };
+            CONCURRENCY_LIB_METRICS_ONLY(MetricsTimedWait(m_oSlotAvailableCv, olock, isSlotAvailable, m_oMetrics.m_oSendBlockTime);)
+            m_oSlotAvailableCv.wait(olock, isSlotAvailable);
+
+            if (m_bIsTerminated)
+            {
+                return false;
+            }
+            Push(std::forward<Args>(p_args)...);
+            CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oEnqueued.Add();)
+            CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oHighWaterMark.Update(m_oBuffer.size());)
+        }
+
+        //! Notify anyone waiting to read from the buffer that a value is available
+        m_oRecieveCv.notify_one();
+
+        //! this happens within the context of the thread that creates and puts it on the channel (Producer)
+        //! Lock is release before calling it , to avoid deadlocks
+        NotifyOnDataAvailableListeners();
+        CONCURRENCY_LIB_TRACE("Channel::Send", TracePhase::Instant, reinterpret_cast<unsigned long long>(this));
+
+        return true;
+    }
+
+    virtual bool ReadValue(T &p_tValue) override
+    {
+        constexpr bool bIsBlocking = true;
+        return Read(p_tValue, bIsBlocking);
+    }
+
+    virtual bool TryReadValue(T &p_tValue) override
+    {
+        constexpr bool bIsBlocking = false;
+        return Read(p_tValue, bIsBlocking);
+    }
+
+    virtual bool ReadValue(std::optional<T> &p_oValue) override
+    {
+        constexpr bool bIsBlocking = true;
+        return Read(p_oValue, bIsBlocking);
+    }
+
+    virtual bool TryReadValue(std::optional<T> &p_oValue) override
+    {
+        constexpr bool bIsBlocking = false;
+        return Read(p_oValue, bIsBlocking);
+    }
+
+    virtual void Close() override
+    {
+        {
+            std::lock_guard<std::mutex> oLock{m_oBufferMutex};
+            m_bIsTerminated = true;
+        }
+        m_oSlotAvailableCv.notify_all();
+        m_oRecieveCv.notify_all();
+        NotifyOnCloseListeners();
+    }
+
+    ~PriorityChannel()
+    {
+        Close();
+    }
+
+    //! All zeros unless built with CONCURRENCY_LIB_METRICS
+    ChannelMetricsSnapshot GetMetricsSnapshot() const
+    {
+        ChannelMetricsSnapshot oSnapshot;
+        CONCURRENCY_LIB_METRICS_ONLY(oSnapshot = m_oMetrics.Snapshot();)
+        return oSnapshot;
+    }
+
+protected:
+    virtual unsigned long long RegisterChannelOperationsListener(
+        std::function<void(void)> p_fOnDataAvailableCallback,
+        std::function<void(void)> p_fOnCloseAvailableCallback) override
+    {
+        std::lock_guard<std::mutex> oLock{m_oListenersMutex};
+        unsigned long long iIdToUse = m_iID;
+        m_oOnDataAvailableListeners[iIdToUse] = std::move(p_fOnDataAvailableCallback);
+        m_oOnCloseListeners[iIdToUse] = std::move(p_fOnCloseAvailableCallback);
+        m_iID++;
+        return iIdToUse;
+    }
+
+    virtual void UnRegisterChannelOperationsListener(int p_iId) override
+    {
+        //! Producers may be iterating the listeners (Notify*) at the same time
+        //! holding the lock also guarantees that once we return , the removed listener is not being executed anymore
+        std::lock_guard<std::mutex> oLock{m_oListenersMutex};
+        m_oOnDataAvailableListeners.erase(p_iId);
+        m_oOnCloseListeners.erase(p_iId);
+    }
+
+private:
+    //! p_oOutput is either a T& or an std::optional<T>& , the value is moved out of the buffer in both cases
+    template <typename Output>
+    bool Read(Output &p_oOutput, bool p_bIsBlocking)
+    {
+        {
+            std::unique_lock<std::mutex> olock{m_oBufferMutex};
+            if (p_bIsBlocking)
+            {
+                //! Block till a value is available in the buffer, i.e Not Empty
+                auto isValueAvailable = [this]()
+                { return !m_oBuffer.empty() || m_bIsTerminated; };
+                CONCURRENCY_LIB_METRICS_ONLY(MetricsTimedWait(m_oRecieveCv, olock, isValueAvailable, m_oMetrics.m_oReceiveBlockTime);)
+                m_oRecieveCv.wait(olock, isValueAvailable);
+            }
+            if (m_bIsTerminated || m_oBuffer.empty())
+            {
+                return false;
+            }
+            //! Consume the highest priority value
+            MoveValueOut(p_oOutput);
+            Pop();
+            CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oDequeued.Add();)
+        }
+        //! Notify Prodcuers that a slot has become available
+        m_oSlotAvailableCv.notify_one();
+        CONCURRENCY_LIB_TRACE("Channel::Receive", TracePhase::Instant, reinterpret_cast<unsigned long long>(this));
+        return true;
+    }
+
+    void MoveValueOut(T &p_tValue)
+    {
+        p_tValue = std::move(m_oBuffer.front().m_tValue);
+    }
+
+    void MoveValueOut(std::optional<T> &p_oValue)
+    {
+        p_oValue.emplace(std::move(m_oBuffer.front().m_tValue));
+    }
+
+    struct Entry
+    {
+        template <typename... Args>
+        explicit Entry(unsigned long long p_ullSequence, Args &&...p_args)
+            : m_tValue(std::forward<Args>(p_args)...), m_ullSequence(p_ullSequence)
+        {
+        }
+
+        T m_tValue;
+        unsigned long long m_ullSequence;
+    };
+
+    static constexpr std::size_t s_sArity = 4;
+
+    //! p_oLeft has to come out before p_oRight
+    bool IsBefore(const Entry &p_oLeft, const Entry &p_oRight) const
+    {
+        if (m_oCompare(p_oRight.m_tValue, p_oLeft.m_tValue))
+        {
+            return true;
+        }
+        if (m_oCompare(p_oLeft.m_tValue, p_oRight.m_tValue))
+        {
+            return false;
+        }
+        return p_oLeft.m_ullSequence < p_oRight.m_ullSequence;
+    }
+
+    //! Lock is held , sift up moving parents down into the hole , the new entry is written once
+    template <typename... Args>
+    void Push(Args &&...p_args)
+    {
+        m_oBuffer.emplace_back(m_ullNextSequence, std::forward<Args>(p_args)...);
+        m_ullNextSequence++;
+        std::size_t sHole = m_oBuffer.size() - 1;
+        if (sHole == 0)
+        {
+            return;
+        }
+        Entry oEntry = std::move(m_oBuffer[sHole]);
+        while (sHole > 0)
+        {
+            std::size_t sParent = (sHole - 1) / s_sArity;
+            if (!IsBefore(oEntry, m_oBuffer[sParent]))
+            {
+                break;
+            }
+            m_oBuffer[sHole] = std::move(m_oBuffer[sParent]);
+            sHole = sParent;
+        }
+        m_oBuffer[sHole] = std::move(oEntry);
+    }
+
+    //! Lock is held , front was moved out already , sift the last entry down from the root
+    void Pop()
+    {
+        Entry oLast = std::move(m_oBuffer.back());
+        m_oBuffer.pop_back();
+        std::size_t sSize = m_oBuffer.size();
+        if (sSize == 0)
+        {
+            return;
+        }
+        std::size_t sHole = 0;
+        while (true)
+        {
+            std::size_t sFirstChild = sHole * s_sArity + 1;
+            if (sFirstChild >= sSize)
+            {
+                break;
+            }
+            //! Children are contiguous , one cache line for small T
+            std::size_t sBestChild = sFirstChild;
+            std::size_t sLastChild = std::min(sFirstChild + s_sArity, sSize);
+            for (std::size_t sChild = sFirstChild + 1; sChild < sLastChild; ++sChild)
+            {
+                if (IsBefore(m_oBuffer[sChild], m_oBuffer[sBestChild]))
+                {
+                    sBestChild = sChild;
+                }
+            }
+            if (!IsBefore(m_oBuffer[sBestChild], oLast))
+            {
+                break;
+            }
+            m_oBuffer[sHole] = std::move(m_oBuffer[sBestChild]);
+            sHole = sBestChild;
+        }
+        m_oBuffer[sHole] = std::move(oLast);
+    }
+
+    void NotifyOnDataAvailableListeners()
+    {
+        std::lock_guard<std::mutex> oLock{m_oListenersMutex};
+        for (auto &entry : m_oOnDataAvailableListeners)
+        {
+            entry.second();
+        }
+    }
+    void NotifyOnCloseListeners()
+    {
+        std::lock_guard<std::mutex> oLock{m_oListenersMutex};
+        for (auto &entry : m_oOnCloseListeners)
+        {
+            entry.second();
+        }
+    }
+
+    std::mutex m_oBufferMutex;
+    std::condition_variable m_oRecieveCv;
+    std::condition_variable m_oSlotAvailableCv;
+
+    using HeapAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Entry>;
+    std::vector<Entry, HeapAllocator> m_oBuffer;
+    Compare m_oCompare;
+    unsigned long long m_ullNextSequence{0};
+    std::size_t m_sChannelMaxSize;
+    bool m_bIsTerminated{false};
+
+    //! Listeners for Channel operations
+    std::mutex m_oListenersMutex;
+    using ListenersAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<std::pair<const int, std::function<void(void)>>>;
+    using ListenersMap = std::map<int, std::function<void(void)>, std::less<int>, ListenersAllocator>;
+    ListenersMap m_oOnDataAvailableListeners;
+    ListenersMap m_oOnCloseListeners;
+    unsigned long long m_iID{0};
+
+    CONCURRENCY_LIB_METRICS_ONLY(ChannelMetrics m_oMetrics;)
+};
+
+//! PriorityChannel drawing all of its memory (heap + listeners) from a std::pmr::memory_resource
+template <typename T, typename Compare = std::less<T>>
+using PmrPriorityChannel = PriorityChannel<T, Compare, std::pmr::polymorphic_allocator<T>>;
\ No newline at end of file
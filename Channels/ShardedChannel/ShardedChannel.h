@@ -0,0 +1,349 @@
+#pragma once
+
+//! System includes
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <map>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+
+//! Threading
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+//! Channel Interface
+#include "IChannel.h"
+
+//! Instrumentation
+#include "Metrics.h"
+#include "Tracing.h"
+
+/*
+    - Relaxed FIFO BufferedChannel for many producers : the buffer is split in shards (one per core by default) , each with its own lock
+    - Every thread has a home shard , producers only ever enqueue there , consumers poll it first then steal from the others
+    - Order is kept per producer (a producer always uses the same shard) , not across producers
+    - Total capacity is bounded , split between shards
+    - Same IChannel<T> interface and Close semantics as BufferedChannel
+*/
+
+//! Questions / Edgecases:
+//! Q: Why does a producer block on a full home shard while other shards have room ?
+//!     spilling to another shard would break that producer's order , and the bound is split exactly between shards
+//! Q: Is there any shared state left on the hot path ?
+//!     no , a send / read locks one shard , consumers skip empty shards without locking them (per shard atomic size)
+//!     the central lock is only taken when consumers actually sleep (all shards empty) , producers check a sleepers count first
+//! Q: Lost wake ups between a consumer scanning the shards and going to sleep ?
+//!     the consumer announces itself (sleepers count) holding the central lock , then scans again before waiting
+//!     a producer enqueues , then reads the sleepers count (full fences on both sides) and notifies holding that same lock
+
+template <typename T>
+class ShardedChannel : public IChannel<T>
+{
+public:
+    //! p_sShardsCount 0 : one shard per hardware thread , never more shards than capacity
+    explicit ShardedChannel(std::size_t p_sChannelMaxSize, std::size_t p_sShardsCount = 0)
+    {
+        if (p_sChannelMaxSize <= 0)
+        {
+            throw std::logic_error("Cannot Create a ShardedChannel With Len <= 0");
+        }
+        if (p_sShardsCount == 0)
+        {
+            p_sShardsCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        m_sShardsCount = std::min(p_sShardsCount, p_sChannelMaxSize);
+        m_pShards = std::make_unique<Shard[]>(m_sShardsCount);
+        for (std::size_t sShard = 0; sShard < m_sShardsCount; ++sShard)
+        {
+            m_pShards[sShard].m_sMaxSize = p_sChannelMaxSize / m_sShardsCount + (sShard < p_sChannelMaxSize % m_sShardsCount ? 1 : 0);
+        }
+    }
+
+    virtual bool SendValue(T &&p_tValue) override
+    {
+        return Emplace(std::move(p_tValue));
+    }
+
+    virtual bool SendValue(T &p_tValue) override
+    {
+        if constexpr (std::is_copy_constructible_v<T>)
+        {
+            return Emplace(static_cast<const T &>(p_tValue));
+        }
+        else
+        {
+            throw std::logic_error("Cannot Copy a move only value into a ShardedChannel, send it as T&&");
+        }
+    }
+
+    //! Block till the caller's home shard has room , then construct the value there
+    template <typename... Args>
+    bool Emplace(Args &&...p_args)
+    {
+        Shard &oShard = m_pShards[GetHomeShard()];
+        {
+            std::unique_lock<std::mutex> oLock{oShard.m_oMutex};
+            auto isSlotAvailable = [this, &oShard]()
+            { return oShard.m_oBuffer.size() < oShard.m_sMaxSize || m_bIsTerminated.load(); };
+            if (!isSlotAvailable())
+            {
+                oShard.m_iWaitingProducers++;
+                CONCURRENCY_LIB_METRICS_ONLY(MetricsTimedWait(oShard.m_oSlotAvailableCv, oLock, isSlotAvailable, m_oMetrics.m_oSendBlockTime);)
+                oShard.m_oSlotAvailableCv.wait(oLock, isSlotAvailable);
+                oShard.m_iWaitingProducers--;
+            }
+            if (m_bIsTerminated)
+            {
+                return false;
+            }
+            oShard.m_oBuffer.emplace_back(std::forward<Args>(p_args)...);
+            oShard.m_sSize.store(oShard.m_oBuffer.size(), std::memory_order_relaxed);
+            CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oEnqueued.Add();)
+        }
+
+        //! Wake a sleeping consumer , only if there is one
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_iSleepingConsumers.load(std::memory_order_relaxed) > 0)
+        {
+            std::lock_guard<std::mutex> oLock{m_oConsumersMutex};
+            m_oConsumersCv.notify_one();
+        }
+        if (m_bHasListeners.load(std::memory_order_acquire))
+        {
+            NotifyOnDataAvailableListeners();
+        }
+        CONCURRENCY_LIB_TRACE("Channel::Send", TracePhase::Instant, reinterpret_cast<unsigned long long>(this));
+        return true;
+    }
+
+    virtual bool ReadValue(T &p_tValue) override
+    {
+        constexpr bool bIsBlocking = true;
+        return Read(p_tValue, bIsBlocking);
+    }
+
+    virtual bool TryReadValue(T &p_tValue) override
+    {
+        constexpr bool bIsBlocking = false;
+        return Read(p_tValue, bIsBlocking);
+    }
+
+    virtual bool ReadValue(std::optional<T> &p_oValue) override
+    {
+        constexpr bool bIsBlocking = true;
+        return Read(p_oValue, bIsBlocking);
+    }
+
+    virtual bool TryReadValue(std::optional<T> &p_oValue) override
+    {
+        constexpr bool bIsBlocking = false;
+        return Read(p_oValue, bIsBlocking);
+    }
+
+    virtual void Close() override
+    {
+        m_bIsTerminated = true;
+        for (std::size_t sShard = 0; sShard < m_sShardsCount; ++sShard)
+        {
+            //! Taking the lock orders the flag with producers checking it before waiting
+            std::lock_guard<std::mutex> oLock{m_pShards[sShard].m_oMutex};
+            m_pShards[sShard].m_oSlotAvailableCv.notify_all();
+        }
+        {
+            std::lock_guard<std::mutex> oLock{m_oConsumersMutex};
+            m_oConsumersCv.notify_all();
+        }
+        NotifyOnCloseListeners();
+    }
+
+    ~ShardedChannel()
+    {
+        Close();
+    }
+
+    std::size_t GetShardsCount() const
+    {
+        return m_sShardsCount;
+    }
+
+    //! All zeros unless built with CONCURRENCY_LIB_METRICS
+    ChannelMetricsSnapshot GetMetricsSnapshot() const
+    {
+        ChannelMetricsSnapshot oSnapshot;
+        CONCURRENCY_LIB_METRICS_ONLY(oSnapshot = m_oMetrics.Snapshot();)
+        return oSnapshot;
+    }
+
+protected:
+    virtual unsigned long long RegisterChannelOperationsListener(
+        std::function<void(void)> p_fOnDataAvailableCallback,
+        std::function<void(void)> p_fOnCloseAvailableCallback) override
+    {
+        std::lock_guard<std::mutex> oLock{m_oListenersMutex};
+        unsigned long long iIdToUse = m_iID;
+        m_oOnDataAvailableListeners[iIdToUse] = std::move(p_fOnDataAvailableCallback);
+        m_oOnCloseListeners[iIdToUse] = std::move(p_fOnCloseAvailableCallback);
+        m_iID++;
+        m_bHasListeners.store(true, std::memory_order_release);
+        return iIdToUse;
+    }
+
+    virtual void UnRegisterChannelOperationsListener(int p_iId) override
+    {
+        //! Producers may be iterating the listeners (Notify*) at the same time
+        //! holding the lock also guarantees that once we return , the removed listener is not being executed anymore
+        std::lock_guard<std::mutex> oLock{m_oListenersMutex};
+        m_oOnDataAvailableListeners.erase(p_iId);
+        m_oOnCloseListeners.erase(p_iId);
+        m_bHasListeners.store(!m_oOnDataAvailableListeners.empty(), std::memory_order_release);
+    }
+
+private:
+    struct alignas(64) Shard
+    {
+        std::mutex m_oMutex;
+        std::condition_variable m_oSlotAvailableCv; //! producers of that shard
+        std::deque<T> m_oBuffer;
+        std::size_t m_sMaxSize{0};
+        int m_iWaitingProducers{0};
+        //! Mirror of m_oBuffer.size() , lets consumers skip empty shards without locking them
+        std::atomic<std::size_t> m_sSize{0};
+    };
+
+    //! Threads get consecutive home shards the first time they touch any ShardedChannel<T>
+    std::size_t GetHomeShard() const
+    {
+        static std::atomic<std::size_t> s_sNextThreadIndex{0};
+        static thread_local std::size_t s_sThreadIndex = s_sNextThreadIndex++;
+        return s_sThreadIndex % m_sShardsCount;
+    }
+
+    //! p_oOutput is either a T& or an std::optional<T>&
+    template <typename Output>
+    bool Read(Output &p_oOutput, bool p_bIsBlocking)
+    {
+        while (true)
+        {
+            if (m_bIsTerminated)
+            {
+                return false;
+            }
+            if (TryPopAnyShard(p_oOutput))
+            {
+                return true;
+            }
+            if (!p_bIsBlocking)
+            {
+                return false;
+            }
+            //! Every shard looked empty , announce ourselves then scan again before sleeping
+            std::unique_lock<std::mutex> oLock{m_oConsumersMutex};
+            m_iSleepingConsumers.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            bool bResult = !m_bIsTerminated && TryPopAnyShard(p_oOutput);
+            if (!bResult && !m_bIsTerminated)
+            {
+                CONCURRENCY_LIB_METRICS_ONLY(MetricsClock::time_point oStart = MetricsClock::now();)
+                m_oConsumersCv.wait(oLock);
+                CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oReceiveBlockTime.Record(MetricsElapsedNanoseconds(oStart));)
+            }
+            m_iSleepingConsumers.fetch_sub(1);
+            if (bResult)
+            {
+                return true;
+            }
+        }
+    }
+
+    //! Home shard first , then steal from the next ones
+    template <typename Output>
+    bool TryPopAnyShard(Output &p_oOutput)
+    {
+        std::size_t sHomeShard = GetHomeShard();
+        for (std::size_t sOffset = 0; sOffset < m_sShardsCount; ++sOffset)
+        {
+            if (TryPop(m_pShards[(sHomeShard + sOffset) % m_sShardsCount], p_oOutput))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template <typename Output>
+    bool TryPop(Shard &p_oShard, Output &p_oOutput)
+    {
+        if (p_oShard.m_sSize.load(std::memory_order_relaxed) == 0)
+        {
+            return false;
+        }
+        bool bIsProducerWaiting = false;
+        {
+            std::lock_guard<std::mutex> oLock{p_oShard.m_oMutex};
+            if (p_oShard.m_oBuffer.empty())
+            {
+                return false;
+            }
+            MoveValueOut(p_oOutput, p_oShard.m_oBuffer.front());
+            p_oShard.m_oBuffer.pop_front();
+            p_oShard.m_sSize.store(p_oShard.m_oBuffer.size(), std::memory_order_relaxed);
+            bIsProducerWaiting = p_oShard.m_iWaitingProducers > 0;
+            CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oDequeued.Add();)
+        }
+        if (bIsProducerWaiting)
+        {
+            p_oShard.m_oSlotAvailableCv.notify_one();
+        }
+        CONCURRENCY_LIB_TRACE("Channel::Receive", TracePhase::Instant, reinterpret_cast<unsigned long long>(this));
+        return true;
+    }
+
+    static void MoveValueOut(T &p_tValue, T &p_tSource)
+    {
+        p_tValue = std::move(p_tSource);
+    }
+
+    static void MoveValueOut(std::optional<T> &p_oValue, T &p_tSource)
+    {
+        p_oValue.emplace(std::move(p_tSource));
+    }
+
+    void NotifyOnDataAvailableListeners()
+    {
+        std::lock_guard<std::mutex> oLock{m_oListenersMutex};
+        for (auto &entry : m_oOnDataAvailableListeners)
+        {
+            entry.second();
+        }
+    }
+    void NotifyOnCloseListeners()
+    {
+        std::lock_guard<std::mutex> oLock{m_oListenersMutex};
+        for (auto &entry : m_oOnCloseListeners)
+        {
+            entry.second();
+        }
+    }
+
+    std::unique_ptr<Shard[]> m_pShards;
+    std::size_t m_sShardsCount{0};
+    std::atomic<bool> m_bIsTerminated{false};
+
+    //! Only used when every shard is empty
+    alignas(64) std::mutex m_oConsumersMutex;
+    std::condition_variable m_oConsumersCv;
+    std::atomic<int> m_iSleepingConsumers{0};
+
+    //! Listeners for Channel operations , producers skip the lock while there is none
+    std::mutex m_oListenersMutex;
+    std::atomic<bool> m_bHasListeners{false};
+    std::map<int, std::function<void(void)>> m_oOnDataAvailableListeners;
+    std::map<int, std::function<void(void)>> m_oOnCloseListeners;
+    unsigned long long m_iID{0};
+
+    CONCURRENCY_LIB_METRICS_ONLY(ChannelMetrics m_oMetrics;)
+};
\ No newline at end of file
@@ -0,0 +1,381 @@
+#pragma once
+
+//! System includes
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//! Channel Interface
+#include "IChannel.h"
+#include "Futex.h"
+
+/*
+    - Bounded channel between processes of the same host , over a ring mapped from /dev/shm (shm_open)
+    - values are copied straight into the shared slots , no socket , no kernel copy , so T has to be trivially copyable
+    - lock free multi producers / multi consumers ring (per slot sequence numbers) , no mutex lives in the segment
+    - blocking Send / Read spin a little then sleep on a shared futex , only woken when someone actually sleeps
+    - same semantics as BufferedChannel : bounded , Close makes every Send / Read fail (values still buffered are dropped)
+*/
+
+//! Questions / Edgecases:
+//! Q: Who owns the segment ?
+//!     the process constructing with a capacity creates (or replaces) it , its destructor closes the channel and unlinks the name
+//!     other processes open it by name , their destructor only unmaps
+//! Q: Can it be added to a ChannelSelector ?
+//!     No, data arrives from other processes , there is no producer in this process to run the listeners , Register throws
+//! Q: How are lost wakeups avoided ?
+//!     a sleeper reads the epoch , announces itself in the waiters count , then retries before sleeping on that epoch
+//!     a waker changes the ring , then checks the waiters count and bumps the epoch , a full fence on both sides so one sees the other
+//! Q: What if a process dies while using the channel ?
+//!     dying while sleeping or between operations is harmless , at worst a stale waiters count costs a few extra futex wakes
+//!     dying between claiming a position and publishing its slot is not recoverable : a producer leaves that slot never readable
+//!     (consumers reaching it stall) , a consumer leaves it never freed (producers stall one lap later) , Close to get everyone out
+
+template <typename T>
+class SharedMemoryChannel : public IChannel<T>
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SharedMemoryChannel values are copied between processes , T has to be trivially copyable");
+
+public:
+    //! Creates (or replaces) the segment p_strName in /dev/shm , p_sCapacity is rounded up to a power of two
+    SharedMemoryChannel(const std::string &p_strName, std::size_t p_sCapacity)
+        : m_strName(SegmentName(p_strName)), m_bIsOwner(true)
+    {
+        if (p_sCapacity <= 0)
+        {
+            throw std::logic_error("Cannot Create a SharedMemoryChannel With Len <= 0");
+        }
+        std::size_t sCapacity = RoundUpToPowerOfTwo(p_sCapacity);
+        m_sMappingSize = MappingSize(sCapacity);
+
+        int iFd = shm_open(m_strName.c_str(), O_CREAT | O_RDWR | O_TRUNC, 0600);
+        if (iFd < 0)
+        {
+            throw std::system_error(errno, std::generic_category(), "shm_open " + m_strName);
+        }
+        if (ftruncate(iFd, m_sMappingSize) != 0)
+        {
+            int iError = errno;
+            close(iFd);
+            shm_unlink(m_strName.c_str());
+            throw std::system_error(iError, std::generic_category(), "ftruncate " + m_strName);
+        }
+        Map(iFd);
+
+        m_pHeader = new (m_pMapping) Header();
+        m_pHeader->m_uiElementSize = sizeof(T);
+        m_pHeader->m_ullCapacity = sCapacity;
+        m_pSlots = reinterpret_cast<Slot *>(static_cast<char *>(m_pMapping) + sizeof(Header));
+        for (std::size_t sSlot = 0; sSlot < sCapacity; ++sSlot)
+        {
+            new (&m_pSlots[sSlot].m_ullSequence) std::atomic<std::uint64_t>(sSlot);
+        }
+        m_ullMask = sCapacity - 1;
+        //! Published last , openers check it before touching anything else
+        m_pHeader->m_uiMagic.store(s_uiMagic, std::memory_order_release);
+    }
+
+    //! Opens a segment created by another process
+    explicit SharedMemoryChannel(const std::string &p_strName)
+        : m_strName(SegmentName(p_strName)), m_bIsOwner(false)
+    {
+        int iFd = shm_open(m_strName.c_str(), O_RDWR, 0600);
+        if (iFd < 0)
+        {
+            throw std::system_error(errno, std::generic_category(), "shm_open " + m_strName);
+        }
+        struct stat oStat;
+        if (fstat(iFd, &oStat) != 0 || static_cast<std::size_t>(oStat.st_size) < sizeof(Header))
+        {
+            close(iFd);
+            throw std::logic_error("SharedMemoryChannel " + m_strName + " is not initialized yet");
+        }
+        m_sMappingSize = oStat.st_size;
+        Map(iFd);
+
+        m_pHeader = static_cast<Header *>(m_pMapping);
+        if (m_pHeader->m_uiMagic.load(std::memory_order_acquire) != s_uiMagic ||
+            m_pHeader->m_uiElementSize != sizeof(T) ||
+            MappingSize(m_pHeader->m_ullCapacity) != m_sMappingSize)
+        {
+            munmap(m_pMapping, m_sMappingSize);
+            throw std::logic_error("SharedMemoryChannel " + m_strName + " is not initialized yet or holds another type");
+        }
+        m_pSlots = reinterpret_cast<Slot *>(static_cast<char *>(m_pMapping) + sizeof(Header));
+        m_ullMask = m_pHeader->m_ullCapacity - 1;
+    }
+
+    SharedMemoryChannel(const SharedMemoryChannel &) = delete;
+    SharedMemoryChannel &operator=(const SharedMemoryChannel &) = delete;
+
+    //! std::optional<T> reads from IChannel
+    using IChannel<T>::ReadValue;
+    using IChannel<T>::TryReadValue;
+
+    ~SharedMemoryChannel()
+    {
+        if (m_bIsOwner)
+        {
+            Close();
+            shm_unlink(m_strName.c_str());
+        }
+        munmap(m_pMapping, m_sMappingSize);
+    }
+
+    //! Block till a slot is free
+    virtual bool SendValue(T &&p_tValue) override
+    {
+        return SendValue(static_cast<T &>(p_tValue));
+    }
+
+    virtual bool SendValue(T &p_tValue) override
+    {
+        bool bResult = WaitUntil([this, &p_tValue]()
+                                 { return TryPush(p_tValue); },
+                                 m_pHeader->m_uiSpaceEpoch, m_pHeader->m_uiSpaceWaiters);
+        if (bResult)
+        {
+            WakeUpOne(m_pHeader->m_uiDataEpoch, m_pHeader->m_uiDataWaiters);
+        }
+        return bResult;
+    }
+
+    //! Block till a value is available
+    virtual bool ReadValue(T &p_tValue) override
+    {
+        bool bResult = WaitUntil([this, &p_tValue]()
+                                 { return TryPop(p_tValue); },
+                                 m_pHeader->m_uiDataEpoch, m_pHeader->m_uiDataWaiters);
+        if (bResult)
+        {
+            WakeUpOne(m_pHeader->m_uiSpaceEpoch, m_pHeader->m_uiSpaceWaiters);
+        }
+        return bResult;
+    }
+
+    virtual bool TryReadValue(T &p_tValue) override
+    {
+        if (IsClosed() || !TryPop(p_tValue))
+        {
+            return false;
+        }
+        WakeUpOne(m_pHeader->m_uiSpaceEpoch, m_pHeader->m_uiSpaceWaiters);
+        return true;
+    }
+
+    //! Closes it for every process
+    virtual void Close() override
+    {
+        m_pHeader->m_uiIsClosed.store(1);
+        for (std::atomic<std::uint32_t> *pEpoch : {&m_pHeader->m_uiDataEpoch, &m_pHeader->m_uiSpaceEpoch})
+        {
+            pEpoch->fetch_add(1);
+            FutexWake(pEpoch, INT_MAX, true);
+        }
+    }
+
+    std::size_t GetCapacity() const
+    {
+        return m_pHeader->m_ullCapacity;
+    }
+
+protected:
+    virtual unsigned long long RegisterChannelOperationsListener(
+        std::function<void(void)>,
+        std::function<void(void)>) override
+    {
+        throw std::logic_error("SharedMemoryChannel data comes from other processes , it cannot be listened on (ChannelSelector)");
+    }
+
+    virtual void UnRegisterChannelOperationsListener(int) override
+    {
+    }
+
+private:
+    //! Lives at the start of the mapping , every field is shared between processes
+    struct Header
+    {
+        std::atomic<std::uint32_t> m_uiMagic{0};
+        std::uint32_t m_uiElementSize{0};
+        std::uint64_t m_ullCapacity{0};
+        alignas(64) std::atomic<std::uint64_t> m_ullHead{0};
+        alignas(64) std::atomic<std::uint64_t> m_ullTail{0};
+        alignas(64) std::atomic<std::uint32_t> m_uiIsClosed{0};
+        //! Futex words , bumped only when someone sleeps on them
+        alignas(64) std::atomic<std::uint32_t> m_uiDataEpoch{0};
+        std::atomic<std::uint32_t> m_uiDataWaiters{0};
+        alignas(64) std::atomic<std::uint32_t> m_uiSpaceEpoch{0};
+        std::atomic<std::uint32_t> m_uiSpaceWaiters{0};
+    };
+
+    //! Sequence == position : free for the producer at that position , position + 1 : holds its value
+    struct Slot
+    {
+        std::atomic<std::uint64_t> m_ullSequence;
+        T m_tValue;
+    };
+
+    static constexpr std::uint32_t s_uiMagic = 0x53484d43; //! "SHMC"
+    static constexpr int s_iSpinsBeforeBlocking = 64;
+
+    static std::string SegmentName(const std::string &p_strName)
+    {
+        return p_strName.empty() || p_strName[0] != '/' ? "/" + p_strName : p_strName;
+    }
+
+    static std::size_t RoundUpToPowerOfTwo(std::size_t p_sValue)
+    {
+        std::size_t sPowerOfTwo = 1;
+        while (sPowerOfTwo < p_sValue)
+        {
+            sPowerOfTwo <<= 1;
+        }
+        return sPowerOfTwo;
+    }
+
+    static std::size_t MappingSize(std::size_t p_sCapacity)
+    {
+        return sizeof(Header) + p_sCapacity * sizeof(Slot);
+    }
+
+    void Map(int p_iFd)
+    {
+        m_pMapping = mmap(nullptr, m_sMappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, p_iFd, 0);
+        int iError = errno;
+        close(p_iFd);
+        if (m_pMapping == MAP_FAILED)
+        {
+            throw std::system_error(iError, std::generic_category(), "mmap " + m_strName);
+        }
+    }
+
+    bool IsClosed() const
+    {
+        return m_pHeader->m_uiIsClosed.load(std::memory_order_acquire) != 0;
+    }
+
+    bool TryPush(const T &p_tValue)
+    {
+        std::uint64_t ullPosition = m_pHeader->m_ullTail.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot &oSlot = m_pSlots[ullPosition & m_ullMask];
+            std::int64_t llDiff = static_cast<std::int64_t>(oSlot.m_ullSequence.load(std::memory_order_acquire) - ullPosition);
+            if (llDiff == 0)
+            {
+                //! Claim the position , then fill the slot and hand it to consumers
+                if (m_pHeader->m_ullTail.compare_exchange_weak(ullPosition, ullPosition + 1, std::memory_order_relaxed))
+                {
+                    std::memcpy(static_cast<void *>(&oSlot.m_tValue), &p_tValue, sizeof(T));
+                    oSlot.m_ullSequence.store(ullPosition + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (llDiff < 0)
+            {
+                //! Full
+                return false;
+            }
+            else
+            {
+                ullPosition = m_pHeader->m_ullTail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool TryPop(T &p_tValue)
+    {
+        std::uint64_t ullPosition = m_pHeader->m_ullHead.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot &oSlot = m_pSlots[ullPosition & m_ullMask];
+            std::int64_t llDiff = static_cast<std::int64_t>(oSlot.m_ullSequence.load(std::memory_order_acquire) - (ullPosition + 1));
+            if (llDiff == 0)
+            {
+                if (m_pHeader->m_ullHead.compare_exchange_weak(ullPosition, ullPosition + 1, std::memory_order_relaxed))
+                {
+                    std::memcpy(static_cast<void *>(&p_tValue), &oSlot.m_tValue, sizeof(T));
+                    //! Free for the producer one lap later
+                    oSlot.m_ullSequence.store(ullPosition + m_ullMask + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (llDiff < 0)
+            {
+                //! Empty
+                return false;
+            }
+            else
+            {
+                ullPosition = m_pHeader->m_ullHead.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    //! Spin for a while then sleep on p_oEpoch till p_fAttempt succeeds , false once closed
+    template <typename Attempt>
+    bool WaitUntil(Attempt &&p_fAttempt, std::atomic<std::uint32_t> &p_oEpoch, std::atomic<std::uint32_t> &p_oWaiters)
+    {
+        for (int iSpin = 0; iSpin < s_iSpinsBeforeBlocking; ++iSpin)
+        {
+            if (IsClosed())
+            {
+                return false;
+            }
+            if (p_fAttempt())
+            {
+                return true;
+            }
+            std::this_thread::yield();
+        }
+        while (true)
+        {
+            std::uint32_t uiEpoch = p_oEpoch.load(std::memory_order_acquire);
+            p_oWaiters.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            bool bIsClosed = IsClosed();
+            bool bResult = !bIsClosed && p_fAttempt();
+            if (!bIsClosed && !bResult)
+            {
+                FutexWait(&p_oEpoch, uiEpoch, true);
+            }
+            p_oWaiters.fetch_sub(1);
+            if (bIsClosed || bResult)
+            {
+                return bResult;
+            }
+        }
+    }
+
+    static void WakeUpOne(std::atomic<std::uint32_t> &p_oEpoch, std::atomic<std::uint32_t> &p_oWaiters)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (p_oWaiters.load(std::memory_order_relaxed) > 0)
+        {
+            p_oEpoch.fetch_add(1);
+            FutexWake(&p_oEpoch, 1, true);
+        }
+    }
+
+    std::string m_strName;
+    bool m_bIsOwner;
+    void *m_pMapping{nullptr};
+    std::size_t m_sMappingSize{0};
+    Header *m_pHeader{nullptr};
+    Slot *m_pSlots{nullptr};
+    std::uint64_t m_ullMask{0};
+};
\ No newline at end of file
@@ -1,19 +1,57 @@
 #pragma once
 
 //!
+#include <atomic>
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
 
 //! Threading
 #include <mutex>
-#include <condition_variable>
+#include <thread>
 
 //! Channel Interface
 #include "IChannel.h"
+#include "Futex.h"
 
-template <typename T>
+//! Instrumentation
+#include "Metrics.h"
+#include "Tracing.h"
+
+/*
+    - One value slot , a Send blocks while the slot is taken
+    - Go runtime style wait queues : every parked reader / writer owns a waiter on its own stack
+    - a Send finding a parked reader constructs the value straight in that reader's storage and wakes only that reader
+      the reader owns the value when it wakes up , no re lock , no re check , no thundering herd
+    - a Read taking the slot refills it from the first parked writer and wakes only that writer
+*/
+
+//! Questions / Edgecases:
+//! Q: Why keep the slot at all , Go doesn't ?
+//!     a Send still returns as soon as the value is stored (it doesn't wait for a reader) , selectors / TryReadValue read from that slot
+//! Q: Parked readers and a full slot at the same time ?
+//!     never , readers only park on an empty slot and senders hand off to them before filling it
+//!     the same way writers only park on a full slot
+//! Q: Who wakes a waiter ?
+//!     whoever completes its operation , it flips the waiter state and only calls futex wake if the waiter went to sleep (not while it spins)
+//!     the waiter may return as soon as it sees the new state , a late wake on its (gone) stack address is just a spurious wake for whoever reuses it
+
+//! Allocator is only used for the listeners bookkeeping, the value itself lives inline in the channel
+template <typename T, typename Allocator = std::allocator<T>>
 class UnBufferedChannel : public IChannel<T>
 {
 public:
+    UnBufferedChannel() = default;
+    explicit UnBufferedChannel(const Allocator &p_oAllocator)
+        : m_oOnDataAvailableListeners(ListenersAllocator(p_oAllocator)),
+          m_oOnCloseListeners(ListenersAllocator(p_oAllocator))
+    {
+    }
+
     //! Block till any previous values are Read
     //! this should block caller till some other thread read any previously store values
     //! this should be called by writer / producer thread
@@ -31,43 +69,73 @@ public:
 
     bool SendValue(T &p_tValue, bool p_bMove)
     {
-        //! Lock is released after updating internal state
+        if (p_bMove)
+        {
+            //! Move value set by Writer / producer thread
+            return Emplace(std::move(p_tValue));
+        }
+        else if constexpr (std::is_copy_constructible_v<T>)
+        {
+            //! Copy
+            return Emplace(static_cast<const T &>(p_tValue));
+        }
+        else
+        {
+            throw std::logic_error("Cannot Copy a move only value into an UnBufferedChannel, send it as T&&");
+        }
+    }
+
+    //! Same as SendValue , but the value is constructed from p_args right where it is going (parked reader or slot)
+    //! if T's constructor throws the exception propagates and the channel is unchanged (a parked reader stays parked)
+    template <typename... Args>
+    bool Emplace(Args &&...p_args)
+    {
+        //! Lock is released before waking / notifying
         //! This is important cause of the callback that we call (user defined code)
         //! What if that user code uses that same channel again to Send while we are holding mutex!!
         //! => Deadlock || Undefined behaviour cause of multiple locking within same thread
-        //! So we release lock
-        //! Also this minimized suprios wakeups on the Consumer threads
+        std::unique_lock<std::mutex> oLock{m_oMutex};
+        if (m_bIsTerminationRequested)
         {
-            std::unique_lock<std::mutex> lock{m_oMutex};
-
-            //! Block producers until previous value is consumed
-            m_oSendCv.wait(lock, [this]()
-                           { return !m_bIsValueRecieved || m_bIsTerminationRequested; });
-
-            if (m_bIsTerminationRequested)
+            return false;
+        }
+        if (Waiter *pReceiver = m_oParkedReceivers.Front())
+        {
+            //! Direct handoff , the slot is never touched and no listener has to know
+            //! constructed before the receiver leaves the queue , a throwing constructor leaves it parked (optional still empty)
+            pReceiver->m_pValue->emplace(std::forward<Args>(p_args)...);
+            m_oParkedReceivers.Pop();
+            CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oEnqueued.Add();)
+            oLock.unlock();
+            Wake(*pReceiver, s_uiHandedOff);
+            CONCURRENCY_LIB_TRACE("Channel::Send", TracePhase::Instant, reinterpret_cast<unsigned long long>(this));
+            return true;
+        }
+        if (!m_oRecievedValue.has_value())
+        {
+            m_oRecievedValue.emplace(std::forward<Args>(p_args)...);
+            CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oEnqueued.Add();)
+            CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oHighWaterMark.Update(1);)
+            oLock.unlock();
+        }
+        else
+        {
+            //! Slot taken , park with our own value , the reader emptying the slot moves it in and wakes us
+            std::optional<T> oValue{std::in_place, std::forward<Args>(p_args)...};
+            Waiter oSender{&oValue};
+            m_oParkedSenders.Push(&oSender);
+            oLock.unlock();
+            constexpr bool bIsSender = true;
+            if (!Park(oSender, bIsSender))
             {
                 return false;
             }
-            if (p_bMove)
-            {
-                //! Move value set by Writer / producer thread
-                m_tRecievedValue = std::move(p_tValue);
-            }
-            else
-            {
-                //! Copy
-                m_tRecievedValue = p_tValue;
-            }
-
-            m_bIsValueRecieved = true;
         }
-        m_oRecieveCv.notify_one();
 
         //! Notify that Data Available
         //! this happens within the context of the thread that creates and puts it on the channel (Producer)
-        //! Lock is release before calling it , to avoid deadlocks
         NotifyOnDataAvailableListeners();
-
+        CONCURRENCY_LIB_TRACE("Channel::Send", TracePhase::Instant, reinterpret_cast<unsigned long long>(this));
         return true;
     }
 
@@ -76,51 +144,48 @@ public:
     //! this should be called by reader / consumer thread
     virtual bool ReadValue(T &p_tValue) override
     {
-        {
-            std::unique_lock<std::mutex> lock{m_oMutex};
-            //! Block consumers till a value is written
-            m_oRecieveCv.wait(lock, [this]()
-                              { return m_bIsValueRecieved || m_bIsTerminationRequested; });
+        constexpr bool bIsBlocking = true;
+        return Read(p_tValue, bIsBlocking);
+    }
 
-            //! Channel was cleared
-            //! Consume and reset
-            if (m_bIsTerminationRequested)
-            {
-                Reset();
-                return false;
-            }
+    virtual bool TryReadValue(T &p_tValue) override
+    {
+        constexpr bool bIsBlocking = false;
+        return Read(p_tValue, bIsBlocking);
+    }
 
-            //! Consume and reset
-            p_tValue = m_tRecievedValue;
-            Reset();
-        }
-        m_oSendCv.notify_one();
-        return true;
+    virtual bool ReadValue(std::optional<T> &p_oValue) override
+    {
+        constexpr bool bIsBlocking = true;
+        return Read(p_oValue, bIsBlocking);
     }
 
-    virtual bool TryReadValue(T &p_tValue) override
+    virtual bool TryReadValue(std::optional<T> &p_oValue) override
     {
-        {
-            std::lock_guard<std::mutex> oLock{m_oMutex};
-            if (m_bIsTerminationRequested || !m_bIsValueRecieved)
-            {
-                return false;
-            }
-            p_tValue = m_tRecievedValue;
-            Reset();
-        }
-        m_oSendCv.notify_one();
-        return true;
+        constexpr bool bIsBlocking = false;
+        return Read(p_oValue, bIsBlocking);
     }
 
     virtual void Close() override
     {
+        Waiter *pReceivers = nullptr;
+        Waiter *pSenders = nullptr;
         {
             std::lock_guard<std::mutex> lock{m_oMutex};
             m_bIsTerminationRequested = true;
+            pReceivers = m_oParkedReceivers.TakeAll();
+            pSenders = m_oParkedSenders.TakeAll();
+        }
+        for (Waiter *pWaiters : {pReceivers, pSenders})
+        {
+            while (pWaiters != nullptr)
+            {
+                //! Read next before waking , the waiter is gone right after
+                Waiter *pNext = pWaiters->m_pNext;
+                Wake(*pWaiters, s_uiClosed);
+                pWaiters = pNext;
+            }
         }
-        m_oRecieveCv.notify_all();
-        m_oSendCv.notify_all();
         NotifyOnCloseListeners();
     }
 
@@ -129,6 +194,14 @@ public:
         Close();
     }
 
+    //! All zeros unless built with CONCURRENCY_LIB_METRICS
+    ChannelMetricsSnapshot GetMetricsSnapshot() const
+    {
+        ChannelMetricsSnapshot oSnapshot;
+        CONCURRENCY_LIB_METRICS_ONLY(oSnapshot = m_oMetrics.Snapshot();)
+        return oSnapshot;
+    }
+
 protected:
     virtual unsigned long long RegisterChannelOperationsListener(
         std::function<void(void)> p_fOnDataAvailableCallback,
@@ -144,6 +217,9 @@ protected:
 
     virtual void UnRegisterChannelOperationsListener(int p_iId) override
     {
+        //! Producers may be iterating the listeners (Notify*) at the same time
+        //! holding the lock also guarantees that once we return , the removed listener is not being executed anymore
+        std::lock_guard<std::mutex> oLock{m_oListenersMutex};
         m_oOnDataAvailableListeners.erase(p_iId);
         m_oOnCloseListeners.erase(p_iId);
     }
@@ -166,27 +242,201 @@ private:
         }
     }
 
+    //! p_oOutput is either a T& or an std::optional<T>& , the value is moved out of the channel in both cases
+    template <typename Output>
+    bool Read(Output &p_oOutput, bool p_bIsBlocking)
+    {
+        std::unique_lock<std::mutex> oLock{m_oMutex};
+        //! Channel was cleared
+        if (m_bIsTerminationRequested)
+        {
+            return false;
+        }
+        if (m_oRecievedValue.has_value())
+        {
+            //! Consume and reset , then refill from the first parked writer
+            MoveValueOut(p_oOutput, m_oRecievedValue);
+            Reset();
+            Waiter *pSender = m_oParkedSenders.Front();
+            if (pSender != nullptr)
+            {
+                //! Same as the handoff in Emplace , the writer only leaves the queue once its value is in the slot
+                m_oRecievedValue.emplace(std::move(**pSender->m_pValue));
+                m_oParkedSenders.Pop();
+                CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oEnqueued.Add();)
+            }
+            CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oDequeued.Add();)
+            oLock.unlock();
+            if (pSender != nullptr)
+            {
+                Wake(*pSender, s_uiHandedOff);
+            }
+            CONCURRENCY_LIB_TRACE("Channel::Receive", TracePhase::Instant, reinterpret_cast<unsigned long long>(this));
+            return true;
+        }
+        if (!p_bIsBlocking)
+        {
+            return false;
+        }
+
+        //! Park , a sender constructs the value right in our storage
+        std::optional<T> oValue;
+        std::optional<T> *pStorage = &oValue;
+        if constexpr (std::is_same_v<Output, std::optional<T>>)
+        {
+            pStorage = &p_oOutput;
+        }
+        Waiter oReceiver{pStorage};
+        m_oParkedReceivers.Push(&oReceiver);
+        oLock.unlock();
+        constexpr bool bIsSender = false;
+        if (!Park(oReceiver, bIsSender))
+        {
+            return false;
+        }
+        if (pStorage == &oValue)
+        {
+            MoveValueOut(p_oOutput, oValue);
+        }
+        CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oDequeued.Add();)
+        CONCURRENCY_LIB_TRACE("Channel::Receive", TracePhase::Instant, reinterpret_cast<unsigned long long>(this));
+        return true;
+    }
+
+    static void MoveValueOut(T &p_tValue, std::optional<T> &p_oSource)
+    {
+        p_tValue = std::move(*p_oSource);
+    }
+
+    static void MoveValueOut(std::optional<T> &p_oValue, std::optional<T> &p_oSource)
+    {
+        p_oValue.emplace(std::move(*p_oSource));
+    }
+
+    //! A parked reader / writer , lives on its own stack while parked
+    struct Waiter
+    {
+        //! reader : where the sender constructs the value , writer : the value waiting to be moved into the slot
+        std::optional<T> *m_pValue;
+        std::atomic<std::uint32_t> m_uiState{s_uiWaiting};
+        Waiter *m_pNext{nullptr};
+    };
+
+    //! Intrusive FIFO of parked waiters , guarded by the channel mutex
+    struct WaitQueue
+    {
+        void Push(Waiter *p_pWaiter)
+        {
+            if (m_pTail == nullptr)
+            {
+                m_pHead = p_pWaiter;
+            }
+            else
+            {
+                m_pTail->m_pNext = p_pWaiter;
+            }
+            m_pTail = p_pWaiter;
+        }
+
+        Waiter *Front() const
+        {
+            return m_pHead;
+        }
+
+        Waiter *Pop()
+        {
+            Waiter *pWaiter = m_pHead;
+            if (pWaiter != nullptr)
+            {
+                m_pHead = pWaiter->m_pNext;
+                if (m_pHead == nullptr)
+                {
+                    m_pTail = nullptr;
+                }
+            }
+            return pWaiter;
+        }
+
+        Waiter *TakeAll()
+        {
+            Waiter *pWaiters = m_pHead;
+            m_pHead = nullptr;
+            m_pTail = nullptr;
+            return pWaiters;
+        }
+
+        Waiter *m_pHead{nullptr};
+        Waiter *m_pTail{nullptr};
+    };
+
+    //! Spin a little (the other side is often about to come) then sleep on the waiter own futex word
+    //! true if the operation was completed by the other side , false if the channel was closed
+    bool Park(Waiter &p_oWaiter, bool p_bIsSender)
+    {
+        (void)p_bIsSender;
+        CONCURRENCY_LIB_METRICS_ONLY(MetricsClock::time_point oStart = MetricsClock::now();)
+        std::uint32_t uiState = p_oWaiter.m_uiState.load(std::memory_order_acquire);
+        for (int iSpin = 0; iSpin < s_iSpinsBeforeBlocking && uiState == s_uiWaiting; ++iSpin)
+        {
+            std::this_thread::yield();
+            uiState = p_oWaiter.m_uiState.load(std::memory_order_acquire);
+        }
+        if (uiState == s_uiWaiting && p_oWaiter.m_uiState.compare_exchange_strong(uiState, s_uiSleeping, std::memory_order_acq_rel))
+        {
+            uiState = s_uiSleeping;
+            while (uiState == s_uiSleeping)
+            {
+                FutexWait(&p_oWaiter.m_uiState, s_uiSleeping);
+                uiState = p_oWaiter.m_uiState.load(std::memory_order_acquire);
+            }
+        }
+        CONCURRENCY_LIB_METRICS_ONLY((p_bIsSender ? m_oMetrics.m_oSendBlockTime : m_oMetrics.m_oReceiveBlockTime).Record(MetricsElapsedNanoseconds(oStart));)
+        return uiState == s_uiHandedOff;
+    }
+
+    static void Wake(Waiter &p_oWaiter, std::uint32_t p_uiState)
+    {
+        //! Only pay the syscall if the waiter stopped spinning and went to sleep
+        if (p_oWaiter.m_uiState.exchange(p_uiState, std::memory_order_acq_rel) == s_uiSleeping)
+        {
+            FutexWake(&p_oWaiter.m_uiState, 1);
+        }
+    }
+
     void Reset()
     {
-        m_bIsValueRecieved = false;
+        m_oRecievedValue.reset();
         //! No Resetting to Termination Flag
         //! a Closed Channel cannot be reused For NOW
         // m_bIsTerminationRequested = false;
     }
 
-    //! Value received on the channel
-    T m_tRecievedValue;
-    bool m_bIsValueRecieved{false};
+    //! Value received on the channel , optional so T doesn't have to be default constructible
+    std::optional<T> m_oRecievedValue;
     bool m_bIsTerminationRequested{false};
 
+    //! Waiter states
+    static constexpr std::uint32_t s_uiWaiting = 0;
+    static constexpr std::uint32_t s_uiSleeping = 1;
+    static constexpr std::uint32_t s_uiHandedOff = 2;
+    static constexpr std::uint32_t s_uiClosed = 3;
+    static constexpr int s_iSpinsBeforeBlocking = 64;
+
     //! Synchronization
-    std::condition_variable m_oSendCv;    //! for producers
-    std::condition_variable m_oRecieveCv; //! for consumers
     std::mutex m_oMutex;
+    WaitQueue m_oParkedSenders;   //! only while the slot is taken
+    WaitQueue m_oParkedReceivers; //! only while the slot is empty
 
     //! Listeners for Channel operations
     std::mutex m_oListenersMutex;
-    std::map<int, std::function<void(void)>> m_oOnDataAvailableListeners;
-    std::map<int, std::function<void(void)>> m_oOnCloseListeners;
+    using ListenersAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<std::pair<const int, std::function<void(void)>>>;
+    using ListenersMap = std::map<int, std::function<void(void)>, std::less<int>, ListenersAllocator>;
+    ListenersMap m_oOnDataAvailableListeners;
+    ListenersMap m_oOnCloseListeners;
     unsigned long long m_iID{0};
-};
\ No newline at end of file
+
+    CONCURRENCY_LIB_METRICS_ONLY(ChannelMetrics m_oMetrics;)
+};
+
+template <typename T>
+using PmrUnBufferedChannel = UnBufferedChannel<T, std::pmr::polymorphic_allocator<T>>;
\ No newline at end of file
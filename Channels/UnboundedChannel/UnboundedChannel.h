@@ -0,0 +1,427 @@
+#pragma once
+
+//! System includes
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+
+//! Threading
+#include <mutex>
+#include <condition_variable>
+
+//! Channel Interface
+#include "IChannel.h"
+
+//! Instrumentation
+#include "Metrics.h"
+#include "Tracing.h"
+
+/*
+    - Unbounded channel for bursty producers (log ingestion ..) , Send never blocks
+    - Values live in a linked list of fixed size array segments , consumed segments are recycled through a free list
+    - Producers and consumers never share a lock : producers lock the tail segment , consumers the head one (two locks queue)
+      they only meet on per segment atomic counters
+    - Optional soft high water mark : a callback is raised when the backlog crosses it , producers are never blocked
+    - Same IChannel<T> interface (listeners included) and Close semantics as BufferedChannel
+*/
+
+//! Questions / Edgecases:
+//! Q: Lock free ?
+//!     Not fully , producers serialize on the tail lock and consumers on the head lock , but a producer never waits for a consumer (nor the other way)
+//!     and there is no allocation on the steady state path (segments come back from the free list)
+//! Q: When is the high water callback raised ?
+//!     in the producer crossing the mark , once , it is raised again only after the backlog went back under half the mark
+//! Q: When can a consumed segment be recycled ?
+//!     once the producer linked the next one , after that the producer never touches it again
+
+template <typename T, std::size_t SegmentSize = 256>
+class UnboundedChannel : public IChannel<T>
+{
+    static_assert(SegmentSize > 0, "UnboundedChannel segments need at least one slot");
+
+public:
+    //! p_fOnHighWaterMark(backlog) is called from a producer when the backlog reaches p_sSoftHighWaterMark (0 : never)
+    //! at most p_sMaxFreeSegments consumed segments are kept for reuse , the others are freed
+    explicit UnboundedChannel(std::size_t p_sSoftHighWaterMark = 0,
+                              std::function<void(std::size_t)> p_fOnHighWaterMark = nullptr,
+                              std::size_t p_sMaxFreeSegments = 16)
+        : m_sSoftHighWaterMark(p_sSoftHighWaterMark),
+          m_fOnHighWaterMark(std::move(p_fOnHighWaterMark)),
+          m_sMaxFreeSegments(p_sMaxFreeSegments)
+    {
+        m_pHead = new Segment();
+        m_pTail = m_pHead;
+    }
+
+    UnboundedChannel(const UnboundedChannel &) = delete;
+    UnboundedChannel &operator=(const UnboundedChannel &) = delete;
+
+    ~UnboundedChannel()
+    {
+        Close();
+        //! Destroy values never read , then every segment
+        for (Segment *pSegment = m_pHead; pSegment != nullptr;)
+        {
+            std::size_t sWritten = pSegment->m_sCommitted.load(std::memory_order_acquire);
+            for (std::size_t sSlot = pSegment->m_sReadIndex; sSlot < sWritten; ++sSlot)
+            {
+                pSegment->Slot(sSlot)->~T();
+            }
+            Segment *pNext = pSegment->m_pNext.load(std::memory_order_acquire);
+            delete pSegment;
+            pSegment = pNext;
+        }
+        while (m_pFreeSegments != nullptr)
+        {
+            Segment *pNext = m_pFreeSegments->m_pNext.load(std::memory_order_relaxed);
+            delete m_pFreeSegments;
+            m_pFreeSegments = pNext;
+        }
+    }
+
+    virtual bool SendValue(T &&p_tValue) override
+    {
+        return Emplace(std::move(p_tValue));
+    }
+
+    virtual bool SendValue(T &p_tValue) override
+    {
+        if constexpr (std::is_copy_constructible_v<T>)
+        {
+            return Emplace(static_cast<const T &>(p_tValue));
+        }
+        else
+        {
+            throw std::logic_error("Cannot Copy a move only value into an UnboundedChannel, send it as T&&");
+        }
+    }
+
+    //! Never blocks , the value is constructed in the tail segment , false once closed
+    template <typename... Args>
+    bool Emplace(Args &&...p_args)
+    {
+        if (m_bIsTerminated.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        std::size_t sBacklog = 0;
+        {
+            std::lock_guard<std::mutex> oLock{m_oTailMutex};
+            Segment *pTail = m_pTail;
+            if (pTail->m_sWriteIndex == SegmentSize)
+            {
+                Segment *pNewTail = AcquireSegment();
+                //! The old tail is never touched again by producers once linked , consumers may recycle it
+                pTail->m_pNext.store(pNewTail, std::memory_order_release);
+                m_pTail = pNewTail;
+                pTail = pNewTail;
+            }
+            new (pTail->Slot(pTail->m_sWriteIndex)) T(std::forward<Args>(p_args)...);
+            pTail->m_sWriteIndex++;
+            //! Counted before publishing , so a consumer never decrements it first
+            sBacklog = m_sSize.fetch_add(1, std::memory_order_relaxed) + 1;
+            pTail->m_sCommitted.store(pTail->m_sWriteIndex, std::memory_order_release);
+        }
+        CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oEnqueued.Add();)
+        CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oHighWaterMark.Update(sBacklog);)
+        CheckHighWaterMark(sBacklog);
+
+        //! Wake a sleeping consumer , only if there is one
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_iSleepingConsumers.load(std::memory_order_relaxed) > 0)
+        {
+            std::lock_guard<std::mutex> oLock{m_oConsumersMutex};
+            m_oConsumersCv.notify_one();
+        }
+        if (m_bHasListeners.load(std::memory_order_acquire))
+        {
+            NotifyOnDataAvailableListeners();
+        }
+        CONCURRENCY_LIB_TRACE("Channel::Send", TracePhase::Instant, reinterpret_cast<unsigned long long>(this));
+        return true;
+    }
+
+    virtual bool ReadValue(T &p_tValue) override
+    {
+        constexpr bool bIsBlocking = true;
+        return Read(p_tValue, bIsBlocking);
+    }
+
+    virtual bool TryReadValue(T &p_tValue) override
+    {
+        constexpr bool bIsBlocking = false;
+        return Read(p_tValue, bIsBlocking);
+    }
+
+    virtual bool ReadValue(std::optional<T> &p_oValue) override
+    {
+        constexpr bool bIsBlocking = true;
+        return Read(p_oValue, bIsBlocking);
+    }
+
+    virtual bool TryReadValue(std::optional<T> &p_oValue) override
+    {
+        constexpr bool bIsBlocking = false;
+        return Read(p_oValue, bIsBlocking);
+    }
+
+    virtual void Close() override
+    {
+        m_bIsTerminated.store(true, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> oLock{m_oConsumersMutex};
+            m_oConsumersCv.notify_all();
+        }
+        NotifyOnCloseListeners();
+    }
+
+    //! Values sent and not read yet (approximate while producers / consumers are running)
+    std::size_t GetBacklog() const
+    {
+        return m_sSize.load(std::memory_order_relaxed);
+    }
+
+    //! All zeros unless built with CONCURRENCY_LIB_METRICS
+    ChannelMetricsSnapshot GetMetricsSnapshot() const
+    {
+        ChannelMetricsSnapshot oSnapshot;
+        CONCURRENCY_LIB_METRICS_ONLY(oSnapshot = m_oMetrics.Snapshot();)
+        return oSnapshot;
+    }
+
+protected:
+    virtual unsigned long long RegisterChannelOperationsListener(
+        std::function<void(void)> p_fOnDataAvailableCallback,
+        std::function<void(void)> p_fOnCloseAvailableCallback) override
+    {
+        std::lock_guard<std::mutex> oLock{m_oListenersMutex};
+        unsigned long long iIdToUse = m_iID;
+        m_oOnDataAvailableListeners[iIdToUse] = std::move(p_fOnDataAvailableCallback);
+        m_oOnCloseListeners[iIdToUse] = std::move(p_fOnCloseAvailableCallback);
+        m_iID++;
+        m_bHasListeners.store(true, std::memory_order_release);
+        return iIdToUse;
+    }
+
+    virtual void UnRegisterChannelOperationsListener(int p_iId) override
+    {
+        //! Producers may be iterating the listeners (Notify*) at the same time
+        //! holding the lock also guarantees that once we return , the removed listener is not being executed anymore
+        std::lock_guard<std::mutex> oLock{m_oListenersMutex};
+        m_oOnDataAvailableListeners.erase(p_iId);
+        m_oOnCloseListeners.erase(p_iId);
+        m_bHasListeners.store(!m_oOnDataAvailableListeners.empty(), std::memory_order_release);
+    }
+
+private:
+    struct Segment
+    {
+        T *Slot(std::size_t p_sIndex)
+        {
+            return std::launder(reinterpret_cast<T *>(&m_arrStorage[p_sIndex * sizeof(T)]));
+        }
+
+        alignas(T) std::byte m_arrStorage[SegmentSize * sizeof(T)];
+        //! Producers side , guarded by the tail lock
+        std::size_t m_sWriteIndex{0};
+        //! Consumers side , guarded by the head lock
+        alignas(64) std::size_t m_sReadIndex{0};
+        //! Slots constructed so far , published by producers to consumers
+        alignas(64) std::atomic<std::size_t> m_sCommitted{0};
+        std::atomic<Segment *> m_pNext{nullptr};
+    };
+
+    //! Tail lock is held
+    Segment *AcquireSegment()
+    {
+        {
+            std::lock_guard<std::mutex> oLock{m_oFreeSegmentsMutex};
+            if (m_pFreeSegments != nullptr)
+            {
+                Segment *pSegment = m_pFreeSegments;
+                m_pFreeSegments = pSegment->m_pNext.load(std::memory_order_relaxed);
+                m_sFreeSegmentsCount--;
+                pSegment->m_sWriteIndex = 0;
+                pSegment->m_sReadIndex = 0;
+                pSegment->m_sCommitted.store(0, std::memory_order_relaxed);
+                pSegment->m_pNext.store(nullptr, std::memory_order_relaxed);
+                return pSegment;
+            }
+        }
+        return new Segment();
+    }
+
+    //! Head lock is held , p_pSegment was fully read and the producers already moved past it
+    void RecycleSegment(Segment *p_pSegment)
+    {
+        {
+            std::lock_guard<std::mutex> oLock{m_oFreeSegmentsMutex};
+            if (m_sFreeSegmentsCount < m_sMaxFreeSegments)
+            {
+                p_pSegment->m_pNext.store(m_pFreeSegments, std::memory_order_relaxed);
+                m_pFreeSegments = p_pSegment;
+                m_sFreeSegmentsCount++;
+                return;
+            }
+        }
+        delete p_pSegment;
+    }
+
+    //! p_oOutput is either a T& or an std::optional<T>&
+    template <typename Output>
+    bool Read(Output &p_oOutput, bool p_bIsBlocking)
+    {
+        while (true)
+        {
+            if (m_bIsTerminated.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+            if (TryPop(p_oOutput))
+            {
+                return true;
+            }
+            if (!p_bIsBlocking)
+            {
+                return false;
+            }
+            //! Looked empty , announce ourselves then check again before sleeping
+            std::unique_lock<std::mutex> oLock{m_oConsumersMutex};
+            m_iSleepingConsumers.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            bool bIsTerminated = m_bIsTerminated.load(std::memory_order_acquire);
+            bool bResult = !bIsTerminated && TryPop(p_oOutput);
+            if (!bResult && !bIsTerminated)
+            {
+                CONCURRENCY_LIB_METRICS_ONLY(MetricsClock::time_point oStart = MetricsClock::now();)
+                m_oConsumersCv.wait(oLock);
+                CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oReceiveBlockTime.Record(MetricsElapsedNanoseconds(oStart));)
+            }
+            m_iSleepingConsumers.fetch_sub(1);
+            if (bResult)
+            {
+                return true;
+            }
+        }
+    }
+
+    template <typename Output>
+    bool TryPop(Output &p_oOutput)
+    {
+        {
+            std::lock_guard<std::mutex> oLock{m_oHeadMutex};
+            while (true)
+            {
+                Segment *pHead = m_pHead;
+                if (pHead->m_sReadIndex < pHead->m_sCommitted.load(std::memory_order_acquire))
+                {
+                    T *pValue = pHead->Slot(pHead->m_sReadIndex);
+                    MoveValueOut(p_oOutput, *pValue);
+                    pValue->~T();
+                    pHead->m_sReadIndex++;
+                    break;
+                }
+                Segment *pNext = pHead->m_pNext.load(std::memory_order_acquire);
+                if (pHead->m_sReadIndex < SegmentSize || pNext == nullptr)
+                {
+                    //! Empty
+                    return false;
+                }
+                //! Fully read and producers moved on
+                m_pHead = pNext;
+                RecycleSegment(pHead);
+            }
+        }
+        std::size_t sBacklog = m_sSize.fetch_sub(1, std::memory_order_relaxed) - 1;
+        if (sBacklog < m_sSoftHighWaterMark / 2)
+        {
+            m_bIsAboveHighWaterMark.store(false, std::memory_order_relaxed);
+        }
+        CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oDequeued.Add();)
+        CONCURRENCY_LIB_TRACE("Channel::Receive", TracePhase::Instant, reinterpret_cast<unsigned long long>(this));
+        return true;
+    }
+
+    void CheckHighWaterMark(std::size_t p_sBacklog)
+    {
+        if (m_sSoftHighWaterMark == 0 || p_sBacklog < m_sSoftHighWaterMark ||
+            m_bIsAboveHighWaterMark.load(std::memory_order_relaxed) ||
+            m_bIsAboveHighWaterMark.exchange(true, std::memory_order_relaxed))
+        {
+            return;
+        }
+        if (m_fOnHighWaterMark)
+        {
+            m_fOnHighWaterMark(p_sBacklog);
+        }
+    }
+
+    static void MoveValueOut(T &p_tValue, T &p_tSource)
+    {
+        p_tValue = std::move(p_tSource);
+    }
+
+    static void MoveValueOut(std::optional<T> &p_oValue, T &p_tSource)
+    {
+        p_oValue.emplace(std::move(p_tSource));
+    }
+
+    void NotifyOnDataAvailableListeners()
+    {
+        std::lock_guard<std::mutex> oLock{m_oListenersMutex};
+        for (auto &entry : m_oOnDataAvailableListeners)
+        {
+            entry.second();
+        }
+    }
+    void NotifyOnCloseListeners()
+    {
+        std::lock_guard<std::mutex> oLock{m_oListenersMutex};
+        for (auto &entry : m_oOnCloseListeners)
+        {
+            entry.second();
+        }
+    }
+
+    //! Consumers side
+    alignas(64) std::mutex m_oHeadMutex;
+    Segment *m_pHead{nullptr};
+
+    //! Producers side
+    alignas(64) std::mutex m_oTailMutex;
+    Segment *m_pTail{nullptr};
+
+    alignas(64) std::atomic<std::size_t> m_sSize{0};
+    std::atomic<bool> m_bIsTerminated{false};
+
+    //! Soft high water mark
+    std::size_t m_sSoftHighWaterMark;
+    std::function<void(std::size_t)> m_fOnHighWaterMark;
+    std::atomic<bool> m_bIsAboveHighWaterMark{false};
+
+    //! Recycled segments
+    std::mutex m_oFreeSegmentsMutex;
+    Segment *m_pFreeSegments{nullptr};
+    std::size_t m_sFreeSegmentsCount{0};
+    std::size_t m_sMaxFreeSegments;
+
+    //! Only used when the channel is empty
+    std::mutex m_oConsumersMutex;
+    std::condition_variable m_oConsumersCv;
+    std::atomic<int> m_iSleepingConsumers{0};
+
+    //! Listeners for Channel operations , producers skip the lock while there is none
+    std::mutex m_oListenersMutex;
+    std::atomic<bool> m_bHasListeners{false};
+    std::map<int, std::function<void(void)>> m_oOnDataAvailableListeners;
+    std::map<int, std::function<void(void)>> m_oOnCloseListeners;
+    unsigned long long m_iID{0};
+
+    CONCURRENCY_LIB_METRICS_ONLY(ChannelMetrics m_oMetrics;)
+};
\ No newline at end of file
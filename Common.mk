@@ -1,14 +1,72 @@
 CXX := g++
-CXXFLAGS := -Wall -Wextra -g -O0 -std=c++17 -MMD -MP
+AR := ar
 
 # CONCURRENCY_LIB_PATH is defined by the includer of this make file
 
+#! Build variants :
+#!   make BUILD=debug|release|tsan|asan   (default debug)
+#!   LTO=1                                 link time optimization
+#!   PGO=generate|use                      profile guided optimization , build with generate , run a representative workload
+#!                                         (make benchmarks for example) then rebuild everything with use
+#!   METRICS=1 , TRACING=1                 instrumentation (see Instrumentation/), has to match between the library and its users
+BUILD ?= debug
+
+ifeq ($(BUILD),debug)
+BUILD_FLAGS := -g -O0
+else ifeq ($(BUILD),release)
+BUILD_FLAGS := -O3 -march=native -DNDEBUG
+else ifeq ($(BUILD),tsan)
+BUILD_FLAGS := -g -O1 -fsanitize=thread
+else ifeq ($(BUILD),asan)
+BUILD_FLAGS := -g -O1 -fno-omit-frame-pointer -fsanitize=address,undefined
+else
+$(error Unknown BUILD=$(BUILD), expected debug, release, tsan or asan)
+endif
+
+ifeq ($(LTO),1)
+BUILD_FLAGS += -flto=auto
+endif
+
+PGO_DIR ?= $(abspath $(CONCURRENCY_LIB_PATH))/build/pgo
+ifeq ($(PGO),generate)
+BUILD_FLAGS += -fprofile-generate=$(PGO_DIR)
+else ifeq ($(PGO),use)
+BUILD_FLAGS += -fprofile-use=$(PGO_DIR) -fprofile-correction -Wno-missing-profile
+endif
+
+ifeq ($(METRICS),1)
+BUILD_FLAGS += -DCONCURRENCY_LIB_METRICS
+endif
+ifeq ($(TRACING),1)
+BUILD_FLAGS += -DCONCURRENCY_LIB_TRACING
+endif
+
+CXXFLAGS := -Wall -Wextra -std=c++17 -MMD -MP -pthread $(BUILD_FLAGS)
+LDFLAGS := -pthread $(BUILD_FLAGS)
+
 THREAD_PATH := $(CONCURRENCY_LIB_PATH)/Thread
 CHANNELS_PATH := $(CONCURRENCY_LIB_PATH)/Channels/
 UnBufferedChannelPath := $(CONCURRENCY_LIB_PATH)/Channels/UnBufferedChannel
 BufferedChannelPath := $(CONCURRENCY_LIB_PATH)/Channels/BufferedChannel
 ChannelSelectorPath := $(CONCURRENCY_LIB_PATH)/Channels/ChannelSelector
+ChannelPoolPath := $(CONCURRENCY_LIB_PATH)/Channels/ChannelPool
+BroadcastChannelPath := $(CONCURRENCY_LIB_PATH)/Channels/BroadcastChannel
+SharedMemoryChannelPath := $(CONCURRENCY_LIB_PATH)/Channels/SharedMemoryChannel
+ByteStreamChannelPath := $(CONCURRENCY_LIB_PATH)/Channels/ByteStreamChannel
+ShardedChannelPath := $(CONCURRENCY_LIB_PATH)/Channels/ShardedChannel
+UnboundedChannelPath := $(CONCURRENCY_LIB_PATH)/Channels/UnboundedChannel
+ConflatingChannelPath := $(CONCURRENCY_LIB_PATH)/Channels/ConflatingChannel
+PriorityChannelPath := $(CONCURRENCY_LIB_PATH)/Channels/PriorityChannel
+StaticChannelPath := $(CONCURRENCY_LIB_PATH)/Channels/Channel
+CompactChannelPath := $(CONCURRENCY_LIB_PATH)/Channels/CompactChannel
 ACTORS_PATH = $(CONCURRENCY_LIB_PATH)/Actors/
+TASKS_PATH := $(CONCURRENCY_LIB_PATH)/Tasks
+THREAD_POOLS_PATH := $(CONCURRENCY_LIB_PATH)/ThreadPools
+PIPELINES_PATH := $(CONCURRENCY_LIB_PATH)/Pipelines
+SEMAPHORES_PATH := $(CONCURRENCY_LIB_PATH)/Semaphores
+INSTRUMENTATION_PATH := $(CONCURRENCY_LIB_PATH)/Instrumentation
+ASYNC_IO_PATH := $(CONCURRENCY_LIB_PATH)/AsyncIO
+BENCHMARKS_PATH := $(CONCURRENCY_LIB_PATH)/Benchmarks
 
 
 CONCURRENCY_LIB_INCLUDES := -I$(CHANNELS_PATH) \
@@ -16,4 +74,32 @@ CONCURRENCY_LIB_INCLUDES := -I$(CHANNELS_PATH) \
 -I$(THREAD_PATH) \
 -I$(BufferedChannelPath) \
 -I$(ChannelSelectorPath) \
+-I$(ChannelPoolPath) \
+-I$(BroadcastChannelPath) \
+-I$(SharedMemoryChannelPath) \
+-I$(ByteStreamChannelPath) \
+-I$(ShardedChannelPath) \
+-I$(UnboundedChannelPath) \
+-I$(ConflatingChannelPath) \
+-I$(PriorityChannelPath) \
+-I$(StaticChannelPath) \
+-I$(CompactChannelPath) \
 -I$(ACTORS_PATH) \
+-I$(TASKS_PATH) \
+-I$(THREAD_POOLS_PATH) \
+-I$(PIPELINES_PATH) \
+-I$(SEMAPHORES_PATH) \
+-I$(INSTRUMENTATION_PATH) \
+-I$(ASYNC_IO_PATH) \
+
+#! Static library, one per build variant so debug / release / sanitizer / instrumented objects never get mixed
+CONCURRENCY_LIB_VARIANT := $(BUILD)$(if $(filter 1,$(LTO)),-lto)$(if $(PGO),-pgo)$(if $(filter 1,$(METRICS)),-metrics)$(if $(filter 1,$(TRACING)),-tracing)
+CONCURRENCY_LIB_BUILD_PATH := $(CONCURRENCY_LIB_PATH)/build/$(CONCURRENCY_LIB_VARIANT)
+CONCURRENCY_LIB := $(CONCURRENCY_LIB_BUILD_PATH)/libconcurrency.a
+CONCURRENCY_LIB_SRCS := $(THREAD_PATH)/Thread.cpp \
+$(CONCURRENCY_LIB_PATH)/Actors/Actor.cpp \
+$(THREAD_POOLS_PATH)/BasicThreadPool.cpp \
+$(THREAD_POOLS_PATH)/Strand.cpp \
+$(THREAD_POOLS_PATH)/TaskGraph.cpp \
+$(ASYNC_IO_PATH)/IoUring.cpp \
+$(ASYNC_IO_PATH)/AsyncFileIO.cpp \
@@ -0,0 +1,243 @@
+#pragma once
+
+//! System includes
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+//! Threading
+#include <condition_variable>
+
+/*
+- Opt in runtime metrics for channels, selector and thread pool
+- Compiled out unless CONCURRENCY_LIB_METRICS is defined (-DCONCURRENCY_LIB_METRICS)
+    - recording code is wrapped in CONCURRENCY_LIB_METRICS_ONLY(...) , so it doesn't exist at all when disabled
+    - snapshot types / GetMetricsSnapshot() always exist so scraping code compiles either way (snapshot is all zeros when disabled)
+- When enabled every counter is sharded, each thread bumps its own cache line with relaxed atomics
+  so recording from many producers doesn't turn into another contention point
+- Reading a snapshot sums the shards , it is not an atomic picture across counters (good enough for scraping)
+*/
+
+#ifdef CONCURRENCY_LIB_METRICS
+#define CONCURRENCY_LIB_METRICS_ONLY(...) __VA_ARGS__
+#else
+#define CONCURRENCY_LIB_METRICS_ONLY(...)
+#endif
+
+using MetricsClock = std::chrono::steady_clock;
+
+constexpr std::size_t METRICS_SHARDS_COUNT = 8;
+//! Bucket i counts durations in [2^i , 2^(i+1)) nanoseconds, last bucket takes everything above
+constexpr std::size_t METRICS_HISTOGRAM_BUCKETS_COUNT = 40;
+
+//! Each thread sticks to one shard for its lifetime
+inline std::size_t MetricsThreadShard()
+{
+    static std::atomic<std::size_t> s_sNextShard{0};
+    thread_local std::size_t s_sShard = s_sNextShard.fetch_add(1, std::memory_order_relaxed) % METRICS_SHARDS_COUNT;
+    return s_sShard;
+}
+
+inline unsigned long long MetricsElapsedNanoseconds(MetricsClock::time_point p_oStart)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(MetricsClock::now() - p_oStart).count();
+}
+
+struct HistogramSnapshot
+{
+    std::array<unsigned long long, METRICS_HISTOGRAM_BUCKETS_COUNT> m_arrBuckets{};
+    unsigned long long m_ullCount{0};
+    unsigned long long m_ullSumNanoseconds{0};
+};
+
+class ShardedCounter
+{
+public:
+    void Add(unsigned long long p_ullValue = 1)
+    {
+        m_arrShards[MetricsThreadShard()].m_ullValue.fetch_add(p_ullValue, std::memory_order_relaxed);
+    }
+
+    unsigned long long Read() const
+    {
+        unsigned long long ullTotal = 0;
+        for (const Shard &oShard : m_arrShards)
+        {
+            ullTotal += oShard.m_ullValue.load(std::memory_order_relaxed);
+        }
+        return ullTotal;
+    }
+
+private:
+    struct alignas(64) Shard
+    {
+        std::atomic<unsigned long long> m_ullValue{0};
+    };
+    std::array<Shard, METRICS_SHARDS_COUNT> m_arrShards;
+};
+
+//! Only written when a new maximum is seen , which is rare after warm up
+class HighWaterMark
+{
+public:
+    void Update(unsigned long long p_ullValue)
+    {
+        unsigned long long ullCurrent = m_ullValue.load(std::memory_order_relaxed);
+        while (p_ullValue > ullCurrent && !m_ullValue.compare_exchange_weak(ullCurrent, p_ullValue, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    unsigned long long Read() const
+    {
+        return m_ullValue.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<unsigned long long> m_ullValue{0};
+};
+
+class LatencyHistogram
+{
+public:
+    void Record(unsigned long long p_ullNanoseconds)
+    {
+        Shard &oShard = m_arrShards[MetricsThreadShard()];
+        oShard.m_arrBuckets[BucketIndex(p_ullNanoseconds)].fetch_add(1, std::memory_order_relaxed);
+        oShard.m_ullSumNanoseconds.fetch_add(p_ullNanoseconds, std::memory_order_relaxed);
+    }
+
+    HistogramSnapshot Read() const
+    {
+        HistogramSnapshot oSnapshot;
+        for (const Shard &oShard : m_arrShards)
+        {
+            for (std::size_t sBucket = 0; sBucket < METRICS_HISTOGRAM_BUCKETS_COUNT; ++sBucket)
+            {
+                unsigned long long ullBucketCount = oShard.m_arrBuckets[sBucket].load(std::memory_order_relaxed);
+                oSnapshot.m_arrBuckets[sBucket] += ullBucketCount;
+                oSnapshot.m_ullCount += ullBucketCount;
+            }
+            oSnapshot.m_ullSumNanoseconds += oShard.m_ullSumNanoseconds.load(std::memory_order_relaxed);
+        }
+        return oSnapshot;
+    }
+
+private:
+    static std::size_t BucketIndex(unsigned long long p_ullNanoseconds)
+    {
+        std::size_t sBucket = 0;
+        while (p_ullNanoseconds > 1 && sBucket + 1 < METRICS_HISTOGRAM_BUCKETS_COUNT)
+        {
+            p_ullNanoseconds >>= 1;
+            sBucket++;
+        }
+        return sBucket;
+    }
+
+    struct alignas(64) Shard
+    {
+        std::array<std::atomic<unsigned long long>, METRICS_HISTOGRAM_BUCKETS_COUNT> m_arrBuckets{};
+        std::atomic<unsigned long long> m_ullSumNanoseconds{0};
+    };
+    std::array<Shard, METRICS_SHARDS_COUNT> m_arrShards;
+};
+
+//! Snapshots , plain values that can be copied around / exported
+struct ChannelMetricsSnapshot
+{
+    unsigned long long m_ullEnqueued{0};
+    unsigned long long m_ullDequeued{0};
+    unsigned long long m_ullHighWaterMark{0};
+    //! Only sends / reads that actually had to wait are recorded
+    HistogramSnapshot m_oSendBlockTime;
+    HistogramSnapshot m_oReceiveBlockTime;
+};
+
+struct ThreadPoolMetricsSnapshot
+{
+    unsigned long long m_ullSubmitted{0};
+    unsigned long long m_ullExecuted{0};
+    unsigned long long m_ullQueueHighWaterMark{0};
+    HistogramSnapshot m_oQueueWaitTime;
+    HistogramSnapshot m_oExecutionTime;
+};
+
+struct SelectorMetricsSnapshot
+{
+    unsigned long long m_ullSelects{0};
+    unsigned long long m_ullHandled{0};
+    //! Woke up but had nothing to execute (value was stolen by another reader , or no channel ready)
+    unsigned long long m_ullEmptyWakeups{0};
+};
+
+//! Recorders owned by the components
+struct ChannelMetrics
+{
+    ShardedCounter m_oEnqueued;
+    ShardedCounter m_oDequeued;
+    HighWaterMark m_oHighWaterMark;
+    LatencyHistogram m_oSendBlockTime;
+    LatencyHistogram m_oReceiveBlockTime;
+
+    ChannelMetricsSnapshot Snapshot() const
+    {
+        ChannelMetricsSnapshot oSnapshot;
+        oSnapshot.m_ullEnqueued = m_oEnqueued.Read();
+        oSnapshot.m_ullDequeued = m_oDequeued.Read();
+        oSnapshot.m_ullHighWaterMark = m_oHighWaterMark.Read();
+        oSnapshot.m_oSendBlockTime = m_oSendBlockTime.Read();
+        oSnapshot.m_oReceiveBlockTime = m_oReceiveBlockTime.Read();
+        return oSnapshot;
+    }
+};
+
+struct ThreadPoolMetrics
+{
+    ShardedCounter m_oSubmitted;
+    ShardedCounter m_oExecuted;
+    HighWaterMark m_oQueueHighWaterMark;
+    LatencyHistogram m_oQueueWaitTime;
+    LatencyHistogram m_oExecutionTime;
+
+    ThreadPoolMetricsSnapshot Snapshot() const
+    {
+        ThreadPoolMetricsSnapshot oSnapshot;
+        oSnapshot.m_ullSubmitted = m_oSubmitted.Read();
+        oSnapshot.m_ullExecuted = m_oExecuted.Read();
+        oSnapshot.m_ullQueueHighWaterMark = m_oQueueHighWaterMark.Read();
+        oSnapshot.m_oQueueWaitTime = m_oQueueWaitTime.Read();
+        oSnapshot.m_oExecutionTime = m_oExecutionTime.Read();
+        return oSnapshot;
+    }
+};
+
+struct SelectorMetrics
+{
+    ShardedCounter m_oSelects;
+    ShardedCounter m_oHandled;
+    ShardedCounter m_oEmptyWakeups;
+
+    SelectorMetricsSnapshot Snapshot() const
+    {
+        SelectorMetricsSnapshot oSnapshot;
+        oSnapshot.m_ullSelects = m_oSelects.Read();
+        oSnapshot.m_ullHandled = m_oHandled.Read();
+        oSnapshot.m_ullEmptyWakeups = m_oEmptyWakeups.Read();
+        return oSnapshot;
+    }
+};
+
+//! Wait on p_oCv , recording how long it blocked only if it actually had to block
+template <typename Lock, typename Predicate>
+void MetricsTimedWait(std::condition_variable &p_oCv, Lock &p_oLock, Predicate p_fPredicate, LatencyHistogram &p_oHistogram)
+{
+    if (p_fPredicate())
+    {
+        return;
+    }
+    MetricsClock::time_point oStart = MetricsClock::now();
+    p_oCv.wait(p_oLock, p_fPredicate);
+    p_oHistogram.Record(MetricsElapsedNanoseconds(oStart));
+}
\ No newline at end of file
@@ -0,0 +1,271 @@
+#pragma once
+
+//! System includes
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+//! Threading
+#include <mutex>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/*
+- Latency tracing hooks : send , receive , select , task enqueue / start / finish , actor activation
+- Compiled out unless CONCURRENCY_LIB_TRACING is defined (-DCONCURRENCY_LIB_TRACING)
+- At runtime tracing is off till Tracer::Instance().Enable() , a disabled tracepoint is one relaxed load
+- Each thread records into its own fixed size ring (single writer / single reader , no locks, no allocation)
+    - owner thread is the only writer , FlushToChromeTrace is the only reader
+    - when a ring is full new events are dropped (and counted) rather than blocking the traced thread
+- FlushToChromeTrace drains every ring into Chrome trace JSON (chrome://tracing , ui.perfetto.dev)
+    - tasks are linked from the enqueuing thread to the worker with flow arrows , so a request path can be followed across hops
+*/
+
+//! Questions / Edgecases:
+//! Q: Why are event names const char* ?
+//!     tracepoints only pass string literals , storing the pointer keeps the event small and the hot path allocation free
+//! Q: What happens to the ring of a thread that exited ?
+//!     a thread_local owner marks it free on thread exit , the Tracer keeps it (its events are still flushed)
+//!     and hands it to the next new thread once a flush emptied it , so short lived threads don't pile up 512 KB rings
+//! Q: Why timestamps in ticks ?
+//!     reading the clock is most of the cost of a tracepoint , on x86 events store the raw TSC (invariant on any recent CPU)
+//!     and ticks are converted to nanoseconds at flush time , calibrated against steady_clock
+
+enum class TracePhase : char
+{
+    Begin = 'B',
+    End = 'E',
+    Instant = 'i',
+    FlowStart = 's',
+    FlowEnd = 'f'
+};
+
+struct TraceEvent
+{
+    const char *m_szName;
+    unsigned long long m_ullTimestampTicks;
+    unsigned long long m_ullId;
+    TracePhase m_ePhase;
+};
+
+class TraceBuffer
+{
+public:
+    static constexpr std::size_t s_sCapacity = 1 << 14;
+
+    explicit TraceBuffer(unsigned int p_uiThreadId) : m_uiThreadId(p_uiThreadId) {}
+
+    //! Owner thread only
+    void Record(const char *p_szName, TracePhase p_ePhase, unsigned long long p_ullId, unsigned long long p_ullTimestampTicks)
+    {
+        std::size_t sHead = m_sHead.load(std::memory_order_relaxed);
+        if (sHead - m_sTail.load(std::memory_order_acquire) >= s_sCapacity)
+        {
+            m_ullDropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        m_arrEvents[sHead & (s_sCapacity - 1)] = TraceEvent{p_szName, p_ullTimestampTicks, p_ullId, p_ePhase};
+        m_sHead.store(sHead + 1, std::memory_order_release);
+    }
+
+    //! Flusher only, hands every recorded event to p_fConsumer then frees them
+    template <typename Consumer>
+    void Drain(Consumer &&p_fConsumer)
+    {
+        std::size_t sTail = m_sTail.load(std::memory_order_relaxed);
+        std::size_t sHead = m_sHead.load(std::memory_order_acquire);
+        for (; sTail < sHead; ++sTail)
+        {
+            p_fConsumer(m_arrEvents[sTail & (s_sCapacity - 1)]);
+        }
+        m_sTail.store(sTail, std::memory_order_release);
+    }
+
+    unsigned int ThreadId() const { return m_uiThreadId; }
+    unsigned long long Dropped() const { return m_ullDropped.load(std::memory_order_relaxed); }
+
+    //! Owner thread , on exit
+    void Release() { m_bIsOwned.store(false, std::memory_order_release); }
+
+    //! Tracer lock held , a free ring whose events were all flushed goes to p_uiThreadId
+    bool TryReuse(unsigned int p_uiThreadId)
+    {
+        if (m_bIsOwned.load(std::memory_order_acquire) ||
+            m_sHead.load(std::memory_order_acquire) != m_sTail.load(std::memory_order_relaxed))
+        {
+            return false;
+        }
+        m_bIsOwned.store(true, std::memory_order_relaxed);
+        m_uiThreadId = p_uiThreadId;
+        return true;
+    }
+
+private:
+    std::array<TraceEvent, s_sCapacity> m_arrEvents;
+    //! Only changes under the tracer lock , which the flusher holds while reading it
+    unsigned int m_uiThreadId;
+    std::atomic<bool> m_bIsOwned{true};
+    alignas(64) std::atomic<std::size_t> m_sHead{0};
+    alignas(64) std::atomic<std::size_t> m_sTail{0};
+    std::atomic<unsigned long long> m_ullDropped{0};
+};
+
+class Tracer
+{
+public:
+    static Tracer &Instance()
+    {
+        //! Intentionally leaked, threads may still trace while statics are being destroyed
+        static Tracer *s_pInstance = new Tracer();
+        return *s_pInstance;
+    }
+
+    void Enable() { m_bIsEnabled.store(true, std::memory_order_relaxed); }
+    void Disable() { m_bIsEnabled.store(false, std::memory_order_relaxed); }
+    bool IsEnabled() const { return m_bIsEnabled.load(std::memory_order_relaxed); }
+
+    void Record(const char *p_szName, TracePhase p_ePhase, unsigned long long p_ullId)
+    {
+        if (!IsEnabled())
+        {
+            return;
+        }
+        thread_local ThreadBufferOwner s_oOwner{RegisterThread()};
+        s_oOwner.m_pBuffer->Record(p_szName, p_ePhase, p_ullId, NowTicks());
+    }
+
+    //! Unique id for flows (task enqueue -> task start)
+    unsigned long long NextFlowId()
+    {
+        return m_ullNextFlowId.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    //! Drains every thread ring as one Chrome trace JSON document
+    //! events recorded while flushing may land in this flush or the next one
+    void FlushToChromeTrace(std::ostream &p_oOutput)
+    {
+        std::lock_guard<std::mutex> oLock{m_oBuffersMutex};
+        //! ticks -> ns , measured over the whole time since the tracer was created
+        unsigned long long ullTicksNow = NowTicks();
+        unsigned long long ullNsNow = NowNs();
+        double dNsPerTick = ullTicksNow == m_ullStartTicks ? 1.0 : double(ullNsNow - m_ullStartNs) / double(ullTicksNow - m_ullStartTicks);
+        auto toNs = [this, dNsPerTick](unsigned long long p_ullTicks)
+        {
+            return static_cast<unsigned long long>(double(p_ullTicks - m_ullStartTicks) * dNsPerTick);
+        };
+        p_oOutput << "{\"traceEvents\":[";
+        bool bIsFirst = true;
+        unsigned long long ullDropped = 0;
+        for (auto &pBuffer : m_vecBuffers)
+        {
+            unsigned int uiThreadId = pBuffer->ThreadId();
+            pBuffer->Drain([&p_oOutput, &bIsFirst, &toNs, uiThreadId](const TraceEvent &p_oEvent)
+                           {
+                               unsigned long long ullTimestampNs = toNs(p_oEvent.m_ullTimestampTicks);
+                               p_oOutput << (bIsFirst ? "" : ",") << "\n{\"name\":\"" << p_oEvent.m_szName
+                                         << "\",\"cat\":\"concurrency\",\"ph\":\"" << static_cast<char>(p_oEvent.m_ePhase)
+                                         << "\",\"ts\":" << ullTimestampNs / 1000 << '.' << FractionDigits(ullTimestampNs % 1000)
+                                         << ",\"pid\":1,\"tid\":" << uiThreadId;
+                               if (p_oEvent.m_ePhase == TracePhase::FlowStart || p_oEvent.m_ePhase == TracePhase::FlowEnd)
+                               {
+                                   //! bind the flow end to the slice that starts with it
+                                   p_oOutput << ",\"id\":" << p_oEvent.m_ullId << ",\"bp\":\"e\"";
+                               }
+                               else if (p_oEvent.m_ePhase == TracePhase::Instant)
+                               {
+                                   p_oOutput << ",\"s\":\"t\"";
+                               }
+                               p_oOutput << ",\"args\":{\"id\":" << p_oEvent.m_ullId << "}}";
+                               bIsFirst = false; });
+            ullDropped += pBuffer->Dropped();
+        }
+        p_oOutput << "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"droppedEvents\":" << ullDropped << "}}\n";
+    }
+
+    bool FlushToChromeTrace(const std::string &p_strPath)
+    {
+        std::ofstream oFile{p_strPath};
+        if (!oFile)
+        {
+            return false;
+        }
+        FlushToChromeTrace(oFile);
+        return static_cast<bool>(oFile);
+    }
+
+private:
+    Tracer() : m_ullStartTicks(NowTicks()), m_ullStartNs(NowNs()) {}
+
+    static unsigned long long NowNs()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static unsigned long long NowTicks()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return NowNs();
+#endif
+    }
+
+    static std::string FractionDigits(unsigned long long p_ullNanoseconds)
+    {
+        std::string strDigits = std::to_string(p_ullNanoseconds);
+        return std::string(3 - strDigits.size(), '0') + strDigits;
+    }
+
+    //! Frees the thread's ring when the thread exits
+    struct ThreadBufferOwner
+    {
+        TraceBuffer *m_pBuffer;
+
+        ~ThreadBufferOwner()
+        {
+            m_pBuffer->Release();
+        }
+    };
+
+    //! Once per thread , the only place the tracer locks on the recording side
+    //! a flushed ring of an exited thread is reused , chrome still sees a new tid
+    TraceBuffer *RegisterThread()
+    {
+        std::lock_guard<std::mutex> oLock{m_oBuffersMutex};
+        unsigned int uiThreadId = m_uiNextThreadId++;
+        for (auto &pBuffer : m_vecBuffers)
+        {
+            if (pBuffer->TryReuse(uiThreadId))
+            {
+                return pBuffer.get();
+            }
+        }
+        m_vecBuffers.push_back(std::make_shared<TraceBuffer>(uiThreadId));
+        return m_vecBuffers.back().get();
+    }
+
+    std::atomic<bool> m_bIsEnabled{false};
+    std::atomic<unsigned long long> m_ullNextFlowId{0};
+    //! Calibration point , events timestamps are relative to it
+    unsigned long long m_ullStartTicks;
+    unsigned long long m_ullStartNs;
+    std::mutex m_oBuffersMutex;
+    std::vector<std::shared_ptr<TraceBuffer>> m_vecBuffers;
+    unsigned int m_uiNextThreadId{0};
+};
+
+#ifdef CONCURRENCY_LIB_TRACING
+#define CONCURRENCY_LIB_TRACING_ONLY(...) __VA_ARGS__
+#define CONCURRENCY_LIB_TRACE(p_szName, p_ePhase, p_ullId) Tracer::Instance().Record(p_szName, p_ePhase, p_ullId)
+#else
+#define CONCURRENCY_LIB_TRACING_ONLY(...)
+#define CONCURRENCY_LIB_TRACE(p_szName, p_ePhase, p_ullId)
+#endif
\ No newline at end of file
@@ -0,0 +1,791 @@
+#pragma once
+
+//! System includes
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+//! Threading
+#include <mutex>
+#include <condition_variable>
+
+//! Channel Interface
+#include "IChannel.h"
+
+//! Executors
+#include "BasicThreadPool.h"
+
+//! Instrumentation
+#include "Tracing.h"
+
+/*
+- Dataflow combinators between channels : Map , Filter , Merge , Split / Partition , Batch , Window
+- Replaces the hand written "consumer thread per transformation" between two channels
+    - a stage owns no thread , it registers on its inputs listeners (same ones the ChannelSelector uses)
+      a Send on an input schedules ONE activation of the stage as a BasicThreadPool task
+    - an activation drains what is available (up to s_sDrainBudget values , then it re posts itself so other stages get the workers too)
+    - outputs are plain channels , a stage blocks on a full bounded output , stops reading its input , which fills up and blocks its producers (backpressure)
+- A stage keeps itself alive till all of its inputs are closed , then it flushes (Batch / Window) , closes its outputs and unregisters
+  so closing the source of a chain closes the whole chain
+- Batch / Window timeouts come from one shared timer thread (DataflowTimer) , only armed while a batch / window holds values
+*/
+
+//! Questions / Edgecases:
+//! Q: How is an activation never lost ?
+//!     listeners bump a signals counter , only the 0 -> 1 transition posts a task
+//!     the activation subtracts what it saw once its drain is done , if more signals arrived meanwhile it drains again
+//! Q: Values still in an input when it is closed ?
+//!     dropped , same as for any channel of this library (Close makes every Read fail) , close the source once the sink saw everything
+//! Q: Map with parallelism N ?
+//!     the activation hands up to N values to separate pool tasks , a finished task wakes the activation up for the next value
+//!     with order preservation results go through a small reorder buffer (at most N entries) , whichever task holds the next sequence emits
+//! Q: Inputs closed before the stage is built ?
+//!     their close listener never fires , build stages on open channels
+//! Q: How many workers ?
+//!     an activation blocked on a full output holds its worker till the next stage reads , if every worker is held that way nothing drains
+//!     so like Pipeline , give the pool at least one worker per stage (Map counts for its parallelism) , stages only hold them while blocked
+
+//! One thread for every Batch / Window timeout of the process
+class DataflowTimer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static DataflowTimer &Instance()
+    {
+        static DataflowTimer s_oTimer;
+        return s_oTimer;
+    }
+
+    //! p_fCallback runs on the timer thread , keep it short (stages only flag themselves and Notify)
+    void Schedule(Clock::time_point p_oDeadline, std::function<void(void)> &&p_fCallback)
+    {
+        {
+            std::lock_guard<std::mutex> oLock{m_oMutex};
+            m_oTimers.push(Entry{p_oDeadline, std::move(p_fCallback)});
+        }
+        m_oCv.notify_one();
+    }
+
+    ~DataflowTimer()
+    {
+        {
+            std::lock_guard<std::mutex> oLock{m_oMutex};
+            m_bIsTerminated = true;
+        }
+        m_oCv.notify_one();
+        m_oThread.join();
+    }
+
+private:
+    struct Entry
+    {
+        Clock::time_point m_oDeadline;
+        //! Moved out of the queue top before it is popped
+        mutable std::function<void(void)> m_fCallback;
+    };
+
+    struct IsLater
+    {
+        bool operator()(const Entry &p_oLeft, const Entry &p_oRight) const
+        {
+            return p_oLeft.m_oDeadline > p_oRight.m_oDeadline;
+        }
+    };
+
+    DataflowTimer() : m_oThread(&DataflowTimer::EventLoop, this) {}
+
+    void EventLoop()
+    {
+        std::unique_lock<std::mutex> oLock{m_oMutex};
+        while (!m_bIsTerminated)
+        {
+            if (m_oTimers.empty())
+            {
+                m_oCv.wait(oLock);
+                continue;
+            }
+            if (m_oTimers.top().m_oDeadline > Clock::now())
+            {
+                m_oCv.wait_until(oLock, m_oTimers.top().m_oDeadline);
+                continue;
+            }
+            std::function<void(void)> fCallback = std::move(m_oTimers.top().m_fCallback);
+            m_oTimers.pop();
+            //! Callbacks may schedule again
+            oLock.unlock();
+            fCallback();
+            oLock.lock();
+        }
+    }
+
+    std::mutex m_oMutex;
+    std::condition_variable m_oCv;
+    std::priority_queue<Entry, std::vector<Entry>, IsLater> m_oTimers;
+    bool m_bIsTerminated{false};
+    std::thread m_oThread;
+};
+
+//! Scheduling and lifetime shared by every combinator , the transformation itself is in Drain
+class DataflowStage : public std::enable_shared_from_this<DataflowStage>
+{
+public:
+    DataflowStage(const DataflowStage &) = delete;
+    DataflowStage &operator=(const DataflowStage &) = delete;
+    virtual ~DataflowStage() = default;
+
+    //! All inputs closed , flushed and outputs closed
+    bool IsFinished() const
+    {
+        return m_bIsFinished.load();
+    }
+
+    void WaitUntilFinished()
+    {
+        std::unique_lock<std::mutex> oLock{m_oFinishedMutex};
+        m_oFinishedCv.wait(oLock, [this]()
+                           { return m_bIsFinished.load(); });
+    }
+
+protected:
+    //! Values handled by one activation before it gives its worker back
+    static constexpr std::size_t s_sDrainBudget = 256;
+
+    explicit DataflowStage(BasicThreadPool &p_oPool) : m_oPool(p_oPool) {}
+
+    //! Reads what is available from the inputs and sends the results , true if it stopped on the budget with values left
+    virtual bool Drain() = 0;
+    //! Values still in flight outside of Drain (Map with parallelism) , the stage finishes only once it is 0
+    virtual bool IsIdle()
+    {
+        return true;
+    }
+    //! All inputs are closed , emit what is pending (partial batch ...) then close every output
+    virtual void Finish() = 0;
+
+    template <typename T>
+    void Listen(const std::shared_ptr<IChannel<T>> &p_pInput)
+    {
+        std::weak_ptr<DataflowStage> pWeakSelf = weak_from_this();
+        unsigned long long ullId = p_pInput->RegisterChannelOperationsListener(
+            [pWeakSelf]()
+            {
+                if (auto pSelf = pWeakSelf.lock())
+                {
+                    pSelf->Notify();
+                }
+            },
+            [pWeakSelf]()
+            {
+                if (auto pSelf = pWeakSelf.lock())
+                {
+                    pSelf->m_sClosedInputs.fetch_add(1);
+                    pSelf->Notify();
+                }
+            });
+        m_sInputsCount++;
+        m_vecUnRegisters.push_back([p_pInput, ullId]()
+                                   { p_pInput->UnRegisterChannelOperationsListener(static_cast<int>(ullId)); });
+    }
+
+    //! Called by the factories once every input is listened on , values sent before registration get drained too
+    void Start()
+    {
+        m_pSelf = shared_from_this();
+        Notify();
+    }
+
+    void Notify()
+    {
+        if (m_uiSignals.fetch_add(1) == 0)
+        {
+            Post();
+        }
+    }
+
+    BasicThreadPool &m_oPool;
+
+private:
+    void Post()
+    {
+        m_oPool.PostTask([pSelf = shared_from_this()]()
+                         { pSelf->Run(); });
+    }
+
+    //! One activation at a time , see the signals counter above
+    void Run()
+    {
+        CONCURRENCY_LIB_TRACE("Dataflow::Run", TracePhase::Begin, reinterpret_cast<unsigned long long>(this));
+        while (true)
+        {
+            unsigned int uiSeen = m_uiSignals.load();
+            if (Drain())
+            {
+                //! Signals are kept , nobody else posts meanwhile
+                Post();
+                break;
+            }
+            if (!m_bIsFinished.load() && m_sClosedInputs.load() == m_sInputsCount && IsIdle())
+            {
+                FinishOnce();
+            }
+            if (m_uiSignals.fetch_sub(uiSeen) == uiSeen)
+            {
+                break;
+            }
+        }
+        CONCURRENCY_LIB_TRACE("Dataflow::Run", TracePhase::End, reinterpret_cast<unsigned long long>(this));
+    }
+
+    void FinishOnce()
+    {
+        Finish();
+        //! From a pool task , never from within a listener , so the inputs listeners locks are free
+        for (auto &fUnRegister : m_vecUnRegisters)
+        {
+            fUnRegister();
+        }
+        {
+            std::lock_guard<std::mutex> oLock{m_oFinishedMutex};
+            m_bIsFinished.store(true);
+        }
+        m_oFinishedCv.notify_all();
+        //! The running task still holds a reference , the stage goes away once it returns (unless the caller holds one)
+        m_pSelf.reset();
+    }
+
+    std::atomic<unsigned int> m_uiSignals{0};
+    std::size_t m_sInputsCount{0};
+    std::atomic<std::size_t> m_sClosedInputs{0};
+    std::vector<std::function<void(void)>> m_vecUnRegisters;
+    std::shared_ptr<DataflowStage> m_pSelf;
+
+    std::atomic<bool> m_bIsFinished{false};
+    std::mutex m_oFinishedMutex;
+    std::condition_variable m_oFinishedCv;
+};
+
+struct MapOptions
+{
+    //! Values transformed at the same time
+    std::size_t m_sParallelism{1};
+    //! Outputs in input order even with parallelism > 1
+    bool m_bPreserveOrder{true};
+};
+
+template <typename In, typename Out, typename Function>
+class MapStage : public DataflowStage
+{
+public:
+    MapStage(BasicThreadPool &p_oPool, std::shared_ptr<IChannel<In>> p_pInput, std::shared_ptr<IChannel<Out>> p_pOutput, Function &&p_fFunction, MapOptions p_oOptions)
+        : DataflowStage(p_oPool), m_pInput(std::move(p_pInput)), m_pOutput(std::move(p_pOutput)), m_fFunction(std::move(p_fFunction)), m_oOptions(p_oOptions)
+    {
+        if (m_oOptions.m_sParallelism == 0)
+        {
+            throw std::logic_error("Cannot Create a Map With parallelism 0");
+        }
+    }
+
+    void Build()
+    {
+        Listen(m_pInput);
+        Start();
+    }
+
+protected:
+    virtual bool Drain() override
+    {
+        std::optional<In> oValue;
+        if (m_oOptions.m_sParallelism == 1)
+        {
+            for (std::size_t sCount = 0; sCount < s_sDrainBudget; ++sCount)
+            {
+                oValue.reset();
+                if (!m_pInput->TryReadValue(oValue))
+                {
+                    return false;
+                }
+                m_pOutput->SendValue(m_fFunction(std::move(*oValue)));
+            }
+            return true;
+        }
+        //! Hand values to tasks while there is room , a finished task Notifies us for the next one
+        while (m_sInFlight.load() < m_oOptions.m_sParallelism && HasReorderRoom())
+        {
+            oValue.reset();
+            if (!m_pInput->TryReadValue(oValue))
+            {
+                return false;
+            }
+            m_sInFlight.fetch_add(1);
+            unsigned long long ullSequence = m_ullNextSequence++;
+            m_oPool.PostTask([pSelf = shared_from_this(), this, ullSequence, tValue = std::move(*oValue)]() mutable
+                             {
+                Out tResult = m_fFunction(std::move(tValue));
+                if (m_oOptions.m_bPreserveOrder)
+                {
+                    Emit(ullSequence, std::move(tResult));
+                }
+                else
+                {
+                    m_pOutput->SendValue(std::move(tResult));
+                }
+                m_sInFlight.fetch_sub(1);
+                Notify(); });
+        }
+        return false;
+    }
+
+    virtual bool IsIdle() override
+    {
+        return m_sInFlight.load() == 0;
+    }
+
+    virtual void Finish() override
+    {
+        m_pOutput->Close();
+    }
+
+private:
+    //! A finished task leaves the in flight count as soon as its result is parked , not once it is sent
+    //! so with order kept , values are only dispatched within N of the next one to emit , a slow head of line can't grow the reorder buffer
+    //! (whoever emits Notifies right after , the activation comes back for the next values)
+    bool HasReorderRoom()
+    {
+        if (!m_oOptions.m_bPreserveOrder)
+        {
+            return true;
+        }
+        std::lock_guard<std::mutex> oLock{m_oReorderMutex};
+        return m_ullNextSequence - m_ullNextToEmit < m_oOptions.m_sParallelism;
+    }
+
+    //! Reorder buffer , whoever finds its sequence next in line sends everything that is ready
+    void Emit(unsigned long long p_ullSequence, Out &&p_tResult)
+    {
+        std::unique_lock<std::mutex> oLock{m_oReorderMutex};
+        m_mapReady.emplace(p_ullSequence, std::move(p_tResult));
+        if (m_bIsEmitting)
+        {
+            return;
+        }
+        m_bIsEmitting = true;
+        while (!m_mapReady.empty() && m_mapReady.begin()->first == m_ullNextToEmit)
+        {
+            Out tResult = std::move(m_mapReady.begin()->second);
+            m_mapReady.erase(m_mapReady.begin());
+            m_ullNextToEmit++;
+            //! Blocking Send without the lock , others keep depositing meanwhile
+            oLock.unlock();
+            m_pOutput->SendValue(std::move(tResult));
+            oLock.lock();
+        }
+        m_bIsEmitting = false;
+    }
+
+    std::shared_ptr<IChannel<In>> m_pInput;
+    std::shared_ptr<IChannel<Out>> m_pOutput;
+    Function m_fFunction;
+    MapOptions m_oOptions;
+
+    std::atomic<std::size_t> m_sInFlight{0};
+    //! Only touched by the activation
+    unsigned long long m_ullNextSequence{0};
+
+    std::mutex m_oReorderMutex;
+    std::map<unsigned long long, Out> m_mapReady;
+    unsigned long long m_ullNextToEmit{0};
+    bool m_bIsEmitting{false};
+};
+
+template <typename T, typename Predicate>
+class FilterStage : public DataflowStage
+{
+public:
+    FilterStage(BasicThreadPool &p_oPool, std::shared_ptr<IChannel<T>> p_pInput, std::shared_ptr<IChannel<T>> p_pOutput, Predicate &&p_fPredicate)
+        : DataflowStage(p_oPool), m_pInput(std::move(p_pInput)), m_pOutput(std::move(p_pOutput)), m_fPredicate(std::move(p_fPredicate))
+    {
+    }
+
+    void Build()
+    {
+        Listen(m_pInput);
+        Start();
+    }
+
+protected:
+    virtual bool Drain() override
+    {
+        std::optional<T> oValue;
+        for (std::size_t sCount = 0; sCount < s_sDrainBudget; ++sCount)
+        {
+            oValue.reset();
+            if (!m_pInput->TryReadValue(oValue))
+            {
+                return false;
+            }
+            if (m_fPredicate(*oValue))
+            {
+                m_pOutput->SendValue(std::move(*oValue));
+            }
+        }
+        return true;
+    }
+
+    virtual void Finish() override
+    {
+        m_pOutput->Close();
+    }
+
+private:
+    std::shared_ptr<IChannel<T>> m_pInput;
+    std::shared_ptr<IChannel<T>> m_pOutput;
+    Predicate m_fPredicate;
+};
+
+template <typename T>
+class MergeStage : public DataflowStage
+{
+public:
+    MergeStage(BasicThreadPool &p_oPool, std::vector<std::shared_ptr<IChannel<T>>> p_vecInputs, std::shared_ptr<IChannel<T>> p_pOutput)
+        : DataflowStage(p_oPool), m_vecInputs(std::move(p_vecInputs)), m_pOutput(std::move(p_pOutput))
+    {
+        if (m_vecInputs.empty())
+        {
+            throw std::logic_error("Cannot Merge zero channels");
+        }
+    }
+
+    void Build()
+    {
+        for (auto &pInput : m_vecInputs)
+        {
+            Listen(pInput);
+        }
+        Start();
+    }
+
+protected:
+    //! Round robin , one value per input per turn so a busy input can't starve the others
+    virtual bool Drain() override
+    {
+        std::optional<T> oValue;
+        std::size_t sCount = 0;
+        bool bHasRead = true;
+        while (bHasRead)
+        {
+            bHasRead = false;
+            for (auto &pInput : m_vecInputs)
+            {
+                oValue.reset();
+                if (pInput->TryReadValue(oValue))
+                {
+                    bHasRead = true;
+                    m_pOutput->SendValue(std::move(*oValue));
+                    if (++sCount == s_sDrainBudget)
+                    {
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    virtual void Finish() override
+    {
+        m_pOutput->Close();
+    }
+
+private:
+    std::vector<std::shared_ptr<IChannel<T>>> m_vecInputs;
+    std::shared_ptr<IChannel<T>> m_pOutput;
+};
+
+template <typename T, typename Selector>
+class SplitStage : public DataflowStage
+{
+public:
+    SplitStage(BasicThreadPool &p_oPool, std::shared_ptr<IChannel<T>> p_pInput, std::vector<std::shared_ptr<IChannel<T>>> p_vecOutputs, Selector &&p_fSelector)
+        : DataflowStage(p_oPool), m_pInput(std::move(p_pInput)), m_vecOutputs(std::move(p_vecOutputs)), m_fSelector(std::move(p_fSelector))
+    {
+        if (m_vecOutputs.empty())
+        {
+            throw std::logic_error("Cannot Split into zero channels");
+        }
+    }
+
+    void Build()
+    {
+        Listen(m_pInput);
+        Start();
+    }
+
+protected:
+    virtual bool Drain() override
+    {
+        std::optional<T> oValue;
+        for (std::size_t sCount = 0; sCount < s_sDrainBudget; ++sCount)
+        {
+            oValue.reset();
+            if (!m_pInput->TryReadValue(oValue))
+            {
+                return false;
+            }
+            std::size_t sOutput = static_cast<std::size_t>(m_fSelector(*oValue)) % m_vecOutputs.size();
+            m_vecOutputs[sOutput]->SendValue(std::move(*oValue));
+        }
+        return true;
+    }
+
+    virtual void Finish() override
+    {
+        for (auto &pOutput : m_vecOutputs)
+        {
+            pOutput->Close();
+        }
+    }
+
+private:
+    std::shared_ptr<IChannel<T>> m_pInput;
+    std::vector<std::shared_ptr<IChannel<T>>> m_vecOutputs;
+    Selector m_fSelector;
+};
+
+//! Shared by Batch and Window : values are collected in a vector , emitted on a count or on a deadline from the DataflowTimer
+template <typename T>
+class CollectStage : public DataflowStage
+{
+public:
+    void Build()
+    {
+        Listen(m_pInput);
+        Start();
+    }
+
+protected:
+    CollectStage(BasicThreadPool &p_oPool, std::shared_ptr<IChannel<T>> p_pInput, std::shared_ptr<IChannel<std::vector<T>>> p_pOutput)
+        : DataflowStage(p_oPool), m_pInput(std::move(p_pInput)), m_pOutput(std::move(p_pOutput))
+    {
+    }
+
+    //! Sends the collected values (if any) and starts a new collection , a pending deadline of the old one is ignored
+    void Emit()
+    {
+        m_ullGeneration++;
+        if (m_vecCollected.empty())
+        {
+            return;
+        }
+        std::vector<T> vecCollected = std::move(m_vecCollected);
+        m_vecCollected.clear();
+        m_pOutput->SendValue(std::move(vecCollected));
+    }
+
+    //! Notify the stage at p_oDeadline , if the collection started now is still open then
+    void ArmDeadline(DataflowTimer::Clock::time_point p_oDeadline)
+    {
+        std::weak_ptr<DataflowStage> pWeakSelf = weak_from_this();
+        unsigned long long ullGeneration = m_ullGeneration;
+        DataflowTimer::Instance().Schedule(p_oDeadline, [pWeakSelf, ullGeneration]()
+                                           {
+            if (auto pSelf = pWeakSelf.lock())
+            {
+                auto pCollect = static_cast<CollectStage *>(pSelf.get());
+                pCollect->m_ullExpiredGeneration.store(ullGeneration);
+                pCollect->Notify();
+            } });
+    }
+
+    bool IsExpired() const
+    {
+        return m_ullExpiredGeneration.load() == m_ullGeneration;
+    }
+
+    virtual void Finish() override
+    {
+        Emit();
+        m_pOutput->Close();
+    }
+
+    std::shared_ptr<IChannel<T>> m_pInput;
+    std::shared_ptr<IChannel<std::vector<T>>> m_pOutput;
+    std::vector<T> m_vecCollected;
+
+private:
+    //! Only touched by the activation
+    unsigned long long m_ullGeneration{0};
+    //! Written by the timer thread , ~0 : nothing expired yet
+    std::atomic<unsigned long long> m_ullExpiredGeneration{~0ULL};
+};
+
+template <typename T>
+class BatchStage : public CollectStage<T>
+{
+public:
+    BatchStage(BasicThreadPool &p_oPool, std::shared_ptr<IChannel<T>> p_pInput, std::shared_ptr<IChannel<std::vector<T>>> p_pOutput,
+               std::size_t p_sBatchSize, std::chrono::milliseconds p_oTimeout)
+        : CollectStage<T>(p_oPool, std::move(p_pInput), std::move(p_pOutput)), m_sBatchSize(p_sBatchSize), m_oTimeout(p_oTimeout)
+    {
+        if (m_sBatchSize == 0)
+        {
+            throw std::logic_error("Cannot Create a Batch With size 0");
+        }
+    }
+
+protected:
+    //! A batch is emitted full , or partial once its first value waited p_oTimeout
+    virtual bool Drain() override
+    {
+        std::optional<T> oValue;
+        for (std::size_t sCount = 0; sCount < DataflowStage::s_sDrainBudget; ++sCount)
+        {
+            oValue.reset();
+            if (!this->m_pInput->TryReadValue(oValue))
+            {
+                if (this->IsExpired())
+                {
+                    this->Emit();
+                }
+                return false;
+            }
+            if (this->m_vecCollected.empty())
+            {
+                this->m_vecCollected.reserve(m_sBatchSize);
+                this->ArmDeadline(DataflowTimer::Clock::now() + m_oTimeout);
+            }
+            this->m_vecCollected.push_back(std::move(*oValue));
+            if (this->m_vecCollected.size() == m_sBatchSize)
+            {
+                this->Emit();
+            }
+        }
+        return true;
+    }
+
+private:
+    std::size_t m_sBatchSize;
+    std::chrono::milliseconds m_oTimeout;
+};
+
+template <typename T>
+class WindowStage : public CollectStage<T>
+{
+public:
+    WindowStage(BasicThreadPool &p_oPool, std::shared_ptr<IChannel<T>> p_pInput, std::shared_ptr<IChannel<std::vector<T>>> p_pOutput,
+                std::chrono::milliseconds p_oDuration)
+        : CollectStage<T>(p_oPool, std::move(p_pInput), std::move(p_pOutput)), m_oDuration(p_oDuration), m_oOrigin(DataflowTimer::Clock::now())
+    {
+        if (m_oDuration.count() <= 0)
+        {
+            throw std::logic_error("Cannot Create a Window With duration <= 0");
+        }
+    }
+
+protected:
+    //! Tumbling windows [origin + k * duration , origin + (k + 1) * duration) , each non empty one emitted once it is over
+    virtual bool Drain() override
+    {
+        std::optional<T> oValue;
+        for (std::size_t sCount = 0; sCount < DataflowStage::s_sDrainBudget; ++sCount)
+        {
+            oValue.reset();
+            bool bHasValue = this->m_pInput->TryReadValue(oValue);
+            DataflowTimer::Clock::time_point oNow = DataflowTimer::Clock::now();
+            if (!this->m_vecCollected.empty() && oNow >= m_oWindowEnd)
+            {
+                this->Emit();
+            }
+            if (!bHasValue)
+            {
+                return false;
+            }
+            if (this->m_vecCollected.empty())
+            {
+                auto llWindow = (oNow - m_oOrigin) / m_oDuration;
+                m_oWindowEnd = m_oOrigin + (llWindow + 1) * m_oDuration;
+                this->ArmDeadline(m_oWindowEnd);
+            }
+            this->m_vecCollected.push_back(std::move(*oValue));
+        }
+        return true;
+    }
+
+private:
+    std::chrono::milliseconds m_oDuration;
+    DataflowTimer::Clock::time_point m_oOrigin;
+    DataflowTimer::Clock::time_point m_oWindowEnd;
+};
+
+//! Factories , every stage starts right away and lives till its inputs are closed
+//! the returned handle is only needed to wait for it (WaitUntilFinished)
+
+template <typename In, typename Out, typename Function>
+std::shared_ptr<DataflowStage> Map(BasicThreadPool &p_oPool, std::shared_ptr<IChannel<In>> p_pInput, std::shared_ptr<IChannel<Out>> p_pOutput,
+                                   Function &&p_fFunction, MapOptions p_oOptions = MapOptions())
+{
+    auto pStage = std::make_shared<MapStage<In, Out, std::decay_t<Function>>>(p_oPool, std::move(p_pInput), std::move(p_pOutput), std::decay_t<Function>(std::forward<Function>(p_fFunction)), p_oOptions);
+    pStage->Build();
+    return pStage;
+}
+
+template <typename T, typename Predicate>
+std::shared_ptr<DataflowStage> Filter(BasicThreadPool &p_oPool, std::shared_ptr<IChannel<T>> p_pInput, std::shared_ptr<IChannel<T>> p_pOutput, Predicate &&p_fPredicate)
+{
+    auto pStage = std::make_shared<FilterStage<T, std::decay_t<Predicate>>>(p_oPool, std::move(p_pInput), std::move(p_pOutput), std::decay_t<Predicate>(std::forward<Predicate>(p_fPredicate)));
+    pStage->Build();
+    return pStage;
+}
+
+//! Output is closed once every input is
+template <typename T>
+std::shared_ptr<DataflowStage> Merge(BasicThreadPool &p_oPool, std::vector<std::shared_ptr<IChannel<T>>> p_vecInputs, std::shared_ptr<IChannel<T>> p_pOutput)
+{
+    auto pStage = std::make_shared<MergeStage<T>>(p_oPool, std::move(p_vecInputs), std::move(p_pOutput));
+    pStage->Build();
+    return pStage;
+}
+
+//! p_fSelector returns the output index (taken modulo the outputs count)
+template <typename T, typename Selector>
+std::shared_ptr<DataflowStage> Split(BasicThreadPool &p_oPool, std::shared_ptr<IChannel<T>> p_pInput, std::vector<std::shared_ptr<IChannel<T>>> p_vecOutputs, Selector &&p_fSelector)
+{
+    auto pStage = std::make_shared<SplitStage<T, std::decay_t<Selector>>>(p_oPool, std::move(p_pInput), std::move(p_vecOutputs), std::decay_t<Selector>(std::forward<Selector>(p_fSelector)));
+    pStage->Build();
+    return pStage;
+}
+
+//! Same key , same output (hash of p_fKey(value))
+template <typename T, typename KeyFunction>
+std::shared_ptr<DataflowStage> Partition(BasicThreadPool &p_oPool, std::shared_ptr<IChannel<T>> p_pInput, std::vector<std::shared_ptr<IChannel<T>>> p_vecOutputs, KeyFunction &&p_fKey)
+{
+    return Split<T>(p_oPool, std::move(p_pInput), std::move(p_vecOutputs), [fKey = std::decay_t<KeyFunction>(std::forward<KeyFunction>(p_fKey))](const T &p_tValue)
+                    { return std::hash<std::decay_t<decltype(fKey(p_tValue))>>()(fKey(p_tValue)); });
+}
+
+template <typename T>
+std::shared_ptr<DataflowStage> Batch(BasicThreadPool &p_oPool, std::shared_ptr<IChannel<T>> p_pInput, std::shared_ptr<IChannel<std::vector<T>>> p_pOutput,
+                                     std::size_t p_sBatchSize, std::chrono::milliseconds p_oTimeout)
+{
+    auto pStage = std::make_shared<BatchStage<T>>(p_oPool, std::move(p_pInput), std::move(p_pOutput), p_sBatchSize, p_oTimeout);
+    pStage->Build();
+    return pStage;
+}
+
+template <typename T>
+std::shared_ptr<DataflowStage> Window(BasicThreadPool &p_oPool, std::shared_ptr<IChannel<T>> p_pInput, std::shared_ptr<IChannel<std::vector<T>>> p_pOutput,
+                                      std::chrono::milliseconds p_oDuration)
+{
+    auto pStage = std::make_shared<WindowStage<T>>(p_oPool, std::move(p_pInput), std::move(p_pOutput), p_oDuration);
+    pStage->Build();
+    return pStage;
+}
\ No newline at end of file
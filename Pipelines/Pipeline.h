@@ -0,0 +1,291 @@
+#pragma once
+
+//! System includes
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+//! Threading
+#include <mutex>
+#include <condition_variable>
+
+//! Executors
+#include "BasicThreadPool.h"
+
+/*
+- Disruptor style pipeline : producer -> stage 1 -> stage 2 -> ... over ONE preallocated ring
+- Replaces producer -> BufferedChannel -> stage -> BufferedChannel -> stage chains
+    - values are never copied / moved between stages, every stage works on the same slot in place
+    - stages don't take locks on the hot path , each one publishes an atomic cursor (how many items it finished)
+      and waits on the cursor of the stage before it (its barrier)
+    - a stage that fell behind processes everything available in one batch and publishes its cursor once
+- Producer can only reuse a slot once the LAST stage is done with it (backpressure)
+- Each stage runs as a long running task on a BasicThreadPool worker, so the pool needs at least one worker per stage
+*/
+
+//! Questions / Edgecases:
+//! Q: Why is the ring of T and not optional<T> ?
+//!     slots are preallocated once and reused in place , T needs to be default constructible
+//!     and PublishInPlace lets producers reuse the slot's buffers (strings, vectors capacity ...)
+//! Q: How do stages block when there is nothing to do ?
+//!     they spin a little then sleep on a shared condition variable, cursors publishers only take the lock to notify if someone sleeps
+
+template <typename T>
+class Pipeline
+{
+public:
+    using StageHandler = std::function<void(T &)>;
+
+    struct StageStats
+    {
+        unsigned long long m_ullProcessed{0};
+        unsigned long long m_ullBatches{0};
+        unsigned long long m_ullLargestBatch{0};
+    };
+
+    Pipeline(std::size_t p_sCapacity)
+        : m_vecRing(RoundUpToPowerOfTwo(p_sCapacity)), m_ullMask(m_vecRing.size() - 1)
+    {
+        if (p_sCapacity <= 0)
+        {
+            throw std::logic_error("Cannot Create a Pipeline With Len <= 0");
+        }
+    }
+
+    //! Builder, stages are run in the order they are added
+    Pipeline &AddStage(StageHandler &&p_fHandler)
+    {
+        if (m_bIsStarted)
+        {
+            throw std::logic_error("Cannot Add a Stage to a started Pipeline");
+        }
+        m_oStages.emplace_back(std::move(p_fHandler));
+        return *this;
+    }
+
+    //! Schedules every stage on the pool
+    void Start(BasicThreadPool &p_oPool)
+    {
+        if (m_bIsStarted || m_oStages.empty())
+        {
+            throw std::logic_error("Pipeline already started or has no stages");
+        }
+        m_bIsStarted = true;
+        for (std::size_t sStage = 0; sStage < m_oStages.size(); ++sStage)
+        {
+            m_vecStagesResults.push_back(p_oPool.SubmitTask<bool>([this, sStage]()
+                                                                  { return RunStage(sStage); }));
+        }
+    }
+
+    //! Block till the slot is free, then copy / move the value in
+    bool Publish(T &&p_tValue)
+    {
+        return PublishInPlace([&p_tValue](T &p_tSlot)
+                              { p_tSlot = std::move(p_tValue); });
+    }
+
+    bool Publish(T &p_tValue)
+    {
+        return PublishInPlace([&p_tValue](T &p_tSlot)
+                              { p_tSlot = p_tValue; });
+    }
+
+    //! Block till the slot is free, then let p_fWriter fill it directly in the ring
+    template <typename Writer>
+    bool PublishInPlace(Writer &&p_fWriter)
+    {
+        //! Producers are serialized, stages don't care about this lock
+        std::lock_guard<std::mutex> oLock{m_oPublishMutex};
+        if (m_oStages.empty())
+        {
+            throw std::logic_error("Cannot Publish to a Pipeline that has no stages");
+        }
+        if (m_bIsClosed.load())
+        {
+            return false;
+        }
+        unsigned long long ullSequence = m_ullPublished.load(std::memory_order_relaxed);
+        const std::atomic<unsigned long long> &oLastStageCursor = m_oStages.back().m_ullCursor;
+        bool bIsSlotFree = WaitFor([this, ullSequence, &oLastStageCursor]()
+                                   { return m_bIsClosed.load() || ullSequence - oLastStageCursor.load() < m_vecRing.size(); });
+        if (!bIsSlotFree || m_bIsClosed.load())
+        {
+            return false;
+        }
+        p_fWriter(m_vecRing[ullSequence & m_ullMask]);
+        m_ullPublished.store(ullSequence + 1);
+        WakeUpWaiters();
+        return true;
+    }
+
+    //! Stop accepting values , stages finish what was already published then their tasks end
+    //! blocks till all stages are done
+    void Close()
+    {
+        if (m_bIsClosed.exchange(true))
+        {
+            return;
+        }
+        //! Wake up producers blocked on a full ring , they give up
+        WakeUpWaiters();
+        {
+            //! Wait for a publish that may be in flight, anything published after this point would never be processed
+            std::lock_guard<std::mutex> oLock{m_oPublishMutex};
+            m_bIsPublishingDone.store(true);
+        }
+        WakeUpWaiters();
+        for (auto &pStageResult : m_vecStagesResults)
+        {
+            bool bResult;
+            pStageResult->ReadValue(bResult);
+        }
+    }
+
+    //! Per stage counters , can be read while the pipeline runs
+    std::vector<StageStats> GetStagesStats() const
+    {
+        std::vector<StageStats> vecStats;
+        for (const Stage &oStage : m_oStages)
+        {
+            StageStats oStats;
+            oStats.m_ullProcessed = oStage.m_ullCursor.load(std::memory_order_relaxed);
+            oStats.m_ullBatches = oStage.m_ullBatches.load(std::memory_order_relaxed);
+            oStats.m_ullLargestBatch = oStage.m_ullLargestBatch.load(std::memory_order_relaxed);
+            vecStats.push_back(oStats);
+        }
+        return vecStats;
+    }
+
+    ~Pipeline()
+    {
+        Close();
+    }
+
+private:
+    struct Stage
+    {
+        explicit Stage(StageHandler &&p_fHandler) : m_fHandler(std::move(p_fHandler)) {}
+
+        StageHandler m_fHandler;
+        //! Number of items this stage finished, written by the stage only
+        alignas(64) std::atomic<unsigned long long> m_ullCursor{0};
+        std::atomic<bool> m_bIsFinished{false};
+        std::atomic<unsigned long long> m_ullBatches{0};
+        std::atomic<unsigned long long> m_ullLargestBatch{0};
+    };
+
+    static constexpr int s_iSpinsBeforeBlocking = 64;
+
+    static std::size_t RoundUpToPowerOfTwo(std::size_t p_sValue)
+    {
+        std::size_t sPowerOfTwo = 1;
+        while (sPowerOfTwo < p_sValue)
+        {
+            sPowerOfTwo <<= 1;
+        }
+        return sPowerOfTwo;
+    }
+
+    bool RunStage(std::size_t p_sStage)
+    {
+        Stage &oStage = m_oStages[p_sStage];
+        const std::atomic<unsigned long long> &oBarrier = p_sStage == 0 ? m_ullPublished : m_oStages[p_sStage - 1].m_ullCursor;
+        auto isPreviousFinished = [this, p_sStage]()
+        {
+            return p_sStage == 0 ? m_bIsPublishingDone.load() : m_oStages[p_sStage - 1].m_bIsFinished.load();
+        };
+
+        unsigned long long ullNext = 0;
+        while (true)
+        {
+            WaitFor([&oBarrier, &isPreviousFinished, ullNext]()
+                    { return oBarrier.load() > ullNext || isPreviousFinished(); });
+            //! Read the previous stage state before the barrier, so nothing it published before finishing is missed
+            bool bIsPreviousFinished = isPreviousFinished();
+            unsigned long long ullAvailable = oBarrier.load();
+            if (ullAvailable == ullNext)
+            {
+                if (bIsPreviousFinished)
+                {
+                    break;
+                }
+                continue;
+            }
+
+            //! Catch up in bulk, the whole batch is already visible to us
+            for (unsigned long long ullSequence = ullNext; ullSequence < ullAvailable; ++ullSequence)
+            {
+                oStage.m_fHandler(m_vecRing[ullSequence & m_ullMask]);
+            }
+            unsigned long long ullBatchSize = ullAvailable - ullNext;
+            ullNext = ullAvailable;
+            oStage.m_ullCursor.store(ullNext);
+            oStage.m_ullBatches.fetch_add(1, std::memory_order_relaxed);
+            if (ullBatchSize > oStage.m_ullLargestBatch.load(std::memory_order_relaxed))
+            {
+                oStage.m_ullLargestBatch.store(ullBatchSize, std::memory_order_relaxed);
+            }
+            WakeUpWaiters();
+        }
+        oStage.m_bIsFinished.store(true);
+        WakeUpWaiters();
+        return true;
+    }
+
+    //! Spin for a while then sleep till p_fCondition holds
+    //! Conditions only read atomics , so they can be checked without holding the lock
+    template <typename Condition>
+    bool WaitFor(Condition &&p_fCondition)
+    {
+        for (int iSpin = 0; iSpin < s_iSpinsBeforeBlocking; ++iSpin)
+        {
+            if (p_fCondition())
+            {
+                return true;
+            }
+            std::this_thread::yield();
+        }
+        std::unique_lock<std::mutex> oLock{m_oWaitMutex};
+        //! Announce we are about to sleep BEFORE checking the condition again
+        //! whoever changes a cursor checks the waiters AFTER changing it , so one of us sees the other
+        m_iWaiters.fetch_add(1);
+        m_oWaitCv.wait(oLock, p_fCondition);
+        m_iWaiters.fetch_sub(1);
+        return true;
+    }
+
+    void WakeUpWaiters()
+    {
+        if (m_iWaiters.load() == 0)
+        {
+            return;
+        }
+        {
+            //! Waiter is either before its condition check or already waiting , never in between
+            std::lock_guard<std::mutex> oLock{m_oWaitMutex};
+        }
+        m_oWaitCv.notify_all();
+    }
+
+    std::vector<T> m_vecRing;
+    unsigned long long m_ullMask;
+    //! deque , stages hold atomics and are never moved once added
+    std::deque<Stage> m_oStages;
+    std::vector<BasicThreadPool::ResultChannel<bool>> m_vecStagesResults;
+    bool m_bIsStarted{false};
+
+    std::mutex m_oPublishMutex;
+    alignas(64) std::atomic<unsigned long long> m_ullPublished{0};
+    std::atomic<bool> m_bIsClosed{false};
+    std::atomic<bool> m_bIsPublishingDone{false};
+
+    std::mutex m_oWaitMutex;
+    std::condition_variable m_oWaitCv;
+    std::atomic<int> m_iWaiters{0};
+};
\ No newline at end of file
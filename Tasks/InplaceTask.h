@@ -0,0 +1,153 @@
+#pragma once
+
+//! System includes
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/*
+- Move only replacement for std::function<void(void)> used by all executors (Thread, BasicThreadPool, Actor)
+- Callables up to Capacity bytes are stored inline , no heap allocation per task
+- Bigger ones (or ones that can throw while being moved) fall back to the heap, same as std::function would
+- Being move only it accepts move only captures (unique_ptr, promises, other tasks ...)
+*/
+template <std::size_t Capacity = 64>
+class InplaceTask
+{
+public:
+    InplaceTask() noexcept = default;
+    InplaceTask(std::nullptr_t) noexcept {}
+
+    template <typename Function,
+              typename = std::enable_if_t<!std::is_same_v<std::decay_t<Function>, InplaceTask> &&
+                                          !std::is_same_v<std::decay_t<Function>, std::nullptr_t>>>
+    InplaceTask(Function &&p_fFunction)
+    {
+        using Callable = std::decay_t<Function>;
+        if constexpr (IsStoredInline<Callable>())
+        {
+            new (&m_oStorage) Callable(std::forward<Function>(p_fFunction));
+            m_pVTable = &s_oInlineVTable<Callable>;
+        }
+        else
+        {
+            new (&m_oStorage) Callable *(new Callable(std::forward<Function>(p_fFunction)));
+            m_pVTable = &s_oHeapVTable<Callable>;
+        }
+    }
+
+    InplaceTask(InplaceTask &&p_oOther) noexcept
+    {
+        MoveFrom(p_oOther);
+    }
+
+    InplaceTask &operator=(InplaceTask &&p_oOther) noexcept
+    {
+        if (this != &p_oOther)
+        {
+            Reset();
+            MoveFrom(p_oOther);
+        }
+        return *this;
+    }
+
+    InplaceTask &operator=(std::nullptr_t) noexcept
+    {
+        Reset();
+        return *this;
+    }
+
+    InplaceTask(const InplaceTask &) = delete;
+    InplaceTask &operator=(const InplaceTask &) = delete;
+
+    ~InplaceTask()
+    {
+        Reset();
+    }
+
+    //! Throws std::bad_function_call on an empty (or moved from) task , same as std::function
+    void operator()()
+    {
+        if (m_pVTable == nullptr)
+        {
+            throw std::bad_function_call();
+        }
+        m_pVTable->m_fInvoke(&m_oStorage);
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return m_pVTable != nullptr;
+    }
+
+private:
+    struct VTable
+    {
+        void (*m_fInvoke)(void *);
+        //! Move constructs into destination and destroys source
+        void (*m_fRelocate)(void *p_pDestination, void *p_pSource) noexcept;
+        void (*m_fDestroy)(void *) noexcept;
+    };
+
+    template <typename Callable>
+    static constexpr bool IsStoredInline()
+    {
+        return sizeof(Callable) <= Capacity &&
+               alignof(Callable) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible_v<Callable>;
+    }
+
+    template <typename Callable>
+    static inline const VTable s_oInlineVTable{
+        [](void *p_pStorage)
+        { (*static_cast<Callable *>(p_pStorage))(); },
+        [](void *p_pDestination, void *p_pSource) noexcept
+        {
+            Callable *pSource = static_cast<Callable *>(p_pSource);
+            new (p_pDestination) Callable(std::move(*pSource));
+            pSource->~Callable();
+        },
+        [](void *p_pStorage) noexcept
+        { static_cast<Callable *>(p_pStorage)->~Callable(); }};
+
+    //! Storage only holds the pointer, relocating it is just copying that pointer
+    template <typename Callable>
+    static inline const VTable s_oHeapVTable{
+        [](void *p_pStorage)
+        { (**static_cast<Callable **>(p_pStorage))(); },
+        [](void *p_pDestination, void *p_pSource) noexcept
+        { new (p_pDestination) Callable *(*static_cast<Callable **>(p_pSource)); },
+        [](void *p_pStorage) noexcept
+        { delete *static_cast<Callable **>(p_pStorage); }};
+
+    void MoveFrom(InplaceTask &p_oOther) noexcept
+    {
+        if (p_oOther.m_pVTable == nullptr)
+        {
+            return;
+        }
+        p_oOther.m_pVTable->m_fRelocate(&m_oStorage, &p_oOther.m_oStorage);
+        m_pVTable = p_oOther.m_pVTable;
+        p_oOther.m_pVTable = nullptr;
+    }
+
+    void Reset() noexcept
+    {
+        if (m_pVTable == nullptr)
+        {
+            return;
+        }
+        m_pVTable->m_fDestroy(&m_oStorage);
+        m_pVTable = nullptr;
+    }
+
+    static_assert(Capacity >= sizeof(void *), "InplaceTask needs at least room for a pointer");
+
+    alignas(std::max_align_t) std::byte m_oStorage[Capacity];
+    const VTable *m_pVTable{nullptr};
+};
+
+//! Default task type used by the executors
+using Task = InplaceTask<>;
\ No newline at end of file
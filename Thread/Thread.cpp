@@ -22,15 +22,11 @@ void Thread::EventLoop()
     }
 }
 
-void Thread::StartTask(std::function<void(void)> &&p_oWorker)
+void Thread::StartTask(Task &&p_oWorker)
 {
+    //! Worker is sent as is , no wrapping it in another task (that would need another allocation)
     ThreadOperationMessage oMessage;
-    oMessage.m_fMessageHandler = [this, worker = std::move(p_oWorker)]()
-    {
-        m_oTask = std::move(worker);
-        m_oTask();
-        m_oTask = nullptr;
-    };
+    oMessage.m_fMessageHandler = std::move(p_oWorker);
     m_oChannel.SendValue(std::move(oMessage));
 }
 
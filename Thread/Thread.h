@@ -1,15 +1,17 @@
 #pragma once
 
 //! System includes
-#include <functional>
 #include <thread>
 
 //! Channels
 #include "UnBufferedChannel.h"
 
+//! Tasks
+#include "InplaceTask.h"
+
 struct ThreadOperationMessage
 {
-    std::function<void(void)> m_fMessageHandler;
+    Task m_fMessageHandler;
 };
 
 /*
@@ -22,14 +24,13 @@ public:
     Thread();
     ~Thread();
 
-    void StartTask(std::function<void(void)> &&p_oWorker);
+    void StartTask(Task &&p_oWorker);
     void Stop();
 
 private:
     void EventLoop();
 
     UnBufferedChannel<ThreadOperationMessage> m_oChannel;
-    std::function<void(void)> m_oTask;
     std::thread m_oThread;
     bool m_bIsTerminated{false};
 };
\ No newline at end of file
@@ -1,12 +1,14 @@
-#pragma once
-
 #include "BasicThreadPool.h"
-#include "UnBufferedChannel.h"
 
-BasicThreadPool::BasicThreadPool()
+BasicThreadPool::BasicThreadPool(std::pmr::memory_resource *p_pMemoryResource)
+    : BasicThreadPool(std::thread::hardware_concurrency(), p_pMemoryResource)
 {
-    unsigned int uiThreadsCount = std::thread::hardware_concurrency();
-    for (unsigned int uiThreadNumber = 0; uiThreadNumber < uiThreadsCount; ++uiThreadNumber)
+}
+
+BasicThreadPool::BasicThreadPool(unsigned int p_uiThreadsCount, std::pmr::memory_resource *p_pMemoryResource)
+    : m_oTasks(std::pmr::deque<TaskWrapper>(p_pMemoryResource))
+{
+    for (unsigned int uiThreadNumber = 0; uiThreadNumber < p_uiThreadsCount; ++uiThreadNumber)
     {
         m_vecWorkers.push_back(std::make_shared<Thread>());
         m_vecWorkers.back()->StartTask(std::bind(&BasicThreadPool::WorkerHandler, this));
@@ -16,6 +18,8 @@ BasicThreadPool::BasicThreadPool()
 BasicThreadPool::~BasicThreadPool()
 {
     Stop();
+    //! Join the workers (they drain the remaining tasks) while every member is still alive
+    m_vecWorkers.clear();
 }
 
 void BasicThreadPool::Stop()
@@ -27,27 +31,21 @@ void BasicThreadPool::Stop()
     m_oTasksCv.notify_all();
 }
 
-template <typename T>
-BasicThreadPool::ResultChannel<T> BasicThreadPool::SubmitTask(std::function<T(void)> &&p_fTask)
+void BasicThreadPool::PostTask(TaskWrapper &&p_fTask)
 {
-    ResultChannel<T> pResultChannel = std::make_shared<UnBufferedChannel<T>>();
-    TaskWrapper fTaskWrapper = [pResultChannel, fTaskToExecute = std::move(p_fTask)]()
-    {
-        T tResult = fTaskToExecute();
-        pResultChannel->SendValue(std::move(tResult));
-    };
-
     {
         std::lock_guard<std::mutex> oLock{m_oTasksMutex};
-        m_oTasks.push(fTaskWrapper);
+        m_oTasks.push(std::move(p_fTask));
+        CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oQueueHighWaterMark.Update(m_oTasks.size());)
     }
+    CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oSubmitted.Add();)
     m_oTasksCv.notify_one();
-    return pResultChannel;
 }
 
 void BasicThreadPool::WorkerHandler()
 {
-    while (!m_bIsTerminated)
+    //! Termination is only checked under the tasks lock , see below
+    while (true)
     {
         TaskWrapper fTask;
         {
@@ -59,12 +57,22 @@ void BasicThreadPool::WorkerHandler()
             {
                 return;
             }
-            fTask = m_oTasks.front();
+            fTask = std::move(m_oTasks.front());
             m_oTasks.pop();
         }
         //! Execute Task after Releasing Lock
         //! Avoid Deadlocks | Undefined behaviour if the user code (Task) calls Thread Pool again
         //! Will try to lock while holding the lock from the same thread
+        CONCURRENCY_LIB_METRICS_ONLY(MetricsClock::time_point oStartTime = MetricsClock::now();)
         fTask();
+        CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oExecutionTime.Record(MetricsElapsedNanoseconds(oStartTime));)
+        CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oExecuted.Add();)
     }
+}
+
+ThreadPoolMetricsSnapshot BasicThreadPool::GetMetricsSnapshot() const
+{
+    ThreadPoolMetricsSnapshot oSnapshot;
+    CONCURRENCY_LIB_METRICS_ONLY(oSnapshot = m_oMetrics.Snapshot();)
+    return oSnapshot;
 }
\ No newline at end of file
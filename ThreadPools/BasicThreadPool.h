@@ -2,39 +2,60 @@
 
 //! Tasks
 #include <queue>
+#include <deque>
 #include <functional>
+#include <memory_resource>
 
 //! Threading
 #include <mutex>
 #include <condition_variable>
 #include <Thread.h>
+#include "InplaceTask.h"
 
-template <typename T>
-class UnBufferedChannel;
+//! Instrumentation
+#include "Metrics.h"
+#include "Tracing.h"
+
+//! Channels
+#include "CompactChannel.h"
 
 class BasicThreadPool
 {
 public:
+    //! One value per task , the worker never waits for the caller to read it
     template <typename T>
-    using ResultChannel = std::shared_ptr<UnBufferedChannel<T>>;
-    using TaskWrapper = std::function<void(void)>;
-
-    BasicThreadPool();
+    using ResultChannel = std::shared_ptr<OneShotChannel<T>>;
+    using TaskWrapper = Task;
+
+    //! Tasks queue draws its memory from p_pMemoryResource
+    //! it is only touched while holding the tasks lock, so an unsynchronized resource is fine
+    BasicThreadPool(std::pmr::memory_resource *p_pMemoryResource = std::pmr::get_default_resource());
+    //! Long running tasks (pipeline stages ...) each hold a worker , size the pool for them explicitly
+    explicit BasicThreadPool(unsigned int p_uiThreadsCount, std::pmr::memory_resource *p_pMemoryResource = std::pmr::get_default_resource());
     ~BasicThreadPool();
 
-    template <typename T>
-    ResultChannel<T> SubmitTask(std::function<T(void)> &&p_fTask);
+    //! Function is any callable returning T , move only callables are accepted
+    //! it is stored inline in the task (no allocation) as long as it fits in the task capacity
+    template <typename T, typename Function>
+    ResultChannel<T> SubmitTask(Function &&p_fTask);
+    //! Fire and forget , no result channel (event driven stages re scheduling themselves ...)
+    void PostTask(TaskWrapper &&p_fTask);
     void Stop();
 
+    //! All zeros unless built with CONCURRENCY_LIB_METRICS
+    ThreadPoolMetricsSnapshot GetMetricsSnapshot() const;
+
 private:
     void WorkerHandler();
 
-    std::queue<TaskWrapper> m_oTasks;
+    std::queue<TaskWrapper, std::pmr::deque<TaskWrapper>> m_oTasks;
     std::mutex m_oTasksMutex;
     std::condition_variable m_oTasksCv;
     bool m_bIsTerminated{false};
+    //! Declared before the workers , the last tasks still record into it while they are joined
+    CONCURRENCY_LIB_METRICS_ONLY(ThreadPoolMetrics m_oMetrics;)
     std::vector<std::shared_ptr<Thread>> m_vecWorkers;
 };
 
 //! Template Implementaiton
-#include "BasicThreadPool.cpp"
\ No newline at end of file
+#include "BasicThreadPool.tpp"
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+
+//! Template Implementaiton of BasicThreadPool , included by BasicThreadPool.h
+#include "CompactChannel.h"
+#include "SlabAllocator.h"
+
+template <typename T, typename Function>
+BasicThreadPool::ResultChannel<T> BasicThreadPool::SubmitTask(Function &&p_fTask)
+{
+    //! One channel per task, recycle its memory (channel + control block) instead of hitting malloc every time
+    ResultChannel<T> pResultChannel = std::allocate_shared<OneShotChannel<T>>(SlabAllocator<OneShotChannel<T>>{});
+    //! Flow links the enqueue on this thread to the execution on the worker
+    CONCURRENCY_LIB_TRACING_ONLY(unsigned long long ullFlowId = Tracer::Instance().NextFlowId();)
+    CONCURRENCY_LIB_TRACE("Task::Enqueue", TracePhase::Begin, ullFlowId);
+    CONCURRENCY_LIB_TRACE("Task", TracePhase::FlowStart, ullFlowId);
+    TaskWrapper fTaskWrapper = [CONCURRENCY_LIB_METRICS_ONLY(this, oEnqueueTime = MetricsClock::now(), )
+                                CONCURRENCY_LIB_TRACING_ONLY(ullFlowId, )
+                                pResultChannel, fTaskToExecute = std::forward<Function>(p_fTask)]() mutable
+    {
+        CONCURRENCY_LIB_METRICS_ONLY(m_oMetrics.m_oQueueWaitTime.Record(MetricsElapsedNanoseconds(oEnqueueTime));)
+        CONCURRENCY_LIB_TRACE("Task::Execute", TracePhase::Begin, ullFlowId);
+        CONCURRENCY_LIB_TRACE("Task", TracePhase::FlowEnd, ullFlowId);
+        T tResult = fTaskToExecute();
+        pResultChannel->SendValue(std::move(tResult));
+        CONCURRENCY_LIB_TRACE("Task::Execute", TracePhase::End, ullFlowId);
+    };
+
+    PostTask(std::move(fTaskWrapper));
+    CONCURRENCY_LIB_TRACE("Task::Enqueue", TracePhase::End, ullFlowId);
+    return pResultChannel;
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "Strand.h"
+
+#include <stdexcept>
+
+Strand::Strand(BasicThreadPool &p_oPool)
+    : m_oPool(p_oPool)
+{
+}
+
+Strand::~Strand()
+{
+    std::unique_lock<std::mutex> oLock{m_oMutex};
+    m_oIdleCv.wait(oLock, [this]()
+                   { return !m_bIsScheduled; });
+}
+
+void Strand::Post(Task &&p_fTask)
+{
+    {
+        std::lock_guard<std::mutex> oLock{m_oMutex};
+        m_vecPending.push_back(std::move(p_fTask));
+        if (m_bIsScheduled)
+        {
+            //! The running activation picks it up
+            return;
+        }
+        m_bIsScheduled = true;
+    }
+    m_oPool.PostTask([this]()
+                     { Run(); });
+}
+
+void Strand::Run()
+{
+    CONCURRENCY_LIB_TRACE("Strand::Run", TracePhase::Begin, reinterpret_cast<unsigned long long>(this));
+    for (std::size_t sCount = 0; sCount < s_sTasksPerActivation; ++sCount)
+    {
+        if (m_sNextToRun == m_vecRunning.size())
+        {
+            //! Keep the capacity , swap it for the tasks posted meanwhile
+            m_vecRunning.clear();
+            m_sNextToRun = 0;
+            std::lock_guard<std::mutex> oLock{m_oMutex};
+            if (m_vecPending.empty())
+            {
+                m_bIsScheduled = false;
+                //! Under the lock , the destructor may free the strand as soon as it sees the flag
+                m_oIdleCv.notify_all();
+                CONCURRENCY_LIB_TRACE("Strand::Run", TracePhase::End, reinterpret_cast<unsigned long long>(this));
+                return;
+            }
+            m_vecPending.swap(m_vecRunning);
+        }
+        Task &fTask = m_vecRunning[m_sNextToRun++];
+        fTask();
+        //! Release the captures now , not when the batch is recycled
+        fTask = nullptr;
+    }
+    //! Budget used , queue behind the other tasks of the pool
+    CONCURRENCY_LIB_TRACE("Strand::Run", TracePhase::End, reinterpret_cast<unsigned long long>(this));
+    m_oPool.PostTask([this]()
+                     { Run(); });
+}
+
+KeyedExecutor::KeyedExecutor(BasicThreadPool &p_oPool, std::size_t p_sStrandsCount)
+{
+    if (p_sStrandsCount == 0)
+    {
+        throw std::logic_error("Cannot Create a KeyedExecutor With 0 strands");
+    }
+    m_vecStrands.reserve(p_sStrandsCount);
+    for (std::size_t sStrand = 0; sStrand < p_sStrandsCount; ++sStrand)
+    {
+        m_vecStrands.push_back(std::make_unique<Strand>(p_oPool));
+    }
+}
\ No newline at end of file
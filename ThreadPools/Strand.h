@@ -0,0 +1,94 @@
+#pragma once
+
+//! System includes
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+//! Threading
+#include <mutex>
+#include <condition_variable>
+#include "InplaceTask.h"
+
+//! Executors
+#include "BasicThreadPool.h"
+
+/*
+- Strand : tasks posted to it run one at a time , in the order they were posted , on any worker of a BasicThreadPool
+    - replaces a dedicated Thread / Actor per ordered stream (per entity , per connection , per account ..)
+    - no thread of its own , an idle strand is a mutex , a flag and two empty vectors
+    - one activation (pool task) runs up to s_sTasksPerActivation tasks back to back (warm caches) , then re posts itself so other strands get the worker
+    - producers append to a pending vector , the activation swaps it with its own one , one lock per batch instead of one per task
+- KeyedExecutor : a fixed set of strands , a key is hashed to one of them , same key => same strand => submission order
+*/
+
+//! Questions / Edgecases:
+//! Q: Is a strand tied to one worker ?
+//!     No, consecutive activations may run on different workers , the strand lock orders them (everything a task wrote is visible to the next one)
+//! Q: Destroying a strand with tasks still queued ?
+//!     the destructor waits till they all ran , the pool has to outlive its strands
+//! Q: Two keys on the same strand ?
+//!     they are serialized together (not reordered) , more strands than busy keys keeps that rare
+
+class Strand
+{
+public:
+    explicit Strand(BasicThreadPool &p_oPool);
+    Strand(const Strand &) = delete;
+    Strand &operator=(const Strand &) = delete;
+    ~Strand();
+
+    //! Runs after every task posted before it , fire and forget
+    void Post(Task &&p_fTask);
+
+    //! Same as BasicThreadPool::SubmitTask , the result comes on a one shot channel
+    template <typename T, typename Function>
+    BasicThreadPool::ResultChannel<T> SubmitTask(Function &&p_fTask);
+
+private:
+    static constexpr std::size_t s_sTasksPerActivation = 64;
+
+    void Run();
+
+    BasicThreadPool &m_oPool;
+    std::mutex m_oMutex;
+    //! Guarded by m_oMutex
+    std::vector<Task> m_vecPending;
+    bool m_bIsScheduled{false};
+    std::condition_variable m_oIdleCv;
+    //! Only touched by the running activation
+    std::vector<Task> m_vecRunning;
+    std::size_t m_sNextToRun{0};
+};
+
+class KeyedExecutor
+{
+public:
+    KeyedExecutor(BasicThreadPool &p_oPool, std::size_t p_sStrandsCount);
+
+    template <typename Key>
+    void Post(const Key &p_oKey, Task &&p_fTask)
+    {
+        GetStrand(p_oKey).Post(std::move(p_fTask));
+    }
+
+    template <typename T, typename Key, typename Function>
+    BasicThreadPool::ResultChannel<T> SubmitTask(const Key &p_oKey, Function &&p_fTask)
+    {
+        return GetStrand(p_oKey).template SubmitTask<T>(std::forward<Function>(p_fTask));
+    }
+
+    template <typename Key>
+    Strand &GetStrand(const Key &p_oKey)
+    {
+        return *m_vecStrands[std::hash<Key>()(p_oKey) % m_vecStrands.size()];
+    }
+
+private:
+    //! Strands hold a mutex , never moved
+    std::vector<std::unique_ptr<Strand>> m_vecStrands;
+};
+
+//! Template Implementaiton
+#include "Strand.tpp"
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+
+//! Template Implementaiton of Strand , included by Strand.h
+#include "CompactChannel.h"
+#include "SlabAllocator.h"
+
+template <typename T, typename Function>
+BasicThreadPool::ResultChannel<T> Strand::SubmitTask(Function &&p_fTask)
+{
+    BasicThreadPool::ResultChannel<T> pResultChannel = std::allocate_shared<OneShotChannel<T>>(SlabAllocator<OneShotChannel<T>>{});
+    Post([pResultChannel, fTaskToExecute = std::forward<Function>(p_fTask)]() mutable
+         {
+        T tResult = fTaskToExecute();
+        pResultChannel->SendValue(std::move(tResult)); });
+    return pResultChannel;
+}
\ No newline at end of file
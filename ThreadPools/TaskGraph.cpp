@@ -0,0 +1,154 @@
+#include "TaskGraph.h"
+
+#include <stdexcept>
+
+TaskGraph::~TaskGraph()
+{
+    Wait();
+}
+
+TaskGraph::TaskHandle TaskGraph::Emplace(Task &&p_fTask)
+{
+    ThrowIfRunning();
+    m_dqNodes.emplace_back(std::move(p_fTask));
+    m_bIsValidated = false;
+    return TaskHandle(this, &m_dqNodes.back());
+}
+
+void TaskGraph::AddEdge(Node *p_pFrom, Node *p_pTo)
+{
+    ThrowIfRunning();
+    p_pFrom->m_vecSuccessors.push_back(p_pTo);
+    p_pTo->m_uiPredecessorsCount++;
+    m_bIsValidated = false;
+}
+
+void TaskGraph::ThrowIfRunning() const
+{
+    std::lock_guard<std::mutex> oLock{m_oRunMutex};
+    if (m_bIsRunning)
+    {
+        throw std::logic_error("TaskGraph Is Running");
+    }
+}
+
+void TaskGraph::Validate()
+{
+    m_vecSources.clear();
+    std::vector<Node *> vecReady;
+    for (Node &oNode : m_dqNodes)
+    {
+        oNode.m_uiPendingPredecessors.store(oNode.m_uiPredecessorsCount, std::memory_order_relaxed);
+        if (oNode.m_uiPredecessorsCount == 0)
+        {
+            m_vecSources.push_back(&oNode);
+            vecReady.push_back(&oNode);
+        }
+    }
+    std::size_t sVisited = 0;
+    while (!vecReady.empty())
+    {
+        Node *pNode = vecReady.back();
+        vecReady.pop_back();
+        sVisited++;
+        for (Node *pSuccessor : pNode->m_vecSuccessors)
+        {
+            if (pSuccessor->m_uiPendingPredecessors.fetch_sub(1, std::memory_order_relaxed) == 1)
+            {
+                vecReady.push_back(pSuccessor);
+            }
+        }
+    }
+    if (sVisited != m_dqNodes.size())
+    {
+        throw std::logic_error("TaskGraph Has A Cycle");
+    }
+    m_bIsValidated = true;
+}
+
+void TaskGraph::Run(BasicThreadPool &p_oPool)
+{
+    {
+        std::lock_guard<std::mutex> oLock{m_oRunMutex};
+        if (m_bIsRunning)
+        {
+            throw std::logic_error("TaskGraph Is Already Running");
+        }
+        if (!m_bIsValidated)
+        {
+            Validate();
+        }
+        if (m_dqNodes.empty())
+        {
+            return;
+        }
+        m_bIsRunning = true;
+    }
+    m_pPool = &p_oPool;
+    for (Node &oNode : m_dqNodes)
+    {
+        oNode.m_uiPendingPredecessors.store(oNode.m_uiPredecessorsCount, std::memory_order_relaxed);
+    }
+    //! Published to the workers by the pool lock taken in PostTask
+    m_sPendingTasks.store(m_dqNodes.size(), std::memory_order_relaxed);
+    //! Sources only change when the graph is edited , which throws till the run ends
+    for (Node *pSource : m_vecSources)
+    {
+        Schedule(pSource);
+    }
+}
+
+void TaskGraph::Wait()
+{
+    std::unique_lock<std::mutex> oLock{m_oRunMutex};
+    m_oRunCv.wait(oLock, [this]()
+                  { return !m_bIsRunning; });
+}
+
+std::size_t TaskGraph::GetTasksCount() const
+{
+    return m_dqNodes.size();
+}
+
+void TaskGraph::Schedule(Node *p_pNode)
+{
+    m_pPool->PostTask([this, p_pNode]()
+                      { Execute(p_pNode); });
+}
+
+void TaskGraph::Execute(Node *p_pNode)
+{
+    while (p_pNode != nullptr)
+    {
+        CONCURRENCY_LIB_TRACE("TaskGraph::Task", TracePhase::Begin, reinterpret_cast<unsigned long long>(p_pNode));
+        p_pNode->m_fTask();
+        CONCURRENCY_LIB_TRACE("TaskGraph::Task", TracePhase::End, reinterpret_cast<unsigned long long>(p_pNode));
+        Node *pContinuation = nullptr;
+        for (Node *pSuccessor : p_pNode->m_vecSuccessors)
+        {
+            //! acq_rel : the last predecessor sees what every other one wrote before running the successor
+            if (pSuccessor->m_uiPendingPredecessors.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            {
+                continue;
+            }
+            if (pContinuation == nullptr)
+            {
+                pContinuation = pSuccessor;
+            }
+            else
+            {
+                Schedule(pSuccessor);
+            }
+        }
+        if (m_sPendingTasks.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            //! Last task of the run , nothing can be left to continue with
+            //! Under the lock , the graph may be destroyed / run again as soon as the waiter sees the flag
+            std::lock_guard<std::mutex> oLock{m_oRunMutex};
+            m_bIsRunning = false;
+            m_oRunCv.notify_all();
+            return;
+        }
+        p_pNode = pContinuation;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#pragma once
+
+//! System includes
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+//! Threading
+#include <mutex>
+#include <condition_variable>
+#include "InplaceTask.h"
+
+//! Executors
+#include "BasicThreadPool.h"
+
+/*
+- TaskGraph : a DAG of tasks run on a BasicThreadPool , a task is posted as soon as all its predecessors finished
+    - no worker ever blocks on an upstream result (unlike chaining SubmitTask + ReadValue inside tasks)
+    - every task has an atomic count of the predecessors still running , the last one to finish schedules it
+    - the finishing worker keeps one ready successor for itself (no queue round trip , warm caches) and posts the others
+    - built once , run many times : Run only resets the counters , nodes / edges / sources are allocated while building
+*/
+
+//! Questions / Edgecases:
+//! Q: Where do results go ?
+//!     tasks capture their inputs / outputs (by reference to data owned next to the graph) , edges order them (happens before)
+//! Q: Cycles ?
+//!     Run throws std::logic_error , checked once after each change of the graph
+//! Q: Editing or running a graph while it runs ?
+//!     std::logic_error , Wait first
+//! Q: Waiting from a pool worker ?
+//!     Wait blocks the calling thread , from inside a task of the same pool it holds a worker that the graph may need
+
+class TaskGraph
+{
+    struct Node;
+
+public:
+    //! Lightweight handle to a task of the graph , used to add edges
+    class TaskHandle
+    {
+    public:
+        //! this runs before every task in p_oTasks
+        template <typename... Tasks>
+        TaskHandle &Precede(TaskHandle p_oTask, Tasks... p_oTasks)
+        {
+            m_pGraph->AddEdge(m_pNode, p_oTask.m_pNode);
+            if constexpr (sizeof...(Tasks) > 0)
+            {
+                Precede(p_oTasks...);
+            }
+            return *this;
+        }
+
+        //! this runs after every task in p_oTasks
+        template <typename... Tasks>
+        TaskHandle &Succeed(TaskHandle p_oTask, Tasks... p_oTasks)
+        {
+            m_pGraph->AddEdge(p_oTask.m_pNode, m_pNode);
+            if constexpr (sizeof...(Tasks) > 0)
+            {
+                Succeed(p_oTasks...);
+            }
+            return *this;
+        }
+
+    private:
+        friend class TaskGraph;
+        TaskHandle(TaskGraph *p_pGraph, Node *p_pNode) : m_pGraph(p_pGraph), m_pNode(p_pNode) {}
+
+        TaskGraph *m_pGraph;
+        Node *m_pNode;
+    };
+
+    TaskGraph() = default;
+    TaskGraph(const TaskGraph &) = delete;
+    TaskGraph &operator=(const TaskGraph &) = delete;
+    //! Waits for a run in progress
+    ~TaskGraph();
+
+    //! The task is called once per Run , so it must stay callable (don't move its captures out)
+    TaskHandle Emplace(Task &&p_fTask);
+
+    //! Posts the tasks without predecessors and returns , Wait for the end of the run
+    void Run(BasicThreadPool &p_oPool);
+    void Wait();
+    std::size_t GetTasksCount() const;
+
+private:
+    struct Node
+    {
+        explicit Node(Task &&p_fTask) : m_fTask(std::move(p_fTask)) {}
+
+        Task m_fTask;
+        std::vector<Node *> m_vecSuccessors;
+        unsigned int m_uiPredecessorsCount{0};
+        std::atomic<unsigned int> m_uiPendingPredecessors{0};
+    };
+
+    void AddEdge(Node *p_pFrom, Node *p_pTo);
+    void ThrowIfRunning() const;
+    //! Kahn's algorithm , fills m_vecSources or throws on a cycle
+    void Validate();
+    void Execute(Node *p_pNode);
+    void Schedule(Node *p_pNode);
+
+    //! Deque so nodes (and their atomics) never move while the graph grows
+    std::deque<Node> m_dqNodes;
+    std::vector<Node *> m_vecSources;
+    bool m_bIsValidated{false};
+
+    BasicThreadPool *m_pPool{nullptr};
+    std::atomic<std::size_t> m_sPendingTasks{0};
+    mutable std::mutex m_oRunMutex;
+    std::condition_variable m_oRunCv;
+    //! Guarded by m_oRunMutex
+    bool m_bIsRunning{false};
+};
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include <chrono>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BasicThreadPool.h"
+#include "BufferedChannel.h"
+#include "ChannelSelector.h"
+
+//! Run the same binary with LD_PRELOAD to compare glibc malloc , jemalloc , tcmalloc (see Makefile)
+//! std::allocator rows go to whatever malloc is loaded , pmr rows only hit it when the pool needs to grow
+
+constexpr int PRODUCERS_COUNT = 4;
+constexpr int CONSUMERS_COUNT = 4;
+constexpr int MESSAGES_PER_PRODUCER = 50000;
+constexpr int TASKS_COUNT = 50000;
+
+template <typename Function>
+void Measure(const std::string &p_strName, int p_iOperations, Function p_fScenario)
+{
+    auto oStart = std::chrono::steady_clock::now();
+    p_fScenario();
+    auto oDuration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - oStart);
+    std::cerr << p_strName << ": " << oDuration.count() / 1000 << " ms, "
+              << (p_iOperations * 1000000.0) / (oDuration.count() + 1) << " ops/s\n";
+}
+
+//! Multi producers / Multi consumers over one channel, messages big enough to allocate (std::string with no SSO)
+template <typename Channel>
+void ChannelScenario(Channel &p_oChannel)
+{
+    std::vector<std::thread> vecThreads;
+    for (int i = 0; i < CONSUMERS_COUNT; ++i)
+    {
+        vecThreads.emplace_back([&p_oChannel]()
+                                {
+                                    std::string strValue;
+                                    for (int j = 0; j < PRODUCERS_COUNT * MESSAGES_PER_PRODUCER / CONSUMERS_COUNT; ++j)
+                                    {
+                                        p_oChannel.ReadValue(strValue);
+                                    } });
+    }
+    for (int i = 0; i < PRODUCERS_COUNT; ++i)
+    {
+        vecThreads.emplace_back([&p_oChannel]()
+                                {
+                                    for (int j = 0; j < MESSAGES_PER_PRODUCER; ++j)
+                                    {
+                                        p_oChannel.SendValue(std::string(64, 'x'));
+                                    } });
+    }
+    for (auto &oThread : vecThreads)
+    {
+        oThread.join();
+    }
+}
+
+void ThreadPoolScenario(BasicThreadPool &p_oPool)
+{
+    std::vector<BasicThreadPool::ResultChannel<int>> vecResults;
+    vecResults.reserve(TASKS_COUNT);
+    for (int i = 0; i < TASKS_COUNT; ++i)
+    {
+        vecResults.push_back(p_oPool.SubmitTask<int>(std::function<int(void)>([i]()
+                                                                               { return i; })));
+    }
+    for (auto &pResult : vecResults)
+    {
+        int iValue;
+        pResult->ReadValue(iValue);
+    }
+}
+
+void SelectorScenario(ChannelSelector &p_oSelector)
+{
+    std::vector<std::shared_ptr<IChannel<int>>> vecChannels;
+    for (int i = 0; i < 64; ++i)
+    {
+        vecChannels.push_back(std::make_shared<BufferedChannel<int>>(1024));
+        p_oSelector.AddChannel<int>(vecChannels.back(), [](int &) {});
+    }
+    for (int i = 0; i < TASKS_COUNT; ++i)
+    {
+        vecChannels[i % vecChannels.size()]->SendValue(std::move(i));
+        p_oSelector.SelectAndExecute();
+    }
+    p_oSelector.Close();
+}
+
+int main()
+{
+    int iChannelOperations = PRODUCERS_COUNT * MESSAGES_PER_PRODUCER;
+    Measure("BufferedChannel<std::string> std::allocator          ", iChannelOperations, []()
+            {
+                BufferedChannel<std::string> oChannel(1024);
+                ChannelScenario(oChannel); });
+    Measure("BufferedChannel<std::string> synchronized_pool_resource", iChannelOperations, []()
+            {
+                std::pmr::synchronized_pool_resource oResource;
+                PmrBufferedChannel<std::string> oChannel(1024, &oResource);
+                ChannelScenario(oChannel); });
+
+    Measure("BasicThreadPool std::allocator                       ", TASKS_COUNT, []()
+            {
+                BasicThreadPool oPool;
+                ThreadPoolScenario(oPool); });
+    Measure("BasicThreadPool unsynchronized_pool_resource          ", TASKS_COUNT, []()
+            {
+                std::pmr::unsynchronized_pool_resource oResource;
+                BasicThreadPool oPool(&oResource);
+                ThreadPoolScenario(oPool); });
+
+    Measure("ChannelSelector std::allocator                       ", TASKS_COUNT, []()
+            {
+                ChannelSelector oSelector;
+                SelectorScenario(oSelector); });
+    Measure("ChannelSelector monotonic_buffer_resource             ", TASKS_COUNT, []()
+            {
+                std::pmr::monotonic_buffer_resource oResource;
+                ChannelSelector oSelector(&oResource);
+                SelectorScenario(oSelector); });
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "AsyncFileIO.h"
+
+//! Writes a temp file in blocks then reads it back , every block checked , on both backends
+constexpr std::size_t IO_BLOCK_SIZE = 4096;
+constexpr std::size_t IO_BLOCKS_COUNT = 4096;
+
+static char BlockByte(std::size_t p_sBlock)
+{
+    return static_cast<char>('a' + p_sBlock % 26);
+}
+
+bool Scenario(const std::string &p_strName, BasicThreadPool &p_oPool, AsyncIOBackend p_eBackend)
+{
+    char arrPath[] = "/tmp/AsyncFileIO.XXXXXX";
+    int iFd = mkstemp(arrPath);
+    if (iFd < 0)
+    {
+        std::cerr << "mkstemp failed\n";
+        return false;
+    }
+    unlink(arrPath);
+
+    std::vector<char> vecWriteBuffer(IO_BLOCK_SIZE * IO_BLOCKS_COUNT);
+    std::vector<char> vecReadBuffer(IO_BLOCK_SIZE * IO_BLOCKS_COUNT, 0);
+    for (std::size_t sBlock = 0; sBlock < IO_BLOCKS_COUNT; ++sBlock)
+    {
+        std::memset(&vecWriteBuffer[sBlock * IO_BLOCK_SIZE], BlockByte(sBlock), IO_BLOCK_SIZE);
+    }
+
+    bool bResult = true;
+    auto oStart = std::chrono::steady_clock::now();
+    {
+        AsyncFileIO oAsyncIO(p_oPool, 256, p_eBackend);
+        std::cerr << p_strName << ": running on " << (oAsyncIO.GetBackend() == AsyncIOBackend::IoUring ? "io_uring" : "thread pool") << "\n";
+
+        //! Writes : result channels , every block in flight at once
+        std::vector<AsyncFileIO::ResultChannel> vecWrites;
+        for (std::size_t sBlock = 0; sBlock < IO_BLOCKS_COUNT; ++sBlock)
+        {
+            vecWrites.push_back(oAsyncIO.Write(iFd, &vecWriteBuffer[sBlock * IO_BLOCK_SIZE], IO_BLOCK_SIZE, sBlock * IO_BLOCK_SIZE));
+        }
+        for (auto &pWrite : vecWrites)
+        {
+            IOResult oResult;
+            pWrite->ReadValue(oResult);
+            bResult &= oResult.m_llResult == static_cast<long long>(IO_BLOCK_SIZE);
+        }
+
+        //! Reads : callbacks , counted down
+        std::atomic<std::size_t> sFailedReads{0};
+        for (std::size_t sBlock = 0; sBlock < IO_BLOCKS_COUNT; ++sBlock)
+        {
+            oAsyncIO.Read(iFd, &vecReadBuffer[sBlock * IO_BLOCK_SIZE], IO_BLOCK_SIZE, sBlock * IO_BLOCK_SIZE, [&sFailedReads](long long p_llResult)
+                          {
+                if (p_llResult != static_cast<long long>(IO_BLOCK_SIZE))
+                {
+                    sFailedReads++;
+                } });
+        }
+        //! Waits for every completion
+        oAsyncIO.Stop();
+        bResult &= sFailedReads.load() == 0;
+    }
+    auto oDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - oStart);
+
+    bResult &= vecReadBuffer == vecWriteBuffer;
+    std::cerr << p_strName << ": " << (bResult ? "OK" : "FAILED") << ", " << IO_BLOCKS_COUNT << " writes + " << IO_BLOCKS_COUNT << " reads of "
+              << IO_BLOCK_SIZE << " bytes in " << oDuration.count() << " ms\n";
+    close(iFd);
+    return bResult;
+}
+
+int main()
+{
+    BasicThreadPool oPool(4);
+    bool bResult = Scenario("io_uring  ", oPool, AsyncIOBackend::IoUring);
+    bResult &= Scenario("threadpool", oPool, AsyncIOBackend::ThreadPool);
+    return bResult ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BroadcastChannel.h"
+#include "ChannelSelector.h"
+
+constexpr int MESSAGES_COUNT = 10000;
+
+int main()
+{
+    BroadcastChannel<std::string> oChannel(64);
+
+    //! Two subscribers that must see everything , one that is allowed to lag and drop
+    auto pFastSubscriber = oChannel.Subscribe();
+    auto pSelectedSubscriber = oChannel.Subscribe();
+    auto pSlowSubscriber = oChannel.Subscribe(LagPolicy::Drop);
+
+    std::thread oFastConsumer([pFastSubscriber]()
+                              {
+                                  std::size_t sTotalSize = 0;
+                                  int iCount = 0;
+                                  //! Read in place, no copy of the string
+                                  while (iCount < MESSAGES_COUNT && pFastSubscriber->Read([&sTotalSize](const std::string &p_strMessage)
+                                                                                          { sTotalSize += p_strMessage.size(); }))
+                                  {
+                                      iCount++;
+                                  }
+                                  std::cerr << "Fast subscriber read " << iCount << " messages, " << sTotalSize << " bytes\n"; });
+
+    //! Subscribers are channels , so they can be selected on like any other channel
+    ChannelSelector oSelector;
+    int iSelectedCount = 0;
+    oSelector.AddChannel<std::string>(pSelectedSubscriber, [&iSelectedCount](std::string &)
+                                      { iSelectedCount++; });
+    std::thread oSelectingConsumer([&oSelector, &iSelectedCount]()
+                                   {
+                                       while (iSelectedCount < MESSAGES_COUNT && oSelector.SelectAndExecute())
+                                       {
+                                       }
+                                       std::cerr << "Selecting subscriber read " << iSelectedCount << " messages\n"; });
+
+    std::thread oSlowConsumer([pSlowSubscriber]()
+                              {
+                                  int iCount = 0;
+                                  while (pSlowSubscriber->Read([](const std::string &)
+                                                               { std::this_thread::sleep_for(std::chrono::microseconds(100)); }))
+                                  {
+                                      iCount++;
+                                  }
+                                  std::cerr << "Slow subscriber read " << iCount << " messages, dropped " << pSlowSubscriber->Dropped() << "\n"; });
+
+    for (int i = 0; i < MESSAGES_COUNT; ++i)
+    {
+        oChannel.SendValue("Message number " + std::to_string(i));
+    }
+
+    oFastConsumer.join();
+    oSelectingConsumer.join();
+    oSelector.Close();
+    oChannel.Close();
+    oSlowConsumer.join();
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "ByteStreamChannel.h"
+
+//! Producers serialize variable sized records straight into the ring , the consumer parses them in place
+//! operator new is counted to show steady state streaming doesn't allocate
+constexpr int PRODUCERS_COUNT = 2;
+constexpr unsigned long long RECORDS_PER_PRODUCER = 500000;
+constexpr std::size_t MAX_PAYLOAD_SIZE = 200;
+
+std::atomic<unsigned long long> g_ullAllocations{0};
+
+void *operator new(std::size_t p_sSize)
+{
+    g_ullAllocations++;
+    if (void *pMemory = std::malloc(p_sSize))
+    {
+        return pMemory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p_pMemory) noexcept
+{
+    std::free(p_pMemory);
+}
+
+void operator delete(void *p_pMemory, std::size_t) noexcept
+{
+    std::free(p_pMemory);
+}
+
+struct RecordHeader
+{
+    unsigned int m_uiSize; //! Payload bytes following the header
+    unsigned int m_uiProducer;
+    unsigned long long m_ullSequence;
+};
+
+std::byte PayloadByte(unsigned long long p_ullSequence, std::size_t p_sIndex)
+{
+    return static_cast<std::byte>((p_ullSequence + p_sIndex) & 0xff);
+}
+
+int main()
+{
+    ByteStreamChannel oChannel(64 * 1024);
+    std::vector<std::thread> vecProducers;
+    vecProducers.reserve(PRODUCERS_COUNT);
+
+    unsigned long long ullAllocationsBefore = g_ullAllocations;
+    for (unsigned int uiProducer = 0; uiProducer < PRODUCERS_COUNT; ++uiProducer)
+    {
+        vecProducers.emplace_back([&oChannel, uiProducer]()
+                                  {
+            for (unsigned long long ullSequence = 0; ullSequence < RECORDS_PER_PRODUCER; ++ullSequence)
+            {
+                RecordHeader oHeader{static_cast<unsigned int>(ullSequence % MAX_PAYLOAD_SIZE), uiProducer, ullSequence};
+                std::byte *pRecord = oChannel.Reserve(sizeof(RecordHeader) + oHeader.m_uiSize);
+                if (pRecord == nullptr)
+                {
+                    return;
+                }
+                std::memcpy(pRecord, &oHeader, sizeof(RecordHeader));
+                for (std::size_t sIndex = 0; sIndex < oHeader.m_uiSize; ++sIndex)
+                {
+                    pRecord[sizeof(RecordHeader) + sIndex] = PayloadByte(ullSequence, sIndex);
+                }
+                oChannel.Commit(sizeof(RecordHeader) + oHeader.m_uiSize);
+            } });
+    }
+
+    unsigned long long arrExpected[PRODUCERS_COUNT] = {};
+    unsigned long long ullRecordsRead = 0;
+    unsigned long long ullPeeks = 0;
+    bool bIsOk = true;
+    while (bIsOk && ullRecordsRead < PRODUCERS_COUNT * RECORDS_PER_PRODUCER)
+    {
+        const std::byte *pData = nullptr;
+        std::size_t sSize = 0;
+        oChannel.Peek(pData, sSize);
+        ullPeeks++;
+        //! Records never straddle the wrap , a peek always holds whole records
+        std::size_t sOffset = 0;
+        while (sOffset < sSize)
+        {
+            RecordHeader oHeader;
+            std::memcpy(&oHeader, pData + sOffset, sizeof(RecordHeader));
+            const std::byte *pPayload = pData + sOffset + sizeof(RecordHeader);
+            bIsOk = bIsOk && oHeader.m_uiProducer < PRODUCERS_COUNT && oHeader.m_ullSequence == arrExpected[oHeader.m_uiProducer]++;
+            for (std::size_t sIndex = 0; bIsOk && sIndex < oHeader.m_uiSize; ++sIndex)
+            {
+                bIsOk = pPayload[sIndex] == PayloadByte(oHeader.m_ullSequence, sIndex);
+            }
+            sOffset += sizeof(RecordHeader) + oHeader.m_uiSize;
+            ullRecordsRead++;
+        }
+        oChannel.Release(sSize);
+    }
+    if (!bIsOk)
+    {
+        oChannel.Close();
+    }
+    for (auto &oProducer : vecProducers)
+    {
+        oProducer.join();
+    }
+    unsigned long long ullAllocations = g_ullAllocations - ullAllocationsBefore;
+
+    std::cout << "Records read: " << ullRecordsRead << " in " << ullPeeks << " peeks" << std::endl;
+    //! Only the producer threads bookkeeping allocates
+    std::cout << "Allocations while streaming: " << ullAllocations << std::endl;
+    std::cout << (bIsOk ? "OK" : "FAILED") << std::endl;
+    return bIsOk ? 0 : 1;
+}
\ No newline at end of file
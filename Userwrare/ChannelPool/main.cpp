@@ -0,0 +1,92 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <thread>
+
+#include "ChannelFactory.h"
+
+//! Count every trip to the global allocator
+static std::atomic<unsigned long long> g_ullAllocations{0};
+
+void *operator new(std::size_t p_sBytes)
+{
+    g_ullAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *pBlock = std::malloc(p_sBytes))
+    {
+        return pBlock;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p_pBlock) noexcept
+{
+    std::free(p_pBlock);
+}
+
+void operator delete(void *p_pBlock, std::size_t) noexcept
+{
+    std::free(p_pBlock);
+}
+
+constexpr int MESSAGES_COUNT = 100000;
+
+//! Per request reply channel: create, send one value, read it, destroy
+template <typename MakeChannel>
+void ReplyChannelScenario(const std::string &p_strName, MakeChannel p_fMakeChannel)
+{
+    unsigned long long ullStart = g_ullAllocations.load();
+    auto oStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < MESSAGES_COUNT; ++i)
+    {
+        auto pChannel = p_fMakeChannel();
+        pChannel->SendValue(std::move(i));
+        int iValue;
+        pChannel->ReadValue(iValue);
+    }
+    auto oDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - oStart);
+    double dAllocationsPerMessage = double(g_ullAllocations.load() - ullStart) / MESSAGES_COUNT;
+    std::cerr << p_strName << ": " << dAllocationsPerMessage << " allocations/message, " << oDuration.count() << " ms\n";
+}
+
+//! Long lived BufferedChannel, producer and consumer threads streaming through it
+template <typename Channel>
+void StreamingScenario(const std::string &p_strName, std::shared_ptr<Channel> p_pChannel)
+{
+    unsigned long long ullStart = g_ullAllocations.load();
+    auto oStart = std::chrono::steady_clock::now();
+    std::thread oConsumer([p_pChannel]()
+                          {
+                              int iValue;
+                              for (int i = 0; i < MESSAGES_COUNT; ++i)
+                              {
+                                  p_pChannel->ReadValue(iValue);
+                              } });
+    for (int i = 0; i < MESSAGES_COUNT; ++i)
+    {
+        p_pChannel->SendValue(std::move(i));
+    }
+    oConsumer.join();
+    auto oDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - oStart);
+    //! thread creation itself allocates, that is noise compared to the number of messages
+    double dAllocationsPerMessage = double(g_ullAllocations.load() - ullStart) / MESSAGES_COUNT;
+    std::cerr << p_strName << ": " << dAllocationsPerMessage << " allocations/message, " << oDuration.count() << " ms\n";
+}
+
+int main()
+{
+    ReplyChannelScenario("UnBufferedChannel  (make_shared)   ", []()
+                         { return std::make_shared<UnBufferedChannel<int>>(); });
+    ReplyChannelScenario("UnBufferedChannel  (ChannelFactory)", []()
+                         { return ChannelFactory::MakeUnBufferedChannel<int>(); });
+    ReplyChannelScenario("BufferedChannel(16)(make_shared)   ", []()
+                         { return std::make_shared<BufferedChannel<int>>(16); });
+    ReplyChannelScenario("BufferedChannel(16)(ChannelFactory)", []()
+                         { return ChannelFactory::MakeBufferedChannel<int>(16); });
+
+    StreamingScenario("BufferedChannel(1024) stream (std::allocator)", std::make_shared<BufferedChannel<int>>(1024));
+    StreamingScenario("BufferedChannel(1024) stream (ChannelFactory)", ChannelFactory::MakeBufferedChannel<int>(1024));
+    return 0;
+}
\ No newline at end of file
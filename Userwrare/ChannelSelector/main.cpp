@@ -6,6 +6,8 @@
 #include <iostream>
 #include <chrono>
 #include <fstream>
+#include <memory>
+#include <vector>
 
 bool BUFFERED = true;
 
@@ -652,8 +654,59 @@ private:
     std::shared_ptr<IChannel<double>> channel3;
 };
 
+//! Move only , not default constructible message , sent with Emplace and moved (never copied) up to the handler
+struct Frame
+{
+    Frame(int p_iId, std::size_t p_sSize)
+        : m_iId(p_iId), m_pPayload(std::make_unique<std::vector<char>>(p_sSize, 'x'))
+    {
+    }
+
+    int m_iId;
+    std::unique_ptr<std::vector<char>> m_pPayload;
+};
+
+class MoveOnlyValuesScenario
+{
+public:
+    void Run()
+    {
+        constexpr int FRAMES_COUNT = 1000;
+        auto pUnBuffered = std::make_shared<UnBufferedChannel<Frame>>();
+        auto pBuffered = std::make_shared<BufferedChannel<Frame>>(16);
+        int iFramesHandled = 0;
+        std::size_t sBytesHandled = 0;
+        auto fOnFrame = [&iFramesHandled, &sBytesHandled](Frame &p_oFrame)
+        {
+            iFramesHandled++;
+            sBytesHandled += p_oFrame.m_pPayload->size();
+        };
+        selector.AddChannel<Frame>(pUnBuffered, fOnFrame);
+        selector.AddChannel<Frame>(pBuffered, fOnFrame);
+
+        std::thread producer([pUnBuffered, pBuffered]()
+                             {
+            for (int i = 0; i < FRAMES_COUNT; ++i)
+            {
+                pUnBuffered->Emplace(i, 4096);
+                pBuffered->Emplace(i, 4096);
+            } });
+        while (iFramesHandled < 2 * FRAMES_COUNT && selector.SelectAndExecute())
+        {
+        }
+        producer.join();
+        selector.Close();
+        std::cerr << "Move only frames handled: " << iFramesHandled << " , bytes: " << sBytesHandled << std::endl;
+    }
+
+private:
+    ChannelSelector selector;
+};
+
 int main()
 {
+    MoveOnlyValuesScenario moveOnlyTest;
+    moveOnlyTest.Run();
     ConsumersAccessingChannelsDirectlyAndConsumersWithDiffSelectsScenario test;
     test.Run();
     std::cerr << "Process exit..\n";
@@ -0,0 +1,77 @@
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "ChannelSelector.h"
+#include "ConflatingChannel.h"
+#include "KeyedConflatingChannel.h"
+
+//! A fast feed and a slow reader : the reader skips stale updates , always ends on the latest values , the feed never blocks
+constexpr int TICKS_COUNT = 200000;
+constexpr int SYMBOLS_COUNT = 8;
+
+struct Quote
+{
+    int m_iSequence;
+    double m_dPrice;
+};
+
+int main()
+{
+    auto pIndex = std::make_shared<ConflatingChannel<Quote>>();
+    auto pQuotes = std::make_shared<KeyedConflatingChannel<std::string, Quote>>();
+
+    int iLastIndexSequence = -1;
+    int arrLastQuoteSequence[SYMBOLS_COUNT];
+    std::fill(std::begin(arrLastQuoteSequence), std::end(arrLastQuoteSequence), -1);
+    int iUpdatesHandled = 0;
+    bool bIsOk = true;
+
+    ChannelSelector oSelector;
+    oSelector.AddChannel<Quote>(pIndex, [&](Quote &p_oQuote)
+                                {
+        //! Never goes back in time
+        bIsOk = bIsOk && p_oQuote.m_iSequence > iLastIndexSequence;
+        iLastIndexSequence = p_oQuote.m_iSequence;
+        iUpdatesHandled++;
+        std::this_thread::sleep_for(std::chrono::microseconds(50)); });
+    oSelector.AddChannel<std::pair<std::string, Quote>>(pQuotes, [&](std::pair<std::string, Quote> &p_oEntry)
+                                                        {
+        int iSymbol = std::stoi(p_oEntry.first.substr(3));
+        bIsOk = bIsOk && p_oEntry.second.m_iSequence > arrLastQuoteSequence[iSymbol];
+        arrLastQuoteSequence[iSymbol] = p_oEntry.second.m_iSequence;
+        iUpdatesHandled++;
+        std::this_thread::sleep_for(std::chrono::microseconds(50)); });
+
+    //! Slow reader , runs till it saw the last update of every channel / key
+    auto fIsCaughtUp = [&]()
+    {
+        bool bIsCaughtUp = iLastIndexSequence == TICKS_COUNT - 1;
+        for (int iSymbol = 0; iSymbol < SYMBOLS_COUNT; ++iSymbol)
+        {
+            bIsCaughtUp = bIsCaughtUp && arrLastQuoteSequence[iSymbol] == TICKS_COUNT - SYMBOLS_COUNT + iSymbol;
+        }
+        return bIsCaughtUp;
+    };
+    std::thread oReader([&]()
+                        {
+        while (bIsOk && !fIsCaughtUp() && oSelector.SelectAndExecute())
+        {
+        } });
+
+    auto oStart = std::chrono::steady_clock::now();
+    for (int i = 0; i < TICKS_COUNT; ++i)
+    {
+        pIndex->Emplace(Quote{i, 100.0 + i * 0.01});
+        pQuotes->Emplace("SYM" + std::to_string(i % SYMBOLS_COUNT), Quote{i, 10.0 + i * 0.01});
+    }
+    auto oFeedDuration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - oStart);
+    oReader.join();
+    oSelector.Close();
+
+    std::cout << "Feed sent " << 2 * TICKS_COUNT << " updates in " << oFeedDuration.count() << " ms , reader handled " << iUpdatesHandled << std::endl;
+    std::cout << (bIsOk ? "OK" : "FAILED") << std::endl;
+    return bIsOk ? 0 : 1;
+}
\ No newline at end of file
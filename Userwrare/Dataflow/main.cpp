@@ -0,0 +1,163 @@
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BufferedChannel.h"
+#include "Dataflow.h"
+
+//! Chains of stages running on pool workers , no thread per transformation
+constexpr int VALUES_COUNT = 100000;
+
+template <typename T>
+std::shared_ptr<IChannel<T>> MakeChannel(std::size_t p_sCapacity = 64)
+{
+    return std::make_shared<BufferedChannel<T>>(p_sCapacity);
+}
+
+//! source -> Map (4 in parallel , order kept) -> Filter -> Batch -> sink
+bool MapFilterBatchScenario(BasicThreadPool &p_oPool)
+{
+    auto pSource = MakeChannel<int>();
+    auto pSquares = MakeChannel<long long>();
+    auto pEvens = MakeChannel<long long>();
+    auto pBatches = MakeChannel<std::vector<long long>>(8);
+
+    MapOptions oOptions;
+    oOptions.m_sParallelism = 4;
+    Map<int, long long>(p_oPool, pSource, pSquares, [](int p_iValue)
+                        { return static_cast<long long>(p_iValue) * p_iValue; },
+                        oOptions);
+    Filter<long long>(p_oPool, pSquares, pEvens, [](long long p_llValue)
+                      { return p_llValue % 2 == 0; });
+    auto pBatch = Batch<long long>(p_oPool, pEvens, pBatches, 100, std::chrono::milliseconds(5));
+
+    std::thread oProducer([pSource]()
+                          {
+        for (int i = 0; i < VALUES_COUNT; ++i)
+        {
+            pSource->SendValue(std::move(i));
+        } });
+
+    //! Squares of the even values , in order , in batches of 100 (the last one on the timeout)
+    bool bIsOk = true;
+    long long llNext = 0;
+    std::vector<long long> vecBatch;
+    while (llNext < VALUES_COUNT && pBatches->ReadValue(vecBatch))
+    {
+        bIsOk = bIsOk && vecBatch.size() <= 100;
+        for (long long llSquare : vecBatch)
+        {
+            bIsOk = bIsOk && llSquare == llNext * llNext;
+            llNext += 2;
+        }
+    }
+    oProducer.join();
+
+    //! Everything went through , closing the source closes the whole chain
+    pSource->Close();
+    pBatch->WaitUntilFinished();
+    bIsOk = bIsOk && llNext == VALUES_COUNT && !pBatches->ReadValue(vecBatch);
+    std::cout << "MapFilterBatchScenario " << (bIsOk ? "OK" : "FAILED") << std::endl;
+    return bIsOk;
+}
+
+//! source -> Partition by key -> one Map per partition -> Merge -> sink , per key order is kept
+bool PartitionMergeScenario(BasicThreadPool &p_oPool)
+{
+    constexpr int KEYS_COUNT = 16;
+    constexpr int PARTITIONS_COUNT = 3;
+    using Event = std::pair<int, int>;
+
+    auto pSource = MakeChannel<Event>();
+    std::vector<std::shared_ptr<IChannel<Event>>> vecPartitions;
+    std::vector<std::shared_ptr<IChannel<Event>>> vecMapped;
+    for (int i = 0; i < PARTITIONS_COUNT; ++i)
+    {
+        vecPartitions.push_back(MakeChannel<Event>());
+        vecMapped.push_back(MakeChannel<Event>());
+        Map<Event, Event>(p_oPool, vecPartitions.back(), vecMapped.back(), [](Event p_oEvent)
+                          { return Event{p_oEvent.first, p_oEvent.second + 1}; });
+    }
+    auto pMerged = MakeChannel<Event>();
+    Partition<Event>(p_oPool, pSource, vecPartitions, [](const Event &p_oEvent)
+                     { return p_oEvent.first; });
+    auto pMerge = Merge<Event>(p_oPool, vecMapped, pMerged);
+
+    std::thread oProducer([pSource]()
+                          {
+        for (int i = 0; i < VALUES_COUNT; ++i)
+        {
+            pSource->SendValue(Event{i % KEYS_COUNT, i});
+        } });
+
+    bool bIsOk = true;
+    std::vector<int> vecLast(KEYS_COUNT, 0);
+    Event oEvent;
+    for (int i = 0; i < VALUES_COUNT && pMerged->ReadValue(oEvent); ++i)
+    {
+        bIsOk = bIsOk && oEvent.second > vecLast[oEvent.first];
+        vecLast[oEvent.first] = oEvent.second;
+    }
+    oProducer.join();
+
+    pSource->Close();
+    pMerge->WaitUntilFinished();
+    for (int iKey = 0; iKey < KEYS_COUNT; ++iKey)
+    {
+        bIsOk = bIsOk && vecLast[iKey] == VALUES_COUNT - KEYS_COUNT + iKey + 1;
+    }
+    std::cout << "PartitionMergeScenario " << (bIsOk ? "OK" : "FAILED") << std::endl;
+    return bIsOk;
+}
+
+//! Bursts every 30 ms , 10 ms tumbling windows : each burst comes out as one window
+bool WindowScenario(BasicThreadPool &p_oPool)
+{
+    constexpr int BURSTS_COUNT = 5;
+    constexpr int BURST_SIZE = 50;
+    auto pSource = MakeChannel<int>();
+    auto pWindows = MakeChannel<std::vector<int>>();
+    auto pWindow = Window<int>(p_oPool, pSource, pWindows, std::chrono::milliseconds(10));
+
+    std::thread oProducer([pSource]()
+                          {
+        for (int iBurst = 0; iBurst < BURSTS_COUNT; ++iBurst)
+        {
+            for (int i = 0; i < BURST_SIZE; ++i)
+            {
+                pSource->SendValue(iBurst * BURST_SIZE + i);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        } });
+
+    int iReceived = 0;
+    int iWindows = 0;
+    std::vector<int> vecWindow;
+    while (iReceived < BURSTS_COUNT * BURST_SIZE && pWindows->ReadValue(vecWindow))
+    {
+        iReceived += static_cast<int>(vecWindow.size());
+        iWindows++;
+    }
+    oProducer.join();
+    pSource->Close();
+    pWindow->WaitUntilFinished();
+
+    //! A burst may straddle a window boundary
+    bool bIsOk = iReceived == BURSTS_COUNT * BURST_SIZE && iWindows >= BURSTS_COUNT && iWindows <= 2 * BURSTS_COUNT;
+    std::cout << "WindowScenario " << iWindows << " windows " << (bIsOk ? "OK" : "FAILED") << std::endl;
+    return bIsOk;
+}
+
+int main()
+{
+    //! A worker per stage at least (PartitionMergeScenario has 5 stages) , see Dataflow.h
+    BasicThreadPool oPool(6);
+    bool bIsOk = MapFilterBatchScenario(oPool);
+    bIsOk = PartitionMergeScenario(oPool) && bIsOk;
+    bIsOk = WindowScenario(oPool) && bIsOk;
+    std::cout << (bIsOk ? "OK" : "FAILED") << std::endl;
+    return bIsOk ? 0 : 1;
+}
\ No newline at end of file
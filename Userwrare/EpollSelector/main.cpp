@@ -0,0 +1,95 @@
+#include <atomic>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "ChannelSelector.h"
+#include "BufferedChannel.h"
+#include "UnBufferedChannel.h"
+
+//! One epoll loop multiplexing a socket and two channels, no bridging thread
+constexpr int MESSAGES_COUNT = 100000;
+constexpr int SOCKET_MESSAGES_COUNT = 1000;
+
+int main()
+{
+    auto pOrders = std::make_shared<BufferedChannel<int>>(1024);
+    auto pCommands = std::make_shared<UnBufferedChannel<std::string>>();
+    int iOrdersRead = 0;
+    int iCommandsRead = 0;
+    ChannelSelector oSelector;
+    oSelector.AddChannel<int>(pOrders, [&iOrdersRead](int &)
+                              { iOrdersRead++; });
+    oSelector.AddChannel<std::string>(pCommands, [&iCommandsRead](std::string &)
+                                      { iCommandsRead++; });
+
+    int arrSockets[2];
+    socketpair(AF_UNIX, SOCK_STREAM, 0, arrSockets);
+
+    int iEpollFd = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event oEvent{};
+    oEvent.events = EPOLLIN;
+    oEvent.data.fd = oSelector.GetReadinessFd();
+    epoll_ctl(iEpollFd, EPOLL_CTL_ADD, oEvent.data.fd, &oEvent);
+    oEvent.data.fd = arrSockets[0];
+    epoll_ctl(iEpollFd, EPOLL_CTL_ADD, oEvent.data.fd, &oEvent);
+
+    std::thread oOrdersProducer([pOrders]()
+                                {
+        for (int i = 0; i < MESSAGES_COUNT; ++i)
+        {
+            pOrders->SendValue(std::move(i));
+        } });
+    std::thread oCommandsProducer([pCommands]()
+                                  {
+        for (int i = 0; i < 100; ++i)
+        {
+            pCommands->SendValue("command " + std::to_string(i));
+        } });
+    std::thread oSocketWriter([iSocket = arrSockets[1]]()
+                              {
+        char cByte = 'x';
+        for (int i = 0; i < SOCKET_MESSAGES_COUNT; ++i)
+        {
+            [[maybe_unused]] ssize_t sWritten = write(iSocket, &cByte, 1);
+        } });
+
+    int iSocketBytesRead = 0;
+    unsigned long long ullWakeups = 0;
+    while (iOrdersRead < MESSAGES_COUNT || iCommandsRead < 100 || iSocketBytesRead < SOCKET_MESSAGES_COUNT)
+    {
+        epoll_event arrEvents[2];
+        int iEventsCount = epoll_wait(iEpollFd, arrEvents, 2, -1);
+        ullWakeups++;
+        for (int i = 0; i < iEventsCount; ++i)
+        {
+            if (arrEvents[i].data.fd == arrSockets[0])
+            {
+                char arrBuffer[256];
+                ssize_t sRead = read(arrSockets[0], arrBuffer, sizeof(arrBuffer));
+                iSocketBytesRead += sRead > 0 ? sRead : 0;
+            }
+            else
+            {
+                //! Bounded, so a flood of channel messages doesn't starve the socket
+                oSelector.Drain(256);
+            }
+        }
+    }
+
+    oOrdersProducer.join();
+    oCommandsProducer.join();
+    oSocketWriter.join();
+    std::cerr << "orders: " << iOrdersRead << ", commands: " << iCommandsRead << ", socket bytes: " << iSocketBytesRead
+              << ", epoll wakeups: " << ullWakeups << "\n";
+
+    oSelector.Close();
+    close(iEpollFd);
+    close(arrSockets[0]);
+    close(arrSockets[1]);
+    return 0;
+}
\ No newline at end of file
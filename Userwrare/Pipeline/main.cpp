@@ -0,0 +1,56 @@
+#include <iostream>
+#include <string>
+
+#include "Pipeline.h"
+
+struct Order
+{
+    int m_iId{0};
+    double m_dPrice{0};
+    std::string m_strDescription;
+    bool m_bIsValid{false};
+};
+
+int main()
+{
+    constexpr int ORDERS_COUNT = 100000;
+    //! One worker per stage, stages are long running tasks
+    BasicThreadPool oPool(3);
+
+    double dTotal = 0;
+    int iValidCount = 0;
+    Pipeline<Order> oPipeline(1024);
+    oPipeline
+        .AddStage([](Order &p_oOrder)
+                  { p_oOrder.m_bIsValid = p_oOrder.m_iId % 10 != 0; })
+        .AddStage([](Order &p_oOrder)
+                  { p_oOrder.m_dPrice *= 1.14; })
+        .AddStage([&dTotal, &iValidCount](Order &p_oOrder)
+                  {
+                      if (p_oOrder.m_bIsValid)
+                      {
+                          dTotal += p_oOrder.m_dPrice;
+                          iValidCount++;
+                      } });
+    oPipeline.Start(oPool);
+
+    for (int i = 0; i < ORDERS_COUNT; ++i)
+    {
+        //! Fill the ring slot directly , its string buffer is reused
+        oPipeline.PublishInPlace([i](Order &p_oSlot)
+                                 {
+                                     p_oSlot.m_iId = i;
+                                     p_oSlot.m_dPrice = 10;
+                                     p_oSlot.m_strDescription.assign("Order from the pipeline userware"); });
+    }
+    oPipeline.Close();
+
+    std::cerr << "Valid orders: " << iValidCount << " , total: " << dTotal << '\n';
+    int iStage = 0;
+    for (auto &oStats : oPipeline.GetStagesStats())
+    {
+        std::cerr << "Stage " << iStage++ << ": processed " << oStats.m_ullProcessed << " in " << oStats.m_ullBatches
+                  << " batches, largest batch " << oStats.m_ullLargestBatch << '\n';
+    }
+    return 0;
+}
\ No newline at end of file
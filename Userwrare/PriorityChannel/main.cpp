@@ -0,0 +1,119 @@
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "ChannelSelector.h"
+#include "PriorityChannel.h"
+
+//! Control messages overtake bulk data sent to the same inbox , same priority messages keep their order
+constexpr int PRODUCERS_COUNT = 4;
+constexpr int MESSAGES_PER_PRODUCER = 50000;
+constexpr std::size_t CHANNEL_CAPACITY = 64;
+
+enum class Priority
+{
+    Bulk = 0,
+    Normal = 1,
+    Control = 2
+};
+
+struct Message
+{
+    Priority m_ePriority;
+    int m_iProducer;
+    int m_iSequence;
+};
+
+struct ByPriority
+{
+    bool operator()(const Message &p_oLeft, const Message &p_oRight) const
+    {
+        return p_oLeft.m_ePriority < p_oRight.m_ePriority;
+    }
+};
+
+using Inbox = PriorityChannel<Message, ByPriority>;
+
+//! Single thread : fill the inbox then drain it , control first , then normal , then bulk , each band in send order
+bool OrderingScenario()
+{
+    Inbox oInbox(CHANNEL_CAPACITY);
+    for (int i = 0; i < static_cast<int>(CHANNEL_CAPACITY); ++i)
+    {
+        oInbox.Emplace(Message{static_cast<Priority>(i % 3), 0, i});
+    }
+
+    bool bIsOk = true;
+    Message oPrevious{Priority::Control, 0, -1};
+    Message oMessage;
+    while (oInbox.TryReadValue(oMessage))
+    {
+        if (oMessage.m_ePriority == oPrevious.m_ePriority)
+        {
+            bIsOk = bIsOk && oMessage.m_iSequence > oPrevious.m_iSequence;
+        }
+        else
+        {
+            bIsOk = bIsOk && oMessage.m_ePriority < oPrevious.m_ePriority;
+        }
+        oPrevious = oMessage;
+    }
+    std::cout << "OrderingScenario " << (bIsOk ? "OK" : "FAILED") << std::endl;
+    return bIsOk;
+}
+
+//! Producers flood the inbox with bulk data and now and then a control message , a slow consumer reads through a selector
+//! every message is delivered once , per producer and priority the order is kept
+bool ContendedScenario()
+{
+    auto pInbox = std::make_shared<Inbox>(CHANNEL_CAPACITY);
+
+    std::vector<int> vecLastSequence(PRODUCERS_COUNT * 3, -1);
+    int iReceived = 0;
+    bool bIsOk = true;
+
+    ChannelSelector oSelector;
+    oSelector.AddChannel<Message>(pInbox, [&](Message &p_oMessage)
+                                  {
+        int &iLast = vecLastSequence[p_oMessage.m_iProducer * 3 + static_cast<int>(p_oMessage.m_ePriority)];
+        bIsOk = bIsOk && p_oMessage.m_iSequence > iLast;
+        iLast = p_oMessage.m_iSequence;
+        iReceived++; });
+
+    std::thread oConsumer([&]()
+                          {
+        while (iReceived < PRODUCERS_COUNT * MESSAGES_PER_PRODUCER && oSelector.SelectAndExecute())
+        {
+        } });
+
+    std::vector<std::thread> vecProducers;
+    for (int iProducer = 0; iProducer < PRODUCERS_COUNT; ++iProducer)
+    {
+        vecProducers.emplace_back([pInbox, iProducer]()
+                                  {
+            for (int i = 0; i < MESSAGES_PER_PRODUCER; ++i)
+            {
+                Priority ePriority = i % 100 == 0 ? Priority::Control : (i % 10 == 0 ? Priority::Normal : Priority::Bulk);
+                pInbox->Emplace(Message{ePriority, iProducer, i});
+            } });
+    }
+    for (auto &oProducer : vecProducers)
+    {
+        oProducer.join();
+    }
+    oConsumer.join();
+    oSelector.Close();
+
+    bIsOk = bIsOk && iReceived == PRODUCERS_COUNT * MESSAGES_PER_PRODUCER;
+    std::cout << "ContendedScenario received " << iReceived << " " << (bIsOk ? "OK" : "FAILED") << std::endl;
+    return bIsOk;
+}
+
+int main()
+{
+    bool bIsOk = OrderingScenario();
+    bIsOk = ContendedScenario() && bIsOk;
+    std::cout << (bIsOk ? "OK" : "FAILED") << std::endl;
+    return bIsOk ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "SharedMemoryChannel.h"
+
+//! Two processes talking over /dev/shm : a stream of messages then a ping pong to measure the handoff latency
+constexpr int MESSAGES_COUNT = 1000000;
+constexpr int ROUND_TRIPS_COUNT = 100000;
+
+struct Message
+{
+    unsigned long long m_ullSequence;
+    unsigned long long m_ullChecksum;
+};
+
+//! Close drops what is still buffered (BufferedChannel semantics) , the stream ends with a marker instead
+constexpr unsigned long long END_OF_STREAM = ~0ULL;
+
+int RunChild()
+{
+    SharedMemoryChannel<Message> oStream("ConcurrencyLibStream");
+    SharedMemoryChannel<unsigned long long> oPing("ConcurrencyLibPing");
+    SharedMemoryChannel<unsigned long long> oPong("ConcurrencyLibPong");
+
+    Message oMessage;
+    unsigned long long ullExpected = 0;
+    while (oStream.ReadValue(oMessage) && oMessage.m_ullSequence != END_OF_STREAM)
+    {
+        if (oMessage.m_ullSequence != ullExpected || oMessage.m_ullChecksum != ~ullExpected)
+        {
+            std::cerr << "child : out of order / corrupted message " << oMessage.m_ullSequence << std::endl;
+            return 1;
+        }
+        ullExpected++;
+    }
+    if (ullExpected != MESSAGES_COUNT)
+    {
+        std::cerr << "child : read " << ullExpected << " messages" << std::endl;
+        return 1;
+    }
+
+    unsigned long long ullValue;
+    while (oPing.ReadValue(ullValue))
+    {
+        oPong.SendValue(ullValue);
+    }
+    return 0;
+}
+
+int main()
+{
+    //! Created before fork so the child can open them by name right away
+    SharedMemoryChannel<Message> oStream("ConcurrencyLibStream", 1024);
+    SharedMemoryChannel<unsigned long long> oPing("ConcurrencyLibPing", 1);
+    SharedMemoryChannel<unsigned long long> oPong("ConcurrencyLibPong", 1);
+
+    pid_t iChild = fork();
+    if (iChild == 0)
+    {
+        //! The parent owns the segments , the child leaves without running destructors
+        _exit(RunChild());
+    }
+
+    auto oStart = std::chrono::steady_clock::now();
+    for (unsigned long long ullSequence = 0; ullSequence < MESSAGES_COUNT; ++ullSequence)
+    {
+        oStream.SendValue(Message{ullSequence, ~ullSequence});
+    }
+    oStream.SendValue(Message{END_OF_STREAM, 0});
+    auto oStreamDuration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - oStart);
+    std::cout << "Streamed " << MESSAGES_COUNT << " messages in " << oStreamDuration.count() << " us" << std::endl;
+
+    std::vector<long long> vecRoundTrips;
+    vecRoundTrips.reserve(ROUND_TRIPS_COUNT);
+    for (unsigned long long ullPing = 0; ullPing < ROUND_TRIPS_COUNT; ++ullPing)
+    {
+        unsigned long long ullPong = 0;
+        auto oPingStart = std::chrono::steady_clock::now();
+        oPing.SendValue(ullPing);
+        if (!oPong.ReadValue(ullPong) || ullPong != ullPing)
+        {
+            std::cerr << "parent : wrong pong " << ullPong << std::endl;
+            return 1;
+        }
+        vecRoundTrips.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - oPingStart).count());
+    }
+    //! Nothing buffered anymore , Close is enough to stop the child
+    oPing.Close();
+
+    std::sort(vecRoundTrips.begin(), vecRoundTrips.end());
+    std::cout << "Round trip p50 " << vecRoundTrips[vecRoundTrips.size() / 2] << " ns , p99 "
+              << vecRoundTrips[vecRoundTrips.size() * 99 / 100] << " ns" << std::endl;
+
+    int iStatus = 0;
+    waitpid(iChild, &iStatus, 0);
+    bool bIsChildOk = WIFEXITED(iStatus) && WEXITSTATUS(iStatus) == 0;
+    std::cout << (bIsChildOk ? "OK" : "FAILED") << std::endl;
+    return bIsChildOk ? 0 : 1;
+}
\ No newline at end of file
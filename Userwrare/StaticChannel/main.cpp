@@ -0,0 +1,84 @@
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "ChannelAdapter.h"
+#include "ChannelSelector.h"
+
+//! Channel<...> used directly between two known threads , then behind ChannelAdapter in a ChannelSelector
+constexpr int MESSAGES_COUNT = 100000;
+
+//! Single producer / single consumer , no virtual call , no lock , no allocation
+bool SpscScenario()
+{
+    SpscChannel<int, 256> oChannel;
+    std::thread oProducer([&oChannel]()
+                          {
+        for (int i = 0; i < MESSAGES_COUNT; ++i)
+        {
+            oChannel.SendValue(i);
+        } });
+
+    bool bIsOk = true;
+    int iValue = 0;
+    for (int i = 0; i < MESSAGES_COUNT; ++i)
+    {
+        bIsOk = bIsOk && oChannel.ReadValue(iValue) && iValue == i;
+    }
+    oProducer.join();
+    oChannel.Close();
+    bIsOk = bIsOk && !oChannel.SendValue(0);
+    std::cout << "SpscScenario " << (bIsOk ? "OK" : "FAILED") << std::endl;
+    return bIsOk;
+}
+
+//! Move only values , two multi producer channels read through one selector
+bool SelectorScenario()
+{
+    using Inbox = ChannelAdapter<Channel<std::unique_ptr<std::string>, 64>>;
+    auto pFirst = std::make_shared<Inbox>();
+    auto pSecond = std::make_shared<Inbox>();
+
+    int iReceived = 0;
+    bool bIsOk = true;
+    ChannelSelector oSelector;
+    auto fHandler = [&](std::unique_ptr<std::string> &p_pMessage)
+    {
+        bIsOk = bIsOk && p_pMessage && p_pMessage->size() == 5;
+        iReceived++;
+    };
+    oSelector.AddChannel<std::unique_ptr<std::string>>(pFirst, fHandler);
+    oSelector.AddChannel<std::unique_ptr<std::string>>(pSecond, fHandler);
+
+    std::thread oConsumer([&]()
+                          {
+        while (iReceived < 2 * MESSAGES_COUNT && oSelector.SelectAndExecute())
+        {
+        } });
+    std::thread oFirstProducer([pFirst]()
+                               {
+        for (int i = 0; i < MESSAGES_COUNT; ++i)
+        {
+            pFirst->Emplace(std::make_unique<std::string>("first"));
+        } });
+    for (int i = 0; i < MESSAGES_COUNT; ++i)
+    {
+        pSecond->Emplace(std::make_unique<std::string>("other"));
+    }
+    oFirstProducer.join();
+    oConsumer.join();
+    oSelector.Close();
+
+    bIsOk = bIsOk && iReceived == 2 * MESSAGES_COUNT;
+    std::cout << "SelectorScenario received " << iReceived << " " << (bIsOk ? "OK" : "FAILED") << std::endl;
+    return bIsOk;
+}
+
+int main()
+{
+    bool bIsOk = SpscScenario();
+    bIsOk = SelectorScenario() && bIsOk;
+    std::cout << (bIsOk ? "OK" : "FAILED") << std::endl;
+    return bIsOk ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+
+//! System includes
+#include <iostream>
+#include <string>
+#include <vector>
+
+struct StressMessage
+{
+    unsigned int m_uiProducer{0};
+    unsigned long long m_ullSequence{0};
+};
+
+//! Messages read by each consumer , in the order it read them
+//! every consumer only appends to its own history , so recording doesn't need any locking (and doesn't hide races from TSan)
+class History
+{
+public:
+    History(unsigned int p_uiProducersCount, unsigned long long p_ullMessagesPerProducer, unsigned int p_uiConsumersCount)
+        : m_uiProducersCount(p_uiProducersCount),
+          m_ullMessagesPerProducer(p_ullMessagesPerProducer),
+          m_vecConsumersHistory(p_uiConsumersCount)
+    {
+    }
+
+    void Record(unsigned int p_uiConsumer, const StressMessage &p_oMessage)
+    {
+        m_vecConsumersHistory[p_uiConsumer].push_back(p_oMessage);
+    }
+
+    //! FIFO : no consumer sees a producer's messages out of order (this also catches a consumer reading a message twice)
+    //! No loss / no duplication : every message was read exactly once overall,
+    //! or exactly once by every consumer for broadcast (p_bEveryConsumerReadsAll)
+    bool Verify(const std::string &p_strName, bool p_bEveryConsumerReadsAll) const
+    {
+        std::vector<unsigned int> vecReadsCount(m_uiProducersCount * m_ullMessagesPerProducer, 0);
+        for (std::size_t sConsumer = 0; sConsumer < m_vecConsumersHistory.size(); ++sConsumer)
+        {
+            std::vector<long long> vecLastSequence(m_uiProducersCount, -1);
+            for (const StressMessage &oMessage : m_vecConsumersHistory[sConsumer])
+            {
+                if (oMessage.m_uiProducer >= m_uiProducersCount || oMessage.m_ullSequence >= m_ullMessagesPerProducer)
+                {
+                    return Fail(p_strName, "consumer " + std::to_string(sConsumer) + " read a message that was never sent");
+                }
+                if (static_cast<long long>(oMessage.m_ullSequence) <= vecLastSequence[oMessage.m_uiProducer])
+                {
+                    return Fail(p_strName, "consumer " + std::to_string(sConsumer) + " read producer " + std::to_string(oMessage.m_uiProducer) +
+                                               " message " + std::to_string(oMessage.m_ullSequence) + " after message " +
+                                               std::to_string(vecLastSequence[oMessage.m_uiProducer]));
+                }
+                vecLastSequence[oMessage.m_uiProducer] = oMessage.m_ullSequence;
+                vecReadsCount[oMessage.m_uiProducer * m_ullMessagesPerProducer + oMessage.m_ullSequence]++;
+            }
+        }
+
+        unsigned int uiExpectedReads = p_bEveryConsumerReadsAll ? m_vecConsumersHistory.size() : 1;
+        for (std::size_t sMessage = 0; sMessage < vecReadsCount.size(); ++sMessage)
+        {
+            if (vecReadsCount[sMessage] != uiExpectedReads)
+            {
+                return Fail(p_strName, "producer " + std::to_string(sMessage / m_ullMessagesPerProducer) + " message " +
+                                           std::to_string(sMessage % m_ullMessagesPerProducer) + " was read " +
+                                           std::to_string(vecReadsCount[sMessage]) + " times, expected " + std::to_string(uiExpectedReads));
+            }
+        }
+        std::cerr << "[ OK ] " << p_strName << "\n";
+        return true;
+    }
+
+private:
+    static bool Fail(const std::string &p_strName, const std::string &p_strReason)
+    {
+        std::cerr << "[FAIL] " << p_strName << ": " << p_strReason << "\n";
+        return false;
+    }
+
+    unsigned int m_uiProducersCount;
+    unsigned long long m_ullMessagesPerProducer;
+    std::vector<std::vector<StressMessage>> m_vecConsumersHistory;
+};
\ No newline at end of file
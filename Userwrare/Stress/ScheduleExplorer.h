@@ -0,0 +1,213 @@
+#pragma once
+
+//! System includes
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+//! Channels
+#include "IChannel.h"
+
+#include "History.h"
+
+/*
+    Relacy lite : deterministic exploration of operations interleavings , checked against a sequential FIFO model
+    - logical threads are programs of channel operations , all executed on the calling thread one whole operation at a time
+      so this explores linearization orders , not memory orderings (the TSan stress run covers those)
+    - a Send on a (model) full channel is a blocked thread , it is not schedulable till a read frees a slot
+    - after every operation the channel's observable result has to match the model
+*/
+
+//! Questions / Edgecases:
+//! Q: Why TryRead and no blocking Read ?
+//!     everything runs on one thread, a blocking Read is the same as a TryRead that is only scheduled when the model isn't empty
+//! Q: What does the model do on Close ?
+//!     same as the channels : every later Send / TryRead fails , values still buffered are dropped
+
+enum class ExplorationOperation
+{
+    Send,
+    TryRead,
+    Close
+};
+
+class ScheduleExplorer
+{
+public:
+    using Program = std::vector<ExplorationOperation>;
+    using ChannelFactory = std::function<std::shared_ptr<IChannel<StressMessage>>()>;
+
+    ScheduleExplorer(std::string p_strName, ChannelFactory p_fMakeChannel, std::size_t p_sCapacity, std::vector<Program> p_vecPrograms)
+        : m_strName(std::move(p_strName)),
+          m_fMakeChannel(std::move(p_fMakeChannel)),
+          m_sCapacity(p_sCapacity),
+          m_vecPrograms(std::move(p_vecPrograms))
+    {
+    }
+
+    //! Every interleaving, depth first
+    //! stateless : each schedule replays from a fresh channel , the choices prefix is all that is kept between runs
+    bool ExploreAll()
+    {
+        std::vector<std::size_t> vecChoices;
+        std::vector<std::size_t> vecAlternatives;
+        unsigned long long ullSchedulesCount = 0;
+        while (true)
+        {
+            vecAlternatives.clear();
+            ullSchedulesCount++;
+            if (!RunSchedule(vecChoices, vecAlternatives, [](std::size_t)
+                             { return 0; }))
+            {
+                return false;
+            }
+            //! Backtrack to the deepest step that still has an unexplored alternative
+            while (!vecChoices.empty() && vecChoices.back() + 1 >= vecAlternatives[vecChoices.size() - 1])
+            {
+                vecChoices.pop_back();
+            }
+            if (vecChoices.empty())
+            {
+                break;
+            }
+            vecChoices.back()++;
+        }
+        std::cerr << "[ OK ] " << m_strName << ": " << ullSchedulesCount << " schedules (exhaustive)\n";
+        return true;
+    }
+
+    //! p_ullSchedulesCount random schedules , reproducible from p_uiSeed
+    bool ExploreRandom(unsigned int p_uiSeed, unsigned long long p_ullSchedulesCount)
+    {
+        std::mt19937 oRng(p_uiSeed);
+        std::vector<std::size_t> vecChoices;
+        std::vector<std::size_t> vecAlternatives;
+        for (unsigned long long ullSchedule = 0; ullSchedule < p_ullSchedulesCount; ++ullSchedule)
+        {
+            vecChoices.clear();
+            vecAlternatives.clear();
+            if (!RunSchedule(vecChoices, vecAlternatives, [&oRng](std::size_t p_sRunnableCount)
+                             { return oRng() % p_sRunnableCount; }))
+            {
+                std::cerr << "       seed " << p_uiSeed << ", schedule " << ullSchedule << "\n";
+                return false;
+            }
+        }
+        std::cerr << "[ OK ] " << m_strName << ": " << p_ullSchedulesCount << " schedules (random, seed " << p_uiSeed << ")\n";
+        return true;
+    }
+
+private:
+    //! Runs one schedule , p_vecChoices holds the index (among the runnable threads) picked at each step
+    //! steps past the given choices are picked by p_fChoose and appended , p_vecAlternatives gets the runnable count of every step
+    template <typename Choose>
+    bool RunSchedule(std::vector<std::size_t> &p_vecChoices, std::vector<std::size_t> &p_vecAlternatives, Choose &&p_fChoose)
+    {
+        std::shared_ptr<IChannel<StressMessage>> pChannel = m_fMakeChannel();
+        std::deque<StressMessage> oModel;
+        bool bIsClosed = false;
+        std::vector<std::size_t> vecProgramCounters(m_vecPrograms.size(), 0);
+        std::vector<unsigned long long> vecSequences(m_vecPrograms.size(), 0);
+        std::vector<std::string> vecTrace;
+
+        for (std::size_t sStep = 0;; ++sStep)
+        {
+            std::vector<std::size_t> vecRunnable;
+            for (std::size_t sThread = 0; sThread < m_vecPrograms.size(); ++sThread)
+            {
+                if (vecProgramCounters[sThread] == m_vecPrograms[sThread].size())
+                {
+                    continue;
+                }
+                bool bIsBlocked = m_vecPrograms[sThread][vecProgramCounters[sThread]] == ExplorationOperation::Send &&
+                                  !bIsClosed && oModel.size() >= m_sCapacity;
+                if (!bIsBlocked)
+                {
+                    vecRunnable.push_back(sThread);
+                }
+            }
+            //! Done , or every thread left is a producer blocked on a full channel nobody reads anymore
+            if (vecRunnable.empty())
+            {
+                return true;
+            }
+
+            if (sStep == p_vecChoices.size())
+            {
+                p_vecChoices.push_back(p_fChoose(vecRunnable.size()));
+            }
+            p_vecAlternatives.push_back(vecRunnable.size());
+            std::size_t sThread = vecRunnable[p_vecChoices[sStep]];
+            std::string strStep = "T" + std::to_string(sThread) + ":";
+
+            switch (m_vecPrograms[sThread][vecProgramCounters[sThread]++])
+            {
+            case ExplorationOperation::Send:
+            {
+                StressMessage oMessage{static_cast<unsigned int>(sThread), vecSequences[sThread]++};
+                strStep += "Send(" + std::to_string(oMessage.m_ullSequence) + ")";
+                bool bResult = pChannel->SendValue(StressMessage{oMessage});
+                vecTrace.push_back(strStep);
+                if (bResult == bIsClosed)
+                {
+                    return Fail(vecTrace, "Send returned " + std::to_string(bResult));
+                }
+                if (bResult)
+                {
+                    oModel.push_back(oMessage);
+                }
+                break;
+            }
+            case ExplorationOperation::TryRead:
+            {
+                StressMessage oMessage;
+                bool bResult = pChannel->TryReadValue(oMessage);
+                bool bExpected = !bIsClosed && !oModel.empty();
+                strStep += bResult ? "TryRead(T" + std::to_string(oMessage.m_uiProducer) + "#" + std::to_string(oMessage.m_ullSequence) + ")" : "TryRead(-)";
+                vecTrace.push_back(strStep);
+                if (bResult != bExpected)
+                {
+                    return Fail(vecTrace, "TryRead returned " + std::to_string(bResult));
+                }
+                if (bResult)
+                {
+                    if (oMessage.m_uiProducer != oModel.front().m_uiProducer || oMessage.m_ullSequence != oModel.front().m_ullSequence)
+                    {
+                        return Fail(vecTrace, "expected T" + std::to_string(oModel.front().m_uiProducer) + "#" + std::to_string(oModel.front().m_ullSequence));
+                    }
+                    oModel.pop_front();
+                }
+                break;
+            }
+            case ExplorationOperation::Close:
+            {
+                pChannel->Close();
+                bIsClosed = true;
+                oModel.clear();
+                vecTrace.push_back(strStep + "Close");
+                break;
+            }
+            }
+        }
+    }
+
+    bool Fail(const std::vector<std::string> &p_vecTrace, const std::string &p_strReason) const
+    {
+        std::cerr << "[FAIL] " << m_strName << ": " << p_strReason << "\n       schedule:";
+        for (const std::string &strStep : p_vecTrace)
+        {
+            std::cerr << " " << strStep;
+        }
+        std::cerr << "\n";
+        return false;
+    }
+
+    std::string m_strName;
+    ChannelFactory m_fMakeChannel;
+    std::size_t m_sCapacity;
+    std::vector<Program> m_vecPrograms;
+};
\ No newline at end of file
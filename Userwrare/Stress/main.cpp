@@ -0,0 +1,895 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <poll.h>
+
+#include "BufferedChannel.h"
+#include "UnBufferedChannel.h"
+#include "ShardedChannel.h"
+#include "UnboundedChannel.h"
+#include "PriorityChannel.h"
+#include "ChannelAdapter.h"
+#include "CompactChannel.h"
+#include "BroadcastChannel.h"
+#include "ChannelSelector.h"
+#include "ChannelFactory.h"
+#include "BasicThreadPool.h"
+#include "Strand.h"
+#include "TaskGraph.h"
+#include "Dataflow.h"
+#include "Actor.h"
+
+#include "History.h"
+#include "ScheduleExplorer.h"
+
+/*
+    Stress / linearizability harness , meant to be run under TSan (make tsan)
+    - stress : random producers / consumers interleavings (seeded jitter) on every channel , history checked for FIFO , no loss , no duplication
+    - explore : deterministic schedules exploration against a sequential model (see ScheduleExplorer.h)
+    usage: Stress.exe [all|stress|explore] [seed]
+*/
+
+struct StressConfig
+{
+    unsigned int m_uiProducersCount;
+    unsigned int m_uiConsumersCount;
+    unsigned long long m_ullMessagesPerProducer;
+    unsigned int m_uiSeed;
+};
+
+//! Random yields / short sleeps to shake the interleavings , seeded per thread
+class Jitter
+{
+public:
+    explicit Jitter(unsigned int p_uiSeed) : m_oRng(p_uiSeed) {}
+
+    void operator()()
+    {
+        unsigned int uiDice = m_oRng() % 64;
+        if (uiDice == 0)
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds(m_oRng() % 50));
+        }
+        else if (uiDice < 8)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    bool Coin()
+    {
+        return m_oRng() & 1;
+    }
+
+private:
+    std::mt19937 m_oRng;
+};
+
+//! Aborts if a scenario doesn't finish in time , a deadlock / lost wakeup otherwise just hangs the run
+class Watchdog
+{
+public:
+    explicit Watchdog(std::chrono::seconds p_oTimeout)
+        : m_oTimeout(p_oTimeout), m_oThread(&Watchdog::Run, this)
+    {
+    }
+
+    void Arm(const std::string &p_strScenario)
+    {
+        std::lock_guard<std::mutex> oLock{m_oMutex};
+        m_strScenario = p_strScenario;
+        m_oDeadline = std::chrono::steady_clock::now() + m_oTimeout;
+        m_bIsArmed = true;
+    }
+
+    void Disarm()
+    {
+        std::lock_guard<std::mutex> oLock{m_oMutex};
+        m_bIsArmed = false;
+    }
+
+    ~Watchdog()
+    {
+        {
+            std::lock_guard<std::mutex> oLock{m_oMutex};
+            m_bIsTerminated = true;
+        }
+        m_oCv.notify_all();
+        m_oThread.join();
+    }
+
+private:
+    void Run()
+    {
+        std::unique_lock<std::mutex> oLock{m_oMutex};
+        while (!m_bIsTerminated)
+        {
+            m_oCv.wait_for(oLock, std::chrono::milliseconds(100));
+            if (m_bIsArmed && std::chrono::steady_clock::now() > m_oDeadline)
+            {
+                std::cerr << "[FAIL] " << m_strScenario << ": timed out, deadlock or lost wakeup\n";
+                std::abort();
+            }
+        }
+    }
+
+    std::chrono::seconds m_oTimeout;
+    std::mutex m_oMutex;
+    std::condition_variable m_oCv;
+    std::string m_strScenario;
+    std::chrono::steady_clock::time_point m_oDeadline;
+    bool m_bIsArmed{false};
+    bool m_bIsTerminated{false};
+    std::thread m_oThread;
+};
+
+static Watchdog g_oWatchdog{std::chrono::seconds(120)};
+
+//! Producers each send their own increasing sequence , consumers mix blocking and non blocking reads
+//! channel is only closed once everything was consumed , so the history has to hold every message exactly once
+template <typename Channel>
+bool StressQueue(const std::string &p_strName, std::shared_ptr<Channel> p_pChannel, const StressConfig &p_oConfig)
+{
+    g_oWatchdog.Arm(p_strName);
+    History oHistory(p_oConfig.m_uiProducersCount, p_oConfig.m_ullMessagesPerProducer, p_oConfig.m_uiConsumersCount);
+    const unsigned long long ullTotal = p_oConfig.m_uiProducersCount * p_oConfig.m_ullMessagesPerProducer;
+    std::atomic<unsigned long long> ullConsumed{0};
+    std::atomic<bool> bIsClosed{false};
+
+    std::vector<std::thread> vecConsumers;
+    for (unsigned int uiConsumer = 0; uiConsumer < p_oConfig.m_uiConsumersCount; ++uiConsumer)
+    {
+        vecConsumers.emplace_back([&, uiConsumer]()
+                                  {
+            Jitter oJitter(p_oConfig.m_uiSeed * 7919 + 1000 + uiConsumer);
+            StressMessage oMessage;
+            while (true)
+            {
+                bool bResult = oJitter.Coin() ? p_pChannel->ReadValue(oMessage) : p_pChannel->TryReadValue(oMessage);
+                if (!bResult)
+                {
+                    if (bIsClosed.load())
+                    {
+                        return;
+                    }
+                    std::this_thread::yield();
+                    continue;
+                }
+                oHistory.Record(uiConsumer, oMessage);
+                ullConsumed++;
+                oJitter();
+            } });
+    }
+
+    std::vector<std::thread> vecProducers;
+    for (unsigned int uiProducer = 0; uiProducer < p_oConfig.m_uiProducersCount; ++uiProducer)
+    {
+        vecProducers.emplace_back([&, uiProducer]()
+                                  {
+            Jitter oJitter(p_oConfig.m_uiSeed * 7919 + uiProducer);
+            for (unsigned long long ullSequence = 0; ullSequence < p_oConfig.m_ullMessagesPerProducer; ++ullSequence)
+            {
+                StressMessage oMessage{uiProducer, ullSequence};
+                if (oJitter.Coin())
+                {
+                    p_pChannel->SendValue(std::move(oMessage));
+                }
+                else
+                {
+                    p_pChannel->SendValue(oMessage);
+                }
+                oJitter();
+            } });
+    }
+
+    for (auto &oProducer : vecProducers)
+    {
+        oProducer.join();
+    }
+    while (ullConsumed.load() < ullTotal)
+    {
+        std::this_thread::yield();
+    }
+    bIsClosed = true;
+    p_pChannel->Close();
+    for (auto &oConsumer : vecConsumers)
+    {
+        oConsumer.join();
+    }
+    g_oWatchdog.Disarm();
+    return oHistory.Verify(p_strName, false);
+}
+
+//! Every subscriber has to see every message , in each producer's order
+bool StressBroadcast(const std::string &p_strName, LagPolicy p_eLagPolicy, const StressConfig &p_oConfig)
+{
+    g_oWatchdog.Arm(p_strName);
+    History oHistory(p_oConfig.m_uiProducersCount, p_oConfig.m_ullMessagesPerProducer, p_oConfig.m_uiConsumersCount);
+    const unsigned long long ullTotal = p_oConfig.m_uiProducersCount * p_oConfig.m_ullMessagesPerProducer;
+    BroadcastChannel<StressMessage> oChannel(8);
+
+    std::vector<std::thread> vecConsumers;
+    for (unsigned int uiConsumer = 0; uiConsumer < p_oConfig.m_uiConsumersCount; ++uiConsumer)
+    {
+        vecConsumers.emplace_back([&, uiConsumer, pSubscriber = oChannel.Subscribe(p_eLagPolicy)]()
+                                  {
+            Jitter oJitter(p_oConfig.m_uiSeed * 7919 + 1000 + uiConsumer);
+            auto fRecord = [&](const StressMessage &p_oMessage)
+            { oHistory.Record(uiConsumer, p_oMessage); };
+            for (unsigned long long ullRead = 0; ullRead < ullTotal; ++ullRead)
+            {
+                while (!(oJitter.Coin() ? pSubscriber->Read(fRecord) : pSubscriber->TryRead(fRecord)))
+                {
+                    std::this_thread::yield();
+                }
+                oJitter();
+            } });
+    }
+
+    std::vector<std::thread> vecProducers;
+    for (unsigned int uiProducer = 0; uiProducer < p_oConfig.m_uiProducersCount; ++uiProducer)
+    {
+        vecProducers.emplace_back([&, uiProducer]()
+                                  {
+            Jitter oJitter(p_oConfig.m_uiSeed * 7919 + uiProducer);
+            for (unsigned long long ullSequence = 0; ullSequence < p_oConfig.m_ullMessagesPerProducer; ++ullSequence)
+            {
+                oChannel.SendValue(StressMessage{uiProducer, ullSequence});
+                oJitter();
+            } });
+    }
+
+    for (auto &oProducer : vecProducers)
+    {
+        oProducer.join();
+    }
+    for (auto &oConsumer : vecConsumers)
+    {
+        oConsumer.join();
+    }
+    oChannel.Close();
+    g_oWatchdog.Disarm();
+    return oHistory.Verify(p_strName, true);
+}
+
+//! Several selecting threads over several channels , producer p always sends on channel p % channels count
+//! so per producer FIFO still holds for each selecting thread
+bool StressSelector(const std::string &p_strName, const StressConfig &p_oConfig)
+{
+    g_oWatchdog.Arm(p_strName);
+    History oHistory(p_oConfig.m_uiProducersCount, p_oConfig.m_ullMessagesPerProducer, p_oConfig.m_uiConsumersCount);
+    const unsigned long long ullTotal = p_oConfig.m_uiProducersCount * p_oConfig.m_ullMessagesPerProducer;
+    std::atomic<unsigned long long> ullConsumed{0};
+    static thread_local unsigned int t_uiConsumer = 0;
+
+    std::vector<std::shared_ptr<IChannel<StressMessage>>> vecChannels{
+        std::make_shared<BufferedChannel<StressMessage>>(4),
+        std::make_shared<UnBufferedChannel<StressMessage>>(),
+        std::make_shared<BufferedChannel<StressMessage>>(1)};
+    ChannelSelector oSelector;
+    for (auto &pChannel : vecChannels)
+    {
+        oSelector.AddChannel<StressMessage>(pChannel, [&](StressMessage &p_oMessage)
+                                            {
+            oHistory.Record(t_uiConsumer, p_oMessage);
+            ullConsumed++; });
+    }
+
+    std::vector<std::thread> vecConsumers;
+    for (unsigned int uiConsumer = 0; uiConsumer < p_oConfig.m_uiConsumersCount; ++uiConsumer)
+    {
+        vecConsumers.emplace_back([&, uiConsumer]()
+                                  {
+            t_uiConsumer = uiConsumer;
+            Jitter oJitter(p_oConfig.m_uiSeed * 7919 + 1000 + uiConsumer);
+            while (oSelector.SelectAndExecute())
+            {
+                oJitter();
+            } });
+    }
+
+    std::vector<std::thread> vecProducers;
+    for (unsigned int uiProducer = 0; uiProducer < p_oConfig.m_uiProducersCount; ++uiProducer)
+    {
+        vecProducers.emplace_back([&, uiProducer]()
+                                  {
+            Jitter oJitter(p_oConfig.m_uiSeed * 7919 + uiProducer);
+            auto &pChannel = vecChannels[uiProducer % vecChannels.size()];
+            for (unsigned long long ullSequence = 0; ullSequence < p_oConfig.m_ullMessagesPerProducer; ++ullSequence)
+            {
+                pChannel->SendValue(StressMessage{uiProducer, ullSequence});
+                oJitter();
+            } });
+    }
+
+    for (auto &oProducer : vecProducers)
+    {
+        oProducer.join();
+    }
+    while (ullConsumed.load() < ullTotal)
+    {
+        std::this_thread::yield();
+    }
+    oSelector.Close();
+    for (auto &oConsumer : vecConsumers)
+    {
+        oConsumer.join();
+    }
+    g_oWatchdog.Disarm();
+    return oHistory.Verify(p_strName, false);
+}
+
+//! One channel is also read directly (its selector count goes stale) while data keeps coming on another one
+//! the I/O loop only wakes on the readiness fd , a Drain stopping on the stale channel would leave the other one unread forever
+bool StressSelectorStaleCount(const std::string &p_strName, const StressConfig &p_oConfig)
+{
+    g_oWatchdog.Arm(p_strName);
+    //! Consumer 0 : the selector (I/O loop) , consumer 1 : the thread reading the first channel directly
+    History oHistory(2, p_oConfig.m_ullMessagesPerProducer, 2);
+    const unsigned long long ullTotal = 2 * p_oConfig.m_ullMessagesPerProducer;
+    std::atomic<unsigned long long> ullConsumed{0};
+
+    auto pStolenChannel = std::make_shared<BufferedChannel<StressMessage>>(4);
+    auto pOtherChannel = std::make_shared<BufferedChannel<StressMessage>>(4);
+    ChannelSelector oSelector;
+    //! Added first , so the selector always looks at it first
+    for (auto &pChannel : {pStolenChannel, pOtherChannel})
+    {
+        oSelector.AddChannel<StressMessage>(pChannel, [&](StressMessage &p_oMessage)
+                                            {
+            oHistory.Record(0, p_oMessage);
+            ullConsumed++; });
+    }
+    int iReadinessFd = oSelector.GetReadinessFd();
+
+    //! Deterministic case first : stale count on the first channel , one value pending on the second
+    bool bIsOk = true;
+    StressMessage oMessage;
+    pStolenChannel->SendValue(StressMessage{0, 0});
+    pStolenChannel->TryReadValue(oMessage);
+    oHistory.Record(1, oMessage);
+    pOtherChannel->SendValue(StressMessage{1, 0});
+    if (oSelector.Drain() != 1)
+    {
+        std::cerr << "[FAIL] " << p_strName << ": Drain stopped on the stale channel\n";
+        bIsOk = false;
+    }
+    ullConsumed += 1;
+
+    std::thread oIOLoop([&]()
+                        {
+        pollfd oPollFd{iReadinessFd, POLLIN, 0};
+        while (!oSelector.IsClosed())
+        {
+            //! No timeout , a lost wakeup hangs here and the watchdog reports it
+            poll(&oPollFd, 1, -1);
+            oSelector.Drain(8);
+        } });
+    std::thread oStealer([&]()
+                         {
+        Jitter oJitter(p_oConfig.m_uiSeed * 7919 + 1000);
+        while (ullConsumed.load() < ullTotal)
+        {
+            StressMessage oStolen;
+            if (pStolenChannel->TryReadValue(oStolen))
+            {
+                oHistory.Record(1, oStolen);
+                ullConsumed++;
+            }
+            oJitter();
+        } });
+    std::vector<std::thread> vecProducers;
+    for (unsigned int uiProducer = 0; uiProducer < 2; ++uiProducer)
+    {
+        vecProducers.emplace_back([&, uiProducer]()
+                                  {
+            Jitter oJitter(p_oConfig.m_uiSeed * 7919 + uiProducer);
+            auto &pChannel = uiProducer == 0 ? pStolenChannel : pOtherChannel;
+            for (unsigned long long ullSequence = 1; ullSequence < p_oConfig.m_ullMessagesPerProducer; ++ullSequence)
+            {
+                pChannel->SendValue(StressMessage{uiProducer, ullSequence});
+                oJitter();
+            } });
+    }
+
+    for (auto &oProducer : vecProducers)
+    {
+        oProducer.join();
+    }
+    oStealer.join();
+    oSelector.Close();
+    oIOLoop.join();
+    g_oWatchdog.Disarm();
+    return oHistory.Verify(p_strName, false) && bIsOk;
+}
+
+//! Source -> Map (4 tasks , jittered so they finish out of order) -> Filter -> sink , stages run as pool tasks
+//! an ordered Map has to keep every producer's FIFO , an unordered one only must not lose / duplicate anything
+bool StressDataflowMap(const std::string &p_strName, const StressConfig &p_oConfig, bool p_bPreserveOrder)
+{
+    g_oWatchdog.Arm(p_strName);
+    History oHistory(p_oConfig.m_uiProducersCount, p_oConfig.m_ullMessagesPerProducer, 1);
+    const unsigned long long ullTotal = p_oConfig.m_uiProducersCount * p_oConfig.m_ullMessagesPerProducer;
+    {
+        //! One worker per stage , Map counts for its parallelism (see Dataflow.h)
+        BasicThreadPool oPool(6);
+        auto pSource = std::make_shared<BufferedChannel<StressMessage>>(8);
+        auto pMapped = std::make_shared<BufferedChannel<StressMessage>>(8);
+        auto pSink = std::make_shared<BufferedChannel<StressMessage>>(8);
+        MapOptions oOptions;
+        oOptions.m_sParallelism = 4;
+        oOptions.m_bPreserveOrder = p_bPreserveOrder;
+        unsigned int uiSeed = p_oConfig.m_uiSeed;
+        auto pMap = Map<StressMessage, StressMessage>(oPool, pSource, pMapped, [uiSeed](StressMessage p_oMessage)
+                                                      {
+            thread_local Jitter t_oJitter(uiSeed * 7919 + static_cast<unsigned int>(std::hash<std::thread::id>()(std::this_thread::get_id())));
+            t_oJitter();
+            return p_oMessage; },
+                                                      oOptions);
+        auto pFilter = Filter<StressMessage>(oPool, pMapped, pSink, [](const StressMessage &)
+                                             { return true; });
+
+        std::vector<std::thread> vecProducers;
+        for (unsigned int uiProducer = 0; uiProducer < p_oConfig.m_uiProducersCount; ++uiProducer)
+        {
+            vecProducers.emplace_back([&, uiProducer]()
+                                      {
+                Jitter oJitter(p_oConfig.m_uiSeed * 7919 + uiProducer);
+                for (unsigned long long ullSequence = 0; ullSequence < p_oConfig.m_ullMessagesPerProducer; ++ullSequence)
+                {
+                    pSource->SendValue(StressMessage{uiProducer, ullSequence});
+                    oJitter();
+                } });
+        }
+        std::vector<StressMessage> vecReceived;
+        StressMessage oMessage;
+        while (vecReceived.size() < ullTotal && pSink->ReadValue(oMessage))
+        {
+            vecReceived.push_back(oMessage);
+        }
+        for (auto &oProducer : vecProducers)
+        {
+            oProducer.join();
+        }
+        //! Everything was read , closing the source closes the whole chain
+        pSource->Close();
+        pMap->WaitUntilFinished();
+        pFilter->WaitUntilFinished();
+        //! A still open sink would block here , the watchdog reports it
+        if (pSink->ReadValue(oMessage))
+        {
+            std::cerr << "[FAIL] " << p_strName << ": sink handed out a value once every stage finished\n";
+            return false;
+        }
+        if (!p_bPreserveOrder)
+        {
+            //! Only loss / duplication is checked
+            std::sort(vecReceived.begin(), vecReceived.end(), [](const StressMessage &p_oLeft, const StressMessage &p_oRight)
+                      { return p_oLeft.m_uiProducer != p_oRight.m_uiProducer ? p_oLeft.m_uiProducer < p_oRight.m_uiProducer : p_oLeft.m_ullSequence < p_oRight.m_ullSequence; });
+        }
+        for (const StressMessage &oReceived : vecReceived)
+        {
+            oHistory.Record(0, oReceived);
+        }
+    }
+    g_oWatchdog.Disarm();
+    return oHistory.Verify(p_strName, false);
+}
+
+//! Ordered Map(4) with one slow value : values after it may only be dispatched within the parallelism window
+//! (the reorder buffer stays bounded , backpressure still reaches the producer) , order still has to hold
+bool StressDataflowSlowHeadOfLine(const std::string &p_strName, const StressConfig &p_oConfig)
+{
+    g_oWatchdog.Arm(p_strName);
+    constexpr std::size_t sParallelism = 4;
+    constexpr unsigned long long ullSlowSequence = 100;
+    History oHistory(1, p_oConfig.m_ullMessagesPerProducer, 1);
+    std::atomic<unsigned long long> ullStarted{0};
+    unsigned long long ullStartedPastSlow = 0;
+    {
+        BasicThreadPool oPool(6);
+        auto pSource = std::make_shared<BufferedChannel<StressMessage>>(8);
+        auto pMapped = std::make_shared<BufferedChannel<StressMessage>>(8);
+        MapOptions oOptions;
+        oOptions.m_sParallelism = sParallelism;
+        auto pMap = Map<StressMessage, StressMessage>(oPool, pSource, pMapped, [&](StressMessage p_oMessage)
+                                                      {
+            ullStarted++;
+            if (p_oMessage.m_ullSequence == ullSlowSequence)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                //! Read before this value leaves , everything started after it is still waiting behind it
+                ullStartedPastSlow = ullStarted.load() - (ullSlowSequence + 1);
+            }
+            return p_oMessage; },
+                                                      oOptions);
+
+        std::thread oProducer([&]()
+                              {
+            for (unsigned long long ullSequence = 0; ullSequence < p_oConfig.m_ullMessagesPerProducer; ++ullSequence)
+            {
+                pSource->SendValue(StressMessage{0, ullSequence});
+            } });
+        StressMessage oMessage;
+        for (unsigned long long ullRead = 0; ullRead < p_oConfig.m_ullMessagesPerProducer && pMapped->ReadValue(oMessage); ++ullRead)
+        {
+            oHistory.Record(0, oMessage);
+        }
+        oProducer.join();
+        pSource->Close();
+        pMap->WaitUntilFinished();
+    }
+    g_oWatchdog.Disarm();
+    if (ullStartedPastSlow > sParallelism - 1)
+    {
+        std::cerr << "[FAIL] " << p_strName << ": " << ullStartedPastSlow << " values dispatched behind the slow one , at most "
+                  << sParallelism - 1 << " expected\n";
+        return false;
+    }
+    return oHistory.Verify(p_strName, false);
+}
+
+//! Closes the source (or a channel in the middle of the chain , then the source) while values are still in flight
+//! values buffered in a closed channel are dropped , but every stage still has to finish and close its output
+//! and what reaches the sink has to be , per producer , a prefix of what it sent (no hole , no reordering , no duplicate)
+bool StressDataflowClose(const std::string &p_strName, const StressConfig &p_oConfig, bool p_bCloseMidChain)
+{
+    g_oWatchdog.Arm(p_strName);
+    std::vector<std::vector<unsigned long long>> vecReceived(p_oConfig.m_uiProducersCount);
+    {
+        BasicThreadPool oPool(6);
+        auto pSource = std::make_shared<BufferedChannel<StressMessage>>(8);
+        auto pMapped = std::make_shared<BufferedChannel<StressMessage>>(4);
+        auto pSink = std::make_shared<BufferedChannel<StressMessage>>(4);
+        MapOptions oOptions;
+        oOptions.m_sParallelism = 4;
+        unsigned int uiSeed = p_oConfig.m_uiSeed;
+        auto pMap = Map<StressMessage, StressMessage>(oPool, pSource, pMapped, [uiSeed](StressMessage p_oMessage)
+                                                      {
+            thread_local Jitter t_oJitter(uiSeed * 7919 + static_cast<unsigned int>(std::hash<std::thread::id>()(std::this_thread::get_id())));
+            t_oJitter();
+            return p_oMessage; },
+                                                      oOptions);
+        auto pFilter = Filter<StressMessage>(oPool, pMapped, pSink, [](const StressMessage &)
+                                             { return true; });
+
+        std::vector<std::thread> vecProducers;
+        for (unsigned int uiProducer = 0; uiProducer < p_oConfig.m_uiProducersCount; ++uiProducer)
+        {
+            vecProducers.emplace_back([&, uiProducer]()
+                                      {
+                Jitter oJitter(p_oConfig.m_uiSeed * 7919 + uiProducer);
+                //! Stops at the first failed Send (source closed)
+                for (unsigned long long ullSequence = 0; pSource->SendValue(StressMessage{uiProducer, ullSequence}); ++ullSequence)
+                {
+                    oJitter();
+                } });
+        }
+        std::thread oConsumer([&]()
+                              {
+            StressMessage oMessage;
+            while (pSink->ReadValue(oMessage))
+            {
+                vecReceived[oMessage.m_uiProducer].push_back(oMessage.m_ullSequence);
+            } });
+
+        //! Let values spread over the chain , then close in the middle of the traffic
+        std::mt19937 oRng(p_oConfig.m_uiSeed);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5 + oRng() % 20));
+        if (p_bCloseMidChain)
+        {
+            pMapped->Close();
+            std::this_thread::sleep_for(std::chrono::milliseconds(oRng() % 5));
+        }
+        pSource->Close();
+        for (auto &oProducer : vecProducers)
+        {
+            oProducer.join();
+        }
+        pMap->WaitUntilFinished();
+        pFilter->WaitUntilFinished();
+        //! The consumer only stops once the Filter closed the sink
+        oConsumer.join();
+    }
+    g_oWatchdog.Disarm();
+
+    unsigned long long ullReceived = 0;
+    for (unsigned int uiProducer = 0; uiProducer < p_oConfig.m_uiProducersCount; ++uiProducer)
+    {
+        for (unsigned long long ullIndex = 0; ullIndex < vecReceived[uiProducer].size(); ++ullIndex)
+        {
+            if (vecReceived[uiProducer][ullIndex] != ullIndex)
+            {
+                std::cerr << "[FAIL] " << p_strName << ": producer " << uiProducer << " message " << vecReceived[uiProducer][ullIndex]
+                          << " received at position " << ullIndex << "\n";
+                return false;
+            }
+        }
+        ullReceived += vecReceived[uiProducer].size();
+    }
+    std::cerr << "[ OK ] " << p_strName << ": " << ullReceived << " values through before the close\n";
+    return true;
+}
+
+//! Tasks submitted from several threads , every result has to come back exactly once
+bool StressThreadPool(const std::string &p_strName, const StressConfig &p_oConfig)
+{
+    g_oWatchdog.Arm(p_strName);
+    History oHistory(p_oConfig.m_uiProducersCount, p_oConfig.m_ullMessagesPerProducer, p_oConfig.m_uiProducersCount);
+    {
+        BasicThreadPool oPool(4);
+        std::vector<std::thread> vecSubmitters;
+        for (unsigned int uiSubmitter = 0; uiSubmitter < p_oConfig.m_uiProducersCount; ++uiSubmitter)
+        {
+            vecSubmitters.emplace_back([&, uiSubmitter]()
+                                       {
+                Jitter oJitter(p_oConfig.m_uiSeed * 7919 + uiSubmitter);
+                std::vector<BasicThreadPool::ResultChannel<StressMessage>> vecResults;
+                for (unsigned long long ullSequence = 0; ullSequence < p_oConfig.m_ullMessagesPerProducer; ++ullSequence)
+                {
+                    vecResults.push_back(oPool.SubmitTask<StressMessage>([uiSubmitter, ullSequence]()
+                                                                         { return StressMessage{uiSubmitter, ullSequence}; }));
+                    oJitter();
+                }
+                for (auto &pResult : vecResults)
+                {
+                    StressMessage oMessage;
+                    pResult->ReadValue(oMessage);
+                    oHistory.Record(uiSubmitter, oMessage);
+                } });
+        }
+        for (auto &oSubmitter : vecSubmitters)
+        {
+            oSubmitter.join();
+        }
+    }
+    g_oWatchdog.Disarm();
+    return oHistory.Verify(p_strName, false);
+}
+
+//! Two submitters per key , each key's tasks record in its own history (no lock) , per submitter order has to hold
+bool StressKeyedExecutor(const std::string &p_strName, const StressConfig &p_oConfig)
+{
+    g_oWatchdog.Arm(p_strName);
+    constexpr unsigned int uiKeysCount = 2;
+    History oHistory(p_oConfig.m_uiProducersCount, p_oConfig.m_ullMessagesPerProducer, uiKeysCount);
+    {
+        BasicThreadPool oPool(4);
+        //! Declared after the pool , waits for its strands to drain before the pool goes away
+        KeyedExecutor oExecutor(oPool, uiKeysCount);
+        std::vector<std::thread> vecSubmitters;
+        for (unsigned int uiSubmitter = 0; uiSubmitter < p_oConfig.m_uiProducersCount; ++uiSubmitter)
+        {
+            vecSubmitters.emplace_back([&, uiSubmitter]()
+                                       {
+                Jitter oJitter(p_oConfig.m_uiSeed * 7919 + uiSubmitter);
+                unsigned int uiKey = uiSubmitter % uiKeysCount;
+                for (unsigned long long ullSequence = 0; ullSequence < p_oConfig.m_ullMessagesPerProducer; ++ullSequence)
+                {
+                    oExecutor.Post(uiKey, [&oHistory, uiKey, uiSubmitter, ullSequence]()
+                                   { oHistory.Record(uiKey, StressMessage{uiSubmitter, ullSequence}); });
+                    oJitter();
+                } });
+        }
+        for (auto &oSubmitter : vecSubmitters)
+        {
+            oSubmitter.join();
+        }
+    }
+    g_oWatchdog.Disarm();
+    return oHistory.Verify(p_strName, false);
+}
+
+//! Layered DAG , every task checks its predecessors already ran in this run , the same graph is run again and again
+bool StressTaskGraph(const std::string &p_strName, const StressConfig &p_oConfig)
+{
+    g_oWatchdog.Arm(p_strName);
+    constexpr unsigned int uiLayersCount = 8;
+    constexpr unsigned int uiWidth = 6;
+    constexpr unsigned int uiRunsCount = 200;
+    std::vector<unsigned int> vecRuns(uiLayersCount * uiWidth, 0);
+    std::atomic<unsigned long long> ullViolations{0};
+    unsigned int uiRun = 0;
+    {
+        BasicThreadPool oPool(4);
+        TaskGraph oGraph;
+        std::mt19937 oRng(p_oConfig.m_uiSeed);
+        std::vector<TaskGraph::TaskHandle> vecTasks;
+        for (unsigned int uiTask = 0; uiTask < uiLayersCount * uiWidth; ++uiTask)
+        {
+            //! Predecessors are picked at random in the previous layer
+            std::vector<unsigned int> vecPredecessors;
+            if (uiTask >= uiWidth)
+            {
+                unsigned int uiLayerStart = (uiTask / uiWidth - 1) * uiWidth;
+                for (unsigned int uiCandidate = uiLayerStart; uiCandidate < uiLayerStart + uiWidth; ++uiCandidate)
+                {
+                    if (oRng() % 3 == 0)
+                    {
+                        vecPredecessors.push_back(uiCandidate);
+                    }
+                }
+            }
+            vecTasks.push_back(oGraph.Emplace([&, uiTask, vecPredecessors]()
+                                              {
+                for (unsigned int uiPredecessor : vecPredecessors)
+                {
+                    if (vecRuns[uiPredecessor] != uiRun)
+                    {
+                        ullViolations++;
+                    }
+                }
+                vecRuns[uiTask] = uiRun; }));
+            for (unsigned int uiPredecessor : vecPredecessors)
+            {
+                vecTasks.back().Succeed(vecTasks[uiPredecessor]);
+            }
+        }
+        for (uiRun = 1; uiRun <= uiRunsCount; ++uiRun)
+        {
+            oGraph.Run(oPool);
+            oGraph.Wait();
+        }
+    }
+    g_oWatchdog.Disarm();
+    unsigned long long ullNotRun = 0;
+    for (unsigned int uiTaskRun : vecRuns)
+    {
+        ullNotRun += (uiTaskRun != uiRunsCount);
+    }
+    if (ullViolations.load() != 0 || ullNotRun != 0)
+    {
+        std::cerr << "[FAIL] " << p_strName << ": " << ullViolations.load() << " tasks ran before a predecessor, " << ullNotRun << " tasks missed the last run\n";
+        return false;
+    }
+    std::cerr << "[ OK ] " << p_strName << ": " << uiRunsCount << " runs\n";
+    return true;
+}
+
+//! Start / Pause / Stop racing from several threads while the event loop runs
+bool StressActor(const std::string &p_strName, const StressConfig &p_oConfig)
+{
+    g_oWatchdog.Arm(p_strName);
+    std::atomic<unsigned long long> ullActivations{0};
+    {
+        Actor oActor([&ullActivations]()
+                     {
+            ullActivations++;
+            std::this_thread::yield(); });
+        std::vector<std::thread> vecControllers;
+        for (unsigned int uiController = 0; uiController < 3; ++uiController)
+        {
+            vecControllers.emplace_back([&, uiController]()
+                                        {
+                std::mt19937 oRng(p_oConfig.m_uiSeed * 7919 + uiController);
+                for (int i = 0; i < 200; ++i)
+                {
+                    if (oRng() % 2)
+                    {
+                        oActor.Start();
+                    }
+                    else
+                    {
+                        oActor.Pause();
+                    }
+                    std::this_thread::yield();
+                }
+                if (uiController == 0)
+                {
+                    oActor.Stop();
+                } });
+        }
+        for (auto &oController : vecControllers)
+        {
+            oController.join();
+        }
+    }
+    g_oWatchdog.Disarm();
+    std::cerr << "[ OK ] " << p_strName << ": " << ullActivations.load() << " activations\n";
+    return true;
+}
+
+struct SinglePriority
+{
+    bool operator()(const StressMessage &, const StressMessage &) const
+    {
+        return false;
+    }
+};
+
+bool RunStress(unsigned int p_uiSeed)
+{
+    StressConfig oConfig{4, 3, 2000, p_uiSeed};
+    bool bResult = true;
+    bResult &= StressQueue("BufferedChannel(1)", std::make_shared<BufferedChannel<StressMessage>>(1), oConfig);
+    bResult &= StressQueue("BufferedChannel(64)", std::make_shared<BufferedChannel<StressMessage>>(64), oConfig);
+    bResult &= StressQueue("UnBufferedChannel", std::make_shared<UnBufferedChannel<StressMessage>>(), oConfig);
+    bResult &= StressQueue("PooledBufferedChannel(8)", ChannelFactory::MakeBufferedChannel<StressMessage>(8), oConfig);
+    bResult &= StressQueue("PooledUnBufferedChannel", ChannelFactory::MakeUnBufferedChannel<StressMessage>(), oConfig);
+    bResult &= StressQueue("ShardedChannel(8, 4 shards)", std::make_shared<ShardedChannel<StressMessage>>(8, 4), oConfig);
+    //! Tiny segments , so segments get linked / recycled all the time
+    bResult &= StressQueue("UnboundedChannel(segments of 4)", std::make_shared<UnboundedChannel<StressMessage, 4>>(64, nullptr, 2), oConfig);
+    //! Every message has the same priority , the heap has to keep them in FIFO order
+    bResult &= StressQueue("PriorityChannel(8, single priority)", std::make_shared<PriorityChannel<StressMessage, SinglePriority>>(8), oConfig);
+    //! Compile time configured ring , called directly (no virtual) then through the IChannel adapter , small so it wraps a lot
+    bResult &= StressQueue("Channel<8, Multi, Multi>", std::make_shared<Channel<StressMessage, 8>>(), oConfig);
+    bResult &= StressQueue("ChannelAdapter<Channel<8, Multi, Multi, Yield>>", std::make_shared<ChannelAdapter<Channel<StressMessage, 8, Arity::Multi, Arity::Multi, YieldWaitPolicy>>>(), oConfig);
+    bResult &= StressQueue("SpscChannel<4>", std::make_shared<SpscChannel<StressMessage, 4>>(), StressConfig{1, 1, oConfig.m_ullMessagesPerProducer * 4, p_uiSeed});
+    bResult &= StressQueue("CompactChannel", std::make_shared<CompactChannel<StressMessage>>(), oConfig);
+    bResult &= StressBroadcast("BroadcastChannel(Block)", LagPolicy::Block, oConfig);
+    bResult &= StressSelector("ChannelSelector", oConfig);
+    bResult &= StressSelectorStaleCount("ChannelSelector(stale count, readiness fd)", oConfig);
+    bResult &= StressThreadPool("BasicThreadPool", oConfig);
+    bResult &= StressKeyedExecutor("KeyedExecutor(2 strands)", oConfig);
+    bResult &= StressTaskGraph("TaskGraph(8 layers x 6)", oConfig);
+    bResult &= StressDataflowMap("Dataflow Map(4 ordered) -> Filter", oConfig, true);
+    bResult &= StressDataflowMap("Dataflow Map(4 unordered) -> Filter", oConfig, false);
+    bResult &= StressDataflowSlowHeadOfLine("Dataflow Map(4 ordered) slow head of line", oConfig);
+    bResult &= StressDataflowClose("Dataflow close source in flight", oConfig, false);
+    bResult &= StressDataflowClose("Dataflow close mid chain in flight", oConfig, true);
+    bResult &= StressActor("Actor", oConfig);
+    return bResult;
+}
+
+bool RunExploration(unsigned int p_uiSeed)
+{
+    using Op = ExplorationOperation;
+    auto fMakeBuffered = []()
+    { return std::make_shared<BufferedChannel<StressMessage>>(2); };
+    auto fMakeUnBuffered = []()
+    { return std::make_shared<UnBufferedChannel<StressMessage>>(); };
+    auto fMakePooledBuffered = []()
+    { return ChannelFactory::MakeBufferedChannel<StressMessage>(2); };
+
+    //! Small programs , every interleaving
+    std::vector<ScheduleExplorer::Program> vecSmallPrograms{
+        {Op::Send, Op::Send},
+        {Op::Send, Op::Send},
+        {Op::TryRead, Op::TryRead, Op::TryRead},
+        {Op::TryRead},
+        {Op::Close}};
+    //! Bigger programs , seeded random schedules
+    std::vector<ScheduleExplorer::Program> vecBigPrograms{
+        {Op::Send, Op::Send, Op::Send, Op::Send, Op::Send},
+        {Op::Send, Op::Send, Op::Send, Op::Send, Op::Send},
+        {Op::Send, Op::Send, Op::Send, Op::Send, Op::Send},
+        {Op::TryRead, Op::TryRead, Op::TryRead, Op::TryRead, Op::TryRead, Op::TryRead, Op::TryRead, Op::TryRead},
+        {Op::TryRead, Op::TryRead, Op::TryRead, Op::TryRead, Op::TryRead, Op::TryRead, Op::TryRead, Op::TryRead},
+        {Op::Close}};
+
+    bool bResult = true;
+    bResult &= ScheduleExplorer("BufferedChannel(2)", fMakeBuffered, 2, vecSmallPrograms).ExploreAll();
+    bResult &= ScheduleExplorer("UnBufferedChannel", fMakeUnBuffered, 1, vecSmallPrograms).ExploreAll();
+    bResult &= ScheduleExplorer("PooledBufferedChannel(2)", fMakePooledBuffered, 2, vecSmallPrograms).ExploreAll();
+    bResult &= ScheduleExplorer("BufferedChannel(2)", fMakeBuffered, 2, vecBigPrograms).ExploreRandom(p_uiSeed, 20000);
+    bResult &= ScheduleExplorer("UnBufferedChannel", fMakeUnBuffered, 1, vecBigPrograms).ExploreRandom(p_uiSeed, 20000);
+    return bResult;
+}
+
+int main(int argc, char **argv)
+{
+    std::string strMode = argc > 1 ? argv[1] : "all";
+    //! Print the seed, a failing run is reproduced by passing it back
+    unsigned int uiSeed = argc > 2 ? std::stoul(argv[2]) : std::random_device{}();
+    std::cerr << "mode " << strMode << ", seed " << uiSeed << "\n";
+
+    bool bResult = true;
+    if (strMode == "all" || strMode == "stress")
+    {
+        bResult &= RunStress(uiSeed);
+    }
+    if (strMode == "all" || strMode == "explore")
+    {
+        bResult &= RunExploration(uiSeed);
+    }
+    return bResult ? 0 : 1;
+}
\ No newline at end of file
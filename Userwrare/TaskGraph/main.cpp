@@ -0,0 +1,76 @@
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "TaskGraph.h"
+
+//! Batch job as a DAG : generate -> sum every chunk (in parallel) -> reduce -> check , no worker waits on another one
+constexpr std::size_t CHUNKS_COUNT = 8;
+constexpr std::size_t CHUNK_SIZE = 100000;
+
+bool ReduceScenario(BasicThreadPool &p_oPool)
+{
+    //! Tasks share the data living next to the graph , edges order the accesses
+    long long llSeed = 0;
+    std::vector<long long> vecValues(CHUNKS_COUNT * CHUNK_SIZE);
+    std::vector<long long> vecChunkSums(CHUNKS_COUNT);
+    long long llTotal = 0;
+
+    TaskGraph oGraph;
+    TaskGraph::TaskHandle oGenerate = oGraph.Emplace([&]()
+                                                     { std::iota(vecValues.begin(), vecValues.end(), llSeed); });
+    TaskGraph::TaskHandle oReduce = oGraph.Emplace([&]()
+                                                   { llTotal = std::accumulate(vecChunkSums.begin(), vecChunkSums.end(), 0LL); });
+    for (std::size_t sChunk = 0; sChunk < CHUNKS_COUNT; ++sChunk)
+    {
+        oGraph.Emplace([&, sChunk]()
+                       { vecChunkSums[sChunk] = std::accumulate(vecValues.begin() + sChunk * CHUNK_SIZE, vecValues.begin() + (sChunk + 1) * CHUNK_SIZE, 0LL); })
+            .Succeed(oGenerate)
+            .Precede(oReduce);
+    }
+
+    //! Same graph every run , only the counters are reset
+    bool bIsOk = true;
+    for (llSeed = 0; llSeed < 3; ++llSeed)
+    {
+        oGraph.Run(p_oPool);
+        oGraph.Wait();
+        long long llCount = static_cast<long long>(vecValues.size());
+        long long llExpected = llCount * llSeed + llCount * (llCount - 1) / 2;
+        std::cout << "ReduceScenario run " << llSeed << " total " << llTotal << std::endl;
+        bIsOk = bIsOk && llTotal == llExpected;
+    }
+    std::cout << "ReduceScenario " << oGraph.GetTasksCount() << " tasks " << (bIsOk ? "OK" : "FAILED") << std::endl;
+    return bIsOk;
+}
+
+bool CycleScenario(BasicThreadPool &p_oPool)
+{
+    TaskGraph oGraph;
+    TaskGraph::TaskHandle oFirst = oGraph.Emplace([]() {});
+    TaskGraph::TaskHandle oSecond = oGraph.Emplace([]() {});
+    oFirst.Precede(oSecond);
+    oSecond.Precede(oFirst);
+    bool bIsOk = false;
+    try
+    {
+        oGraph.Run(p_oPool);
+    }
+    catch (const std::logic_error &oError)
+    {
+        std::cout << "CycleScenario rejected: " << oError.what() << std::endl;
+        bIsOk = true;
+    }
+    std::cout << "CycleScenario " << (bIsOk ? "OK" : "FAILED") << std::endl;
+    return bIsOk;
+}
+
+int main()
+{
+    BasicThreadPool oPool(4);
+    bool bIsOk = ReduceScenario(oPool);
+    bIsOk = CycleScenario(oPool) && bIsOk;
+    std::cout << (bIsOk ? "OK" : "FAILED") << std::endl;
+    return bIsOk ? 0 : 1;
+}
\ No newline at end of file
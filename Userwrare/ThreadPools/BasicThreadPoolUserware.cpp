@@ -2,7 +2,6 @@
 #include <memory>
 
 #include "BasicThreadPool.h"
-#include "UnBufferedChannel.h"
 
 int main()
 {
@@ -12,7 +11,7 @@ int main()
         std::this_thread::sleep_for(std::chrono::milliseconds(3000));
         return 10;
     };
-    std::shared_ptr<UnBufferedChannel<int>> channelResult = oPool.SubmitTask<int>(std::move(fTask));
+    BasicThreadPool::ResultChannel<int> channelResult = oPool.SubmitTask<int>(std::move(fTask));
 
     std::cerr << "Waitiing for result to be executed by a Worker Thread\n";
     int val;